@@ -0,0 +1,121 @@
+/**
+ * @file bench.h
+ * @brief Minimal helpers shared by the gocxx benchmark executables
+ *
+ * The benchmarks are plain executables with no framework dependency. Each one
+ * prints a small table to stdout; build them in Release mode with
+ * -DGOCXX_ENABLE_BENCHMARKS=ON.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <string>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/resource.h>
+#endif
+
+namespace gocxx::bench {
+
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * @brief Wall-clock stopwatch started on construction
+     */
+    class Stopwatch {
+    public:
+        Stopwatch() : start_(Clock::now()) {}
+
+        void Reset() { start_ = Clock::now(); }
+
+        double Seconds() const {
+            return std::chrono::duration<double>(Clock::now() - start_).count();
+        }
+
+        int64_t Nanoseconds() const {
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start_).count();
+        }
+
+    private:
+        Clock::time_point start_;
+    };
+
+    /**
+     * @brief Scale factor for iteration counts, read from GOCXX_BENCH_SCALE
+     *
+     * Lets CI run every benchmark quickly (e.g. GOCXX_BENCH_SCALE=0.01) while
+     * local runs use the full sizes.
+     */
+    inline double Scale() {
+        const char* env = std::getenv("GOCXX_BENCH_SCALE");
+        if (!env) return 1.0;
+        double s = std::atof(env);
+        return s > 0 ? s : 1.0;
+    }
+
+    /**
+     * @brief Apply Scale() to an iteration count, never returning less than @p min
+     */
+    inline std::size_t Scaled(std::size_t n, std::size_t min = 1) {
+        auto scaled = static_cast<std::size_t>(static_cast<double>(n) * Scale());
+        return std::max(scaled, min);
+    }
+
+    /**
+     * @brief Value at percentile @p p (0-100) of @p samples; sorts in place
+     */
+    inline int64_t Percentile(std::vector<int64_t>& samples, double p) {
+        if (samples.empty()) return 0;
+        std::sort(samples.begin(), samples.end());
+        auto idx = static_cast<std::size_t>(p / 100.0 * static_cast<double>(samples.size() - 1));
+        return samples[idx];
+    }
+
+    /**
+     * @brief Peak resident set size of this process in KiB (0 if unknown)
+     */
+    inline long PeakRssKb() {
+#if defined(__unix__) || defined(__APPLE__)
+        struct rusage usage {};
+        getrusage(RUSAGE_SELF, &usage);
+#if defined(__APPLE__)
+        return usage.ru_maxrss / 1024;
+#else
+        return usage.ru_maxrss;
+#endif
+#else
+        return 0;
+#endif
+    }
+
+    /**
+     * @brief CPU time (user + system) consumed by this process so far, in seconds
+     */
+    inline double CpuSeconds() {
+#if defined(__unix__) || defined(__APPLE__)
+        struct rusage usage {};
+        getrusage(RUSAGE_SELF, &usage);
+        auto seconds = [](const timeval& tv) {
+            return static_cast<double>(tv.tv_sec) + static_cast<double>(tv.tv_usec) / 1e6;
+        };
+        return seconds(usage.ru_utime) + seconds(usage.ru_stime);
+#else
+        return static_cast<double>(std::clock()) / CLOCKS_PER_SEC;
+#endif
+    }
+
+    /**
+     * @brief Print a benchmark section header
+     */
+    inline void Header(const std::string& title) {
+        std::printf("\n== %s ==\n", title.c_str());
+    }
+
+} // namespace gocxx::bench
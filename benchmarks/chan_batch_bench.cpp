@@ -0,0 +1,93 @@
+/**
+ * @file chan_batch_bench.cpp
+ * @brief Throughput of batched vs. single-value channel operations
+ *
+ * Four producers and four consumers move the same number of messages over a
+ * buffered channel using sendBatch/recvBatch with batch sizes 1, 16 and 256.
+ * Batch size 1 uses plain send/recv as the baseline.
+ */
+
+#include "bench.h"
+
+#include <gocxx/base/chan.h>
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace gocxx::base;
+using namespace gocxx::bench;
+
+namespace {
+
+    template<typename Impl>
+    double run(std::size_t threads, std::size_t batch, std::size_t capacity, std::size_t messages) {
+        Chan<int64_t> ch(std::make_shared<Impl>(capacity));
+        const std::size_t perProducer = messages / threads / batch * batch;
+        std::atomic<int64_t> checksum{0};
+
+        Stopwatch sw;
+        std::vector<std::thread> producers, consumers;
+        for (std::size_t p = 0; p < threads; ++p) {
+            producers.emplace_back([&] {
+                if (batch == 1) {
+                    for (std::size_t i = 0; i < perProducer; ++i) {
+                        ch.send(static_cast<int64_t>(i));
+                    }
+                    return;
+                }
+                std::vector<int64_t> buf(batch);
+                for (std::size_t i = 0; i < perProducer; i += batch) {
+                    for (std::size_t j = 0; j < batch; ++j) buf[j] = static_cast<int64_t>(i + j);
+                    ch.sendBatch(buf);
+                }
+            });
+        }
+        for (std::size_t c = 0; c < threads; ++c) {
+            consumers.emplace_back([&] {
+                int64_t sum = 0;
+                if (batch == 1) {
+                    while (auto v = ch.recv()) sum += *v;
+                } else {
+                    std::vector<int64_t> buf;
+                    buf.reserve(batch);
+                    while (ch.recvBatch(buf, batch) > 0) {
+                        for (int64_t v : buf) sum += v;
+                        buf.clear();
+                    }
+                }
+                checksum.fetch_add(sum, std::memory_order_relaxed);
+            });
+        }
+        for (auto& t : producers) t.join();
+        ch.close();
+        for (auto& t : consumers) t.join();
+        double secs = sw.Seconds();
+
+        const int64_t expected = static_cast<int64_t>(threads)
+            * static_cast<int64_t>(perProducer) * static_cast<int64_t>(perProducer - 1) / 2;
+        if (checksum.load() != expected) {
+            std::fprintf(stderr, "checksum mismatch: %lld != %lld\n",
+                         static_cast<long long>(checksum.load()), static_cast<long long>(expected));
+            std::exit(1);
+        }
+        return static_cast<double>(perProducer * threads) / secs;
+    }
+
+} // namespace
+
+int main() {
+    const std::size_t messages = Scaled(2'000'000, 4096);
+    const std::size_t capacity = 1024;
+    const std::size_t threads = 4;
+
+    Header("4 producers / 4 consumers, Chan<int64_t>, capacity 1024");
+    std::printf("%-8s %16s %16s\n", "batch", "ChanImpl msg/s", "Ring msg/s");
+    for (std::size_t batch : {1, 16, 256}) {
+        double locked = run<ChanImpl<int64_t>>(threads, batch, capacity, messages);
+        double ring = run<RingChanImpl<int64_t>>(threads, batch, capacity, messages);
+        std::printf("%-8zu %16.0f %16.0f\n", batch, locked, ring);
+    }
+    return 0;
+}
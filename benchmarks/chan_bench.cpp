@@ -0,0 +1,83 @@
+/**
+ * @file chan_bench.cpp
+ * @brief Buffered channel throughput: mutex-based ChanImpl vs. the lock-free engines
+ *
+ * Runs N producers and N consumers over one buffered channel and reports
+ * messages per second for each implementation. The single-pair section adds
+ * SpscChanImpl, which is only valid with one producer and one consumer.
+ */
+
+#include "bench.h"
+
+#include <gocxx/base/chan.h>
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace gocxx::base;
+using namespace gocxx::bench;
+
+namespace {
+
+    template<typename Impl>
+    double run(std::size_t threads, std::size_t capacity, std::size_t messages) {
+        Chan<int64_t> ch(std::make_shared<Impl>(capacity));
+        const std::size_t perProducer = messages / threads;
+        std::atomic<int64_t> checksum{0};
+
+        Stopwatch sw;
+        std::vector<std::thread> producers, consumers;
+        for (std::size_t p = 0; p < threads; ++p) {
+            producers.emplace_back([&] {
+                for (std::size_t i = 0; i < perProducer; ++i) {
+                    ch.send(static_cast<int64_t>(i));
+                }
+            });
+        }
+        for (std::size_t c = 0; c < threads; ++c) {
+            consumers.emplace_back([&] {
+                int64_t sum = 0;
+                while (auto v = ch.recv()) {
+                    sum += *v;
+                }
+                checksum.fetch_add(sum, std::memory_order_relaxed);
+            });
+        }
+        for (auto& t : producers) t.join();
+        ch.close();
+        for (auto& t : consumers) t.join();
+        double secs = sw.Seconds();
+
+        const int64_t expected = static_cast<int64_t>(threads)
+            * static_cast<int64_t>(perProducer) * static_cast<int64_t>(perProducer - 1) / 2;
+        if (checksum.load() != expected) {
+            std::fprintf(stderr, "checksum mismatch: %lld != %lld\n",
+                         static_cast<long long>(checksum.load()), static_cast<long long>(expected));
+            std::exit(1);
+        }
+        return static_cast<double>(perProducer * threads) / secs;
+    }
+
+} // namespace
+
+int main() {
+    const std::size_t messages = Scaled(2'000'000, 1024);
+    const std::size_t capacity = 1024;
+
+    Header("buffered Chan<int64_t>, capacity 1024");
+    std::printf("%-12s %16s %16s %8s\n", "producers", "ChanImpl msg/s", "Ring msg/s", "speedup");
+    for (std::size_t threads : {1, 4, 16}) {
+        double locked = run<ChanImpl<int64_t>>(threads, capacity, messages);
+        double ring = run<RingChanImpl<int64_t>>(threads, capacity, messages);
+        std::printf("%-12zu %16.0f %16.0f %7.2fx\n", threads, locked, ring, ring / locked);
+    }
+
+    Header("single producer/consumer pair, capacity 1024");
+    std::printf("%-12s %16s\n", "impl", "msg/s");
+    std::printf("%-12s %16.0f\n", "ChanImpl", run<ChanImpl<int64_t>>(1, capacity, messages));
+    std::printf("%-12s %16.0f\n", "Ring", run<RingChanImpl<int64_t>>(1, capacity, messages));
+    std::printf("%-12s %16.0f\n", "Spsc", run<SpscChanImpl<int64_t>>(1, capacity, messages));
+    return 0;
+}
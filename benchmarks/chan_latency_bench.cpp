@@ -0,0 +1,69 @@
+/**
+ * @file chan_latency_bench.cpp
+ * @brief Round-trip latency over unbuffered channels, park-only vs. spin-then-park
+ *
+ * A client sends a request on one unbuffered Chan<int> and waits for the
+ * reply on another; an echo thread answers each request. Reports p50/p99
+ * round-trip time for WaitPolicy::Block() (the previous behaviour) and the
+ * default adaptive policy, plus how the waits resolved.
+ */
+
+#include "bench.h"
+
+#include <gocxx/base/chan.h>
+
+#include <thread>
+#include <vector>
+
+using namespace gocxx::base;
+using namespace gocxx::bench;
+using gocxx::sync::WaitCounts;
+using gocxx::sync::WaitPolicy;
+
+namespace {
+
+    void run(const char* name, WaitPolicy policy, std::size_t rounds) {
+        ChanOptions opts;
+        opts.wait = policy;
+        Chan<int> request(0, opts);
+        Chan<int> reply(0, opts);
+
+        std::thread echo([&] {
+            while (auto v = request.recv()) {
+                reply.send(*v + 1);
+            }
+        });
+
+        std::vector<int64_t> samples;
+        samples.reserve(rounds);
+        for (std::size_t i = 0; i < rounds; ++i) {
+            Stopwatch sw;
+            request.send(static_cast<int>(i));
+            reply.recv();
+            samples.push_back(sw.Nanoseconds());
+        }
+        request.close();
+        echo.join();
+
+        WaitCounts counts = request.waitStats();
+        counts += reply.waitStats();
+        int64_t p50 = Percentile(samples, 50);
+        int64_t p99 = Percentile(samples, 99);
+        std::printf("%-10s %10lld %10lld %10llu %10llu %10llu\n", name,
+                    static_cast<long long>(p50), static_cast<long long>(p99),
+                    static_cast<unsigned long long>(counts.spun),
+                    static_cast<unsigned long long>(counts.yielded),
+                    static_cast<unsigned long long>(counts.parked));
+    }
+
+} // namespace
+
+int main() {
+    const std::size_t rounds = Scaled(100'000, 1000);
+
+    Header("unbuffered Chan<int> ping-pong round trip");
+    std::printf("%-10s %10s %10s %10s %10s %10s\n", "policy", "p50 ns", "p99 ns", "spun", "yielded", "parked");
+    run("block", WaitPolicy::Block(), rounds);
+    run("adaptive", WaitPolicy::Adaptive(), rounds);
+    return 0;
+}
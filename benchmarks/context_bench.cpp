@@ -0,0 +1,76 @@
+/**
+ * @file context_bench.cpp
+ * @brief Throughput of WithTimeout followed by cancel
+ *
+ * Each iteration creates a one-hour timeout context and cancels it, so the
+ * deadline never fires. Variants derive from Background, from a cancelable
+ * parent (child registration), and from a parent with an earlier deadline
+ * (no timer is created). The previous implementation started and joined a
+ * thread per TimerContext.
+ *
+ * A second section adds n live children to one parent and cancels it.
+ */
+
+#include "bench.h"
+
+#include <gocxx/context/context.h>
+#include <gocxx/time/timer_service.h>
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+using namespace gocxx::context;
+using namespace gocxx::time;
+using namespace gocxx::bench;
+
+namespace {
+
+    void run(const char* name, const ContextPtr& parent, std::size_t n) {
+        const Duration hour = Milliseconds(3'600'000);
+        double cpu = CpuSeconds();
+        Stopwatch sw;
+        for (std::size_t i = 0; i < n; ++i) {
+            auto result = WithTimeout(parent, hour);
+            result.value.second();
+        }
+        double seconds = sw.Seconds();
+        std::printf("%-22s %10.0f %12.0f %10.3f\n", name,
+                    seconds * 1e9 / static_cast<double>(n),
+                    static_cast<double>(n) / seconds,
+                    CpuSeconds() - cpu);
+    }
+
+} // namespace
+
+int main() {
+    const std::size_t n = Scaled(1'000'000, 1000);
+
+    Header("WithTimeout + cancel x " + std::to_string(n));
+    std::printf("%-22s %10s %12s %10s\n", "parent", "ns/op", "ops/s", "cpu s");
+
+    run("background", Background(), n);
+
+    auto cancelable = WithCancel(Background()).value;
+    run("cancelable", cancelable.first, n);
+    cancelable.second();
+
+    auto earlier = WithTimeout(Background(), Milliseconds(60'000)).value;
+    run("earlier deadline", earlier.first, n);
+    earlier.second();
+
+    std::printf("pending timers after run: %zu\n", TimerService::Global().Pending());
+
+    // Fan-out: n live children on one parent, then one cancel reaches them all
+    Header("Cancel parent with " + std::to_string(n) + " live children");
+    auto root = WithCancel(Background()).value;
+    std::vector<ContextPtr> children;
+    children.reserve(n);
+    Stopwatch sw;
+    for (std::size_t i = 0; i < n; ++i) children.push_back(WithCancel(root.first).value.first);
+    std::printf("%-22s %10.0f ns/child\n", "add", sw.Seconds() * 1e9 / static_cast<double>(n));
+    sw.Reset();
+    root.second();
+    std::printf("%-22s %10.0f ns/child\n", "cancel", sw.Seconds() * 1e9 / static_cast<double>(n));
+    return 0;
+}
@@ -0,0 +1,73 @@
+/**
+ * @file context_value_bench.cpp
+ * @brief ns per Value() lookup at chain depths 1, 8 and 32
+ *
+ * Each depth is a chain of WithValue layers over Background(). The key
+ * looked up is in the outermost layer's far end (the first one added), so a
+ * walk visits every layer. Compares legacy std::string keys, typed
+ * ContextKey<T> lookups that walk the chain, and lookups on a Flatten()ed
+ * context.
+ */
+
+#include "bench.h"
+
+#include <gocxx/context/context.h>
+
+#include <any>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace gocxx::context;
+using namespace gocxx::bench;
+
+namespace {
+
+    template<typename Fn>
+    double nsPerOp(std::size_t iterations, Fn&& fn) {
+        Stopwatch sw;
+        for (std::size_t i = 0; i < iterations; ++i) fn();
+        return sw.Seconds() * 1e9 / static_cast<double>(iterations);
+    }
+
+} // namespace
+
+int main() {
+    const std::size_t iterations = Scaled(2'000'000, 1000);
+    const int depths[] = {1, 8, 32};
+
+    std::vector<std::unique_ptr<ContextKey<std::string>>> keys;
+    for (int i = 0; i < 32; ++i) {
+        keys.push_back(std::make_unique<ContextKey<std::string>>("key" + std::to_string(i)));
+    }
+
+    Header("Context Value() x " + std::to_string(iterations));
+    std::printf("%-6s %12s %12s %12s\n", "depth", "legacy ns", "typed ns", "flat ns");
+
+    for (int depth : depths) {
+        ContextPtr legacy = Background();
+        ContextPtr typed = Background();
+        for (int i = 0; i < depth; ++i) {
+            std::string name = "key" + std::to_string(i);
+            legacy = WithValue(legacy, std::any(name), std::any(std::string("value"))).value;
+            typed = WithValue(typed, *keys[i], std::string("value")).value;
+        }
+        ContextPtr flat = Flatten(typed).value;
+
+        const std::any legacyKey = std::string("key0");
+        const ContextKey<std::string>& key = *keys[0];
+        std::size_t found = 0;
+
+        double legacyNs = nsPerOp(iterations, [&] { found += legacy->Value(legacyKey).Ok(); });
+        double typedNs = nsPerOp(iterations, [&] { found += key.Lookup(*typed) != nullptr; });
+        double flatNs = nsPerOp(iterations, [&] { found += key.Lookup(*flat) != nullptr; });
+
+        if (found != 3 * iterations) {
+            std::printf("lookup failed\n");
+            return 1;
+        }
+        std::printf("%-6d %12.1f %12.1f %12.1f\n", depth, legacyNs, typedNs, flatNs);
+    }
+    return 0;
+}
@@ -0,0 +1,108 @@
+/**
+ * @file coro_bench.cpp
+ * @brief Cost of co_await on channels next to blocking threads
+ *
+ * "ping-pong": a round trip over two unbuffered channels, between two
+ * coroutines on one Executor and between two OS threads for reference.
+ * "pipeline": values through a buffered channel, coroutine to coroutine.
+ * Needs a build with GOCXX_ENABLE_COROUTINES=ON.
+ */
+
+#include "bench.h"
+
+#include <gocxx/base/chan.h>
+#include <gocxx/runtime/executor.h>
+
+#include <cstdio>
+#include <thread>
+
+using namespace gocxx::bench;
+using gocxx::base::Chan;
+
+namespace {
+
+    void report(const char* name, std::size_t n, double seconds) {
+        std::printf("%-22s %10.1f\n", name, seconds * 1e9 / static_cast<double>(n));
+    }
+
+#if GOCXX_HAS_COROUTINES
+    using gocxx::runtime::Async;
+    using gocxx::runtime::Executor;
+
+    Async pinger(Chan<int> ping, Chan<int> pong, std::size_t n) {
+        for (std::size_t i = 0; i < n; ++i) {
+            co_await ping.sendAsync(1);
+            co_await pong.recvAsync();
+        }
+    }
+
+    Async ponger(Chan<int> ping, Chan<int> pong, std::size_t n) {
+        for (std::size_t i = 0; i < n; ++i) {
+            co_await ping.recvAsync();
+            co_await pong.sendAsync(1);
+        }
+    }
+
+    void pingPongCoroutines(std::size_t n) {
+        Executor exec;
+        Chan<int> ping, pong;
+        Stopwatch sw;
+        exec.Spawn(pinger(ping, pong, n));
+        exec.Spawn(ponger(ping, pong, n));
+        exec.Run();
+        report("ping-pong (co_await)", n, sw.Seconds());
+    }
+
+    Async producer(Chan<int> ch, std::size_t n) {
+        for (std::size_t i = 0; i < n; ++i) co_await ch.sendAsync(static_cast<int>(i));
+        ch.close();
+    }
+
+    Async consumer(Chan<int> ch) {
+        while (auto v = co_await ch.recvAsync()) {}
+    }
+
+    void pipeline(std::size_t n) {
+        Executor exec;
+        Chan<int> ch(64);
+        Stopwatch sw;
+        exec.Spawn(consumer(ch));
+        exec.Spawn(producer(ch, n));
+        exec.Run();
+        report("pipeline (co_await)", n, sw.Seconds());
+    }
+#endif
+
+    void pingPongThreads(std::size_t n) {
+        Chan<int> ping, pong;
+        Stopwatch sw;
+        std::thread peer([&] {
+            for (std::size_t i = 0; i < n; ++i) {
+                ping.recv();
+                pong.send(1);
+            }
+        });
+        for (std::size_t i = 0; i < n; ++i) {
+            ping.send(1);
+            pong.recv();
+        }
+        peer.join();
+        report("ping-pong (threads)", n, sw.Seconds());
+    }
+
+} // namespace
+
+int main() {
+    const std::size_t trips = Scaled(200'000, 100);
+
+    Header("channel round trip");
+    std::printf("%-22s %10s\n", "case", "ns/op");
+#if GOCXX_HAS_COROUTINES
+    pingPongCoroutines(trips);
+    pipeline(trips * 5);
+#else
+    std::printf("(coroutines disabled: configure with -DGOCXX_ENABLE_COROUTINES=ON)\n");
+#endif
+    pingPongThreads(trips / 10);
+    return 0;
+}
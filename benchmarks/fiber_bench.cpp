@@ -0,0 +1,208 @@
+/**
+ * @file fiber_bench.cpp
+ * @brief Task context switch cost and memory per idle task
+ *
+ * "switch": two contexts bouncing with detail::SwitchContext() on one
+ * thread, the raw register save/restore. "gosched": two tasks yielding to
+ * each other through the run queue on one processor. "ping-pong": a round
+ * trip over two unbuffered channels, between two tasks on one processor
+ * and between two OS threads for reference.
+ * "idle": n tasks parked on a channel receive; resident memory added per
+ * task, next to the same for std::threads blocked on a channel.
+ */
+
+#include "bench.h"
+
+#include <gocxx/base/chan.h>
+#include <gocxx/runtime/scheduler.h>
+#include <gocxx/sync/waitgroup.h>
+
+#include <atomic>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+#if defined(__unix__)
+#include <unistd.h>
+#endif
+
+using namespace gocxx::bench;
+using gocxx::base::Chan;
+using gocxx::runtime::Scheduler;
+using gocxx::sync::WaitGroup;
+
+namespace {
+
+    /// Current resident set size in KiB (0 if unknown)
+    long RssKb() {
+#if defined(__linux__)
+        long pages = 0, resident = 0;
+        if (FILE* f = std::fopen("/proc/self/statm", "r")) {
+            if (std::fscanf(f, "%ld %ld", &pages, &resident) != 2) resident = 0;
+            std::fclose(f);
+        }
+        return resident * (sysconf(_SC_PAGESIZE) / 1024);
+#else
+        return 0;
+#endif
+    }
+
+    void report(const char* name, std::size_t n, double seconds) {
+        std::printf("%-22s %10.1f\n", name, seconds * 1e9 / static_cast<double>(n));
+    }
+
+#if GOCXX_HAS_FIBERS
+    namespace raw {
+        void* mainSp = nullptr;
+        void* fiberSp = nullptr;
+        std::size_t rounds = 0;
+
+        void bounce(void*) {
+            for (std::size_t i = 0; i < rounds; ++i) {
+                gocxx::runtime::detail::SwitchContext(&fiberSp, mainSp);
+            }
+            gocxx::runtime::detail::SwitchContext(&fiberSp, mainSp);
+        }
+    }
+
+    void rawSwitch(std::size_t n) {
+        using namespace gocxx::runtime::detail;
+        StackPool pool(64 * 1024);
+        Stack stack = pool.Acquire();
+        raw::rounds = n;
+        raw::fiberSp = MakeContext(stack, &raw::bounce, nullptr);
+        Stopwatch sw;
+        for (std::size_t i = 0; i <= n; ++i) SwitchContext(&raw::mainSp, raw::fiberSp);
+        double seconds = sw.Seconds();
+        pool.Release(stack);
+        report("switch", 2 * n, seconds);  // Two switches per round
+    }
+#endif
+
+    void gosched(std::size_t n) {
+        Scheduler sched(1);
+        WaitGroup wg;
+        wg.Add(2);
+        Stopwatch sw;
+        for (int t = 0; t < 2; ++t) {
+            sched.Go([&] {
+                for (std::size_t i = 0; i < n; ++i) gocxx::runtime::Gosched();
+                wg.Done();
+            });
+        }
+        wg.Wait();
+        report("gosched", 2 * n, sw.Seconds());
+    }
+
+    void pingPongTasks(std::size_t n) {
+        Scheduler sched(1);
+        Chan<int> ping, pong;
+        WaitGroup wg;
+        wg.Add(2);
+        Stopwatch sw;
+        sched.Go([&] {
+            for (std::size_t i = 0; i < n; ++i) {
+                ping.send(1);
+                pong.recv();
+            }
+            wg.Done();
+        });
+        sched.Go([&] {
+            for (std::size_t i = 0; i < n; ++i) {
+                ping.recv();
+                pong.send(1);
+            }
+            wg.Done();
+        });
+        wg.Wait();
+        report("ping-pong (tasks)", n, sw.Seconds());
+    }
+
+    void pingPongThreads(std::size_t n) {
+        Chan<int> ping, pong;
+        Stopwatch sw;
+        std::thread peer([&] {
+            for (std::size_t i = 0; i < n; ++i) {
+                ping.recv();
+                pong.send(1);
+            }
+        });
+        for (std::size_t i = 0; i < n; ++i) {
+            ping.send(1);
+            pong.recv();
+        }
+        peer.join();
+        report("ping-pong (threads)", n, sw.Seconds());
+    }
+
+    void idleTasks(std::size_t n) {
+        Chan<int> gate;
+        std::atomic<std::size_t> waiting{0};
+        long before = RssKb();
+        Stopwatch sw;
+        {
+            Scheduler sched(1);
+            for (std::size_t i = 0; i < n; ++i) {
+                sched.Go([&] {
+                    waiting.fetch_add(1);
+                    gate.recv();
+                });
+            }
+            while (waiting.load() < n) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));  // Let the last ones park
+            double seconds = sw.Seconds();
+            long after = RssKb();
+            std::printf("%-22s %10zu %12.2f %10.0f %8zu\n", "tasks", n,
+                        static_cast<double>(after - before) / static_cast<double>(n),
+                        seconds * 1e9 / static_cast<double>(n), sched.NumThreads());
+            gate.close();
+        }
+    }
+
+    void idleThreads(std::size_t n) {
+        Chan<int> gate;
+        std::atomic<std::size_t> waiting{0};
+        long before = RssKb();
+        Stopwatch sw;
+        std::vector<std::thread> threads;
+        threads.reserve(n);
+        for (std::size_t i = 0; i < n; ++i) {
+            threads.emplace_back([&] {
+                waiting.fetch_add(1);
+                gate.recv();
+            });
+        }
+        while (waiting.load() < n) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        double seconds = sw.Seconds();
+        long after = RssKb();
+        std::printf("%-22s %10zu %12.2f %10.0f %8zu\n", "std::thread", n,
+                    static_cast<double>(after - before) / static_cast<double>(n),
+                    seconds * 1e9 / static_cast<double>(n), n);
+        gate.close();
+        for (auto& t : threads) t.join();
+    }
+
+} // namespace
+
+int main() {
+    const std::size_t n = Scaled(2'000'000, 1000);
+    const std::size_t trips = Scaled(200'000, 100);
+    const std::size_t idle = Scaled(100'000, 1000);
+    const std::size_t idleThreadCount = Scaled(2'000, 100);
+
+    Header("context switch");
+    std::printf("%-22s %10s\n", "case", "ns/op");
+#if GOCXX_HAS_FIBERS
+    rawSwitch(n);
+#endif
+    gosched(n / 4);
+    pingPongTasks(trips);
+    pingPongThreads(trips / 10);
+
+    Header("idle waiters (stack size " + std::to_string(Scheduler::DefaultStackSize / 1024) + " KiB)");
+    std::printf("%-22s %10s %12s %10s %8s\n", "case", "count", "KiB each", "ns spawn", "threads");
+    idleTasks(idle);
+    idleThreads(idleThreadCount);
+    return 0;
+}
@@ -0,0 +1,90 @@
+/**
+ * @file go_bench.cpp
+ * @brief Spawn cost of gocxx::Go() tasks vs. std::thread, and fan-out with blocking
+ *
+ * "spawn": n empty tasks started from the main thread (global queue) and
+ * from inside a task (local run queue), each signalling a WaitGroup.
+ * "thread": the same with one std::thread per task, for reference.
+ * "pipeline": pairs of tasks passing a value over an unbuffered channel,
+ * so half the tasks park until their partner runs.
+ */
+
+#include "bench.h"
+
+#include <gocxx/base/chan.h>
+#include <gocxx/runtime/scheduler.h>
+#include <gocxx/sync/waitgroup.h>
+
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace gocxx::bench;
+using gocxx::base::Chan;
+using gocxx::runtime::Scheduler;
+using gocxx::sync::WaitGroup;
+
+namespace {
+
+    void report(const char* name, std::size_t n, double seconds) {
+        std::printf("%-18s %10.0f %12.0f\n", name,
+                    seconds * 1e9 / static_cast<double>(n),
+                    static_cast<double>(n) / seconds);
+    }
+
+} // namespace
+
+int main() {
+    const std::size_t n = Scaled(1'000'000, 1000);
+    const std::size_t threads = Scaled(10'000, 100);
+    const std::size_t pairs = Scaled(2'000, 10);
+    Scheduler& sched = Scheduler::Global();
+
+    Header("Go() with GOMAXPROCS=" + std::to_string(sched.Procs()));
+    std::printf("%-18s %10s %12s\n", "case", "ns/task", "tasks/s");
+
+    {
+        WaitGroup wg;
+        wg.Add(static_cast<int>(n));
+        Stopwatch sw;
+        for (std::size_t i = 0; i < n; ++i) sched.Go([&wg] { wg.Done(); });
+        wg.Wait();
+        report("spawn (external)", n, sw.Seconds());
+    }
+
+    {
+        WaitGroup wg;
+        wg.Add(static_cast<int>(n));
+        Stopwatch sw;
+        sched.Go([&] {
+            for (std::size_t i = 0; i < n; ++i) sched.Go([&wg] { wg.Done(); });
+        });
+        wg.Wait();
+        report("spawn (in task)", n, sw.Seconds());
+    }
+
+    {
+        Stopwatch sw;
+        std::vector<std::thread> pool;
+        pool.reserve(threads);
+        for (std::size_t i = 0; i < threads; ++i) pool.emplace_back([] {});
+        for (auto& t : pool) t.join();
+        report("std::thread", threads, sw.Seconds());
+    }
+
+    {
+        WaitGroup wg;
+        wg.Add(static_cast<int>(2 * pairs));
+        Stopwatch sw;
+        for (std::size_t i = 0; i < pairs; ++i) {
+            Chan<int> ch;
+            sched.Go([ch, &wg]() mutable { ch.recv(); wg.Done(); });
+            sched.Go([ch, &wg]() mutable { ch.send(1); wg.Done(); });
+        }
+        wg.Wait();
+        report("pipeline", 2 * pairs, sw.Seconds());
+        std::printf("threads started: %zu\n", sched.NumThreads());
+    }
+    return 0;
+}
@@ -0,0 +1,112 @@
+/**
+ * @file map_bench.cpp
+ * @brief YCSB-style mixes on a shared map: unordered_map under a lock vs sync::Map
+ *
+ * The map is preloaded with 100k keys. Each thread then draws keys from a
+ * skewed distribution: 80% of operations go to the hottest 20% of keys.
+ * "B" is YCSB workload B, 95% reads and 5% updates. "A" is workload A,
+ * 50% reads and 50% updates. Reports total operations per microsecond;
+ * higher is better.
+ */
+
+#include "bench.h"
+
+#include <gocxx/sync/map.h>
+#include <gocxx/sync/rwmutex.h>
+
+#include <atomic>
+#include <cstdio>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+using namespace gocxx::bench;
+
+namespace {
+
+    constexpr uint64_t keyCount = 100'000;
+
+    /// unordered_map behind a lock, as shared caches were written before sync::Map
+    template<typename M, template<typename> class ReadLock>
+    class LockedMap {
+    public:
+        std::optional<uint64_t> Load(uint64_t key) {
+            ReadLock<M> lock(mtx_);
+            auto it = map_.find(key);
+            if (it == map_.end()) return std::nullopt;
+            return it->second;
+        }
+
+        void Store(uint64_t key, uint64_t value) {
+            std::unique_lock<M> lock(mtx_);
+            map_[key] = value;
+        }
+
+    private:
+        M mtx_;
+        std::unordered_map<uint64_t, uint64_t> map_;
+    };
+
+    using SyncMap = gocxx::sync::Map<uint64_t, uint64_t>;
+
+    /// 80% of draws fall in the first 20% of the key space
+    uint64_t nextKey(uint64_t& seed) {
+        seed ^= seed << 13;
+        seed ^= seed >> 7;
+        seed ^= seed << 17;
+        uint64_t r = seed % 100;
+        uint64_t k = seed >> 8;
+        return r < 80 ? k % (keyCount / 5) : keyCount / 5 + k % (keyCount - keyCount / 5);
+    }
+
+    template<typename Map>
+    double opsPerUs(int threads, std::size_t perThread, int readPercent) {
+        Map map;
+        for (uint64_t k = 0; k < keyCount; ++k) map.Store(k, k);
+
+        std::atomic<uint64_t> sink{0};
+        std::vector<std::thread> workers;
+        Stopwatch sw;
+        for (int t = 0; t < threads; ++t) {
+            workers.emplace_back([&, t] {
+                uint64_t seed = 0x9E3779B97F4A7C15ull * static_cast<uint64_t>(t + 1);
+                uint64_t sum = 0;
+                for (std::size_t i = 0; i < perThread; ++i) {
+                    uint64_t key = nextKey(seed);
+                    if (static_cast<int>((seed >> 40) % 100) < readPercent) {
+                        sum += map.Load(key).value_or(0);
+                    } else {
+                        map.Store(key, i);
+                    }
+                }
+                sink += sum;
+            });
+        }
+        for (auto& w : workers) w.join();
+        double seconds = sw.Seconds();
+        return static_cast<double>(perThread * static_cast<std::size_t>(threads)) / (seconds * 1e6);
+    }
+
+} // namespace
+
+int main() {
+    const std::size_t ops = Scaled(8'000'000, 1000);
+    const int threadCounts[] = {1, 2, 4, 8, 16};
+
+    for (int readPercent : {95, 50}) {
+        Header(std::string(readPercent == 95 ? "workload B (95% read, 5% update)" : "workload A (50% read, 50% update)") +
+               ", ops per microsecond (CPUs: " + std::to_string(std::thread::hardware_concurrency()) + ")");
+        std::printf("%8s %14s %14s %14s\n", "threads", "mutex+umap", "RWMutex+umap", "sync::Map");
+        for (int threads : threadCounts) {
+            const std::size_t perThread = ops / static_cast<std::size_t>(threads);
+            std::printf("%8d %14.1f %14.1f %14.1f\n", threads,
+                        opsPerUs<LockedMap<std::mutex, std::unique_lock>>(threads, perThread, readPercent),
+                        opsPerUs<LockedMap<gocxx::sync::RWMutex, std::shared_lock>>(threads, perThread, readPercent),
+                        opsPerUs<SyncMap>(threads, perThread, readPercent));
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,91 @@
+/**
+ * @file mutex_bench.cpp
+ * @brief ns per lock/unlock pair under 2, 8 and 32 contending threads
+ *
+ * Every thread increments a shared counter under the lock, with a little
+ * work outside the critical section. Compares std::mutex with sync::Mutex,
+ * with the contention profile off and with every contended Lock() sampled.
+ * "max wait" is the longest time any single thread needed for one
+ * acquisition, which starvation mode bounds.
+ */
+
+#include "bench.h"
+
+#include <gocxx/sync/mutex.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace gocxx::bench;
+
+namespace {
+
+    struct Result {
+        double nsPerOp;
+        double maxWaitUs;
+    };
+
+    template<typename M>
+    Result contend(int threads, std::size_t perThread) {
+        M mtx;
+        uint64_t counter = 0;
+        std::atomic<int64_t> maxWait{0};
+        std::vector<std::thread> workers;
+        Stopwatch sw;
+        for (int t = 0; t < threads; ++t) {
+            workers.emplace_back([&] {
+                int64_t worst = 0;
+                volatile uint64_t local = 0;
+                for (std::size_t i = 0; i < perThread; ++i) {
+                    auto start = Clock::now();
+                    mtx.lock();
+                    int64_t waited = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count();
+                    ++counter;
+                    mtx.unlock();
+                    worst = std::max(worst, waited);
+                    for (int k = 0; k < 20; ++k) local = local + static_cast<uint64_t>(k);
+                }
+                int64_t seen = maxWait.load();
+                while (worst > seen && !maxWait.compare_exchange_weak(seen, worst)) {}
+            });
+        }
+        for (auto& w : workers) w.join();
+        double seconds = sw.Seconds();
+        if (counter != perThread * static_cast<std::size_t>(threads)) std::printf("lost updates!\n");
+        return {seconds * 1e9 / static_cast<double>(counter), static_cast<double>(maxWait.load()) / 1e3};
+    }
+
+    void report(const char* name, int threads, Result r) {
+        std::printf("%-22s %8d %10.1f %12.0f\n", name, threads, r.nsPerOp, r.maxWaitUs);
+    }
+
+} // namespace
+
+int main() {
+    const std::size_t ops = Scaled(4'000'000, 1000);
+    const int threadCounts[] = {2, 8, 32};
+
+    Header("mutex contention");
+    std::printf("%-22s %8s %10s %12s\n", "mutex", "threads", "ns/op", "max wait us");
+    for (int threads : threadCounts) {
+        const std::size_t perThread = ops / static_cast<std::size_t>(threads);
+        report("std::mutex", threads, contend<std::mutex>(threads, perThread));
+        report("sync::Mutex", threads, contend<gocxx::sync::Mutex>(threads, perThread));
+
+        gocxx::sync::SetMutexProfileFraction(1);
+        report("sync::Mutex (profiled)", threads, contend<gocxx::sync::Mutex>(threads, perThread));
+        gocxx::sync::SetMutexProfileFraction(0);
+    }
+
+    auto profile = gocxx::sync::MutexProfile();
+    if (!profile.empty()) {
+        std::printf("\ntop contended site: %s, %llu waits, %.1f ms total\n", profile[0].Symbol().c_str(),
+                    static_cast<unsigned long long>(profile[0].count),
+                    static_cast<double>(profile[0].waitNanos) / 1e6);
+    }
+    return 0;
+}
@@ -0,0 +1,116 @@
+/**
+ * @file pipe_bench.cpp
+ * @brief io::Pipe() throughput in GB/s: ring buffer and zero-copy modes vs the old byte deque
+ *
+ * One thread writes a stream through the pipe in fixed-size chunks and
+ * another reads it with a 32 KiB buffer. The "deque" column is the previous
+ * implementation, reproduced here: a std::deque<uint8_t> filled and drained
+ * a byte at a time, with a notify_all per write. It moves a tenth of the
+ * bytes to keep the run short. Higher is better.
+ */
+
+#include "bench.h"
+
+#include <gocxx/io/io.h>
+#include <gocxx/io/io_errors.h>
+
+#include <condition_variable>
+#include <cstdio>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace gocxx::bench;
+using gocxx::base::Result;
+
+namespace {
+
+    /// The io::Pipe() internals this benchmark was written to replace
+    class DequePipe {
+    public:
+        Result<std::size_t> Write(const uint8_t* data, std::size_t size) {
+            std::unique_lock<std::mutex> lock(mtx_);
+            buffer_.insert(buffer_.end(), data, data + size);
+            cv_.notify_all();
+            return { size };
+        }
+
+        Result<std::size_t> Read(uint8_t* out, std::size_t size) {
+            std::unique_lock<std::mutex> lock(mtx_);
+            while (buffer_.empty() && !closed_) cv_.wait(lock);
+            std::size_t n = 0;
+            while (!buffer_.empty() && n < size) {
+                out[n++] = buffer_.front();
+                buffer_.pop_front();
+            }
+            if (n > 0) return { n };
+            return { 0, gocxx::io::ErrEOF };
+        }
+
+        void Close() {
+            std::lock_guard<std::mutex> lock(mtx_);
+            closed_ = true;
+            cv_.notify_all();
+        }
+
+    private:
+        std::mutex mtx_;
+        std::condition_variable cv_;
+        std::deque<uint8_t> buffer_;
+        bool closed_ = false;
+    };
+
+    template<typename Writer, typename Reader, typename Close>
+    double gbPerSec(std::size_t total, std::size_t chunk, Writer& w, Reader& r, Close close) {
+        std::vector<uint8_t> src(chunk, 0x5a);
+        Stopwatch sw;
+        std::thread writer([&] {
+            for (std::size_t sent = 0; sent < total; sent += chunk) w.Write(src.data(), chunk);
+            close();
+        });
+        std::vector<uint8_t> dst(32 * 1024);
+        std::size_t received = 0;
+        for (;;) {
+            auto res = r.Read(dst.data(), dst.size());
+            received += res.value;
+            if (!res.Ok()) break;
+        }
+        writer.join();
+        return static_cast<double>(received) / sw.Seconds() / 1e9;
+    }
+
+    double pipe(std::size_t total, std::size_t chunk, const gocxx::io::PipeOptions& options) {
+        auto [r, w] = gocxx::io::Pipe(options);
+        return gbPerSec(total, chunk, *w, *r, [&w = w] { w->Close(); });
+    }
+
+    double deque(std::size_t total, std::size_t chunk) {
+        DequePipe p;
+        return gbPerSec(total, chunk, p, p, [&p] { p.Close(); });
+    }
+
+} // namespace
+
+int main() {
+    const std::size_t total = Scaled(1ull << 30, 1 << 20);
+
+    gocxx::io::PipeOptions ring;
+    gocxx::io::PipeOptions bigRing;
+    bigRing.bufferSize = 1 << 20;
+    gocxx::io::PipeOptions zeroCopy;
+    zeroCopy.zeroCopy = true;
+
+    Header("GB/s through io::Pipe(), " + std::to_string(total >> 20) + " MiB per run (CPUs: " +
+           std::to_string(std::thread::hardware_concurrency()) + ")");
+    std::printf("%10s %12s %12s %12s %12s\n", "write", "deque", "ring 64K", "ring 1M", "zero-copy");
+    for (std::size_t chunk : {4096u, 32768u, 262144u}) {
+        const std::size_t n = total / chunk * chunk;
+        std::printf("%10zu %12.3f %12.3f %12.3f %12.3f\n", chunk,
+                    deque(std::max(n / 10, chunk), chunk),
+                    pipe(n, chunk, ring),
+                    pipe(n, chunk, bigRing),
+                    pipe(n, chunk, zeroCopy));
+    }
+    return 0;
+}
@@ -0,0 +1,127 @@
+/**
+ * @file pool_bench.cpp
+ * @brief ns per Get/Put pair of a 64 KiB buffer at 1, 4 and 32 threads
+ *
+ * Compares the sharded sync::Pool (shared_ptr) and sync::UniquePool
+ * (unique_ptr returned by its deleter) with a single mutex around a stack
+ * of shared_ptrs, the previous Pool design. "created" is how many buffers
+ * the pool had to allocate.
+ */
+
+#include "bench.h"
+
+#include <gocxx/sync/pool.h>
+
+#include <atomic>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <stack>
+#include <thread>
+#include <vector>
+
+using namespace gocxx::bench;
+using gocxx::sync::Pool;
+using gocxx::sync::UniquePool;
+
+namespace {
+
+    struct Buffer {
+        char data[64 * 1024];
+    };
+
+    /// One mutex around a stack: the pool this benchmark replaces
+    class LockedPool {
+    public:
+        explicit LockedPool(std::atomic<std::size_t>& created) : created_(created) {}
+
+        std::shared_ptr<Buffer> Get() {
+            std::lock_guard<std::mutex> lock(mtx_);
+            if (stack_.empty()) {
+                created_++;
+                return std::make_shared<Buffer>();
+            }
+            auto obj = std::move(stack_.top());
+            stack_.pop();
+            return obj;
+        }
+
+        void Put(std::shared_ptr<Buffer> obj) {
+            std::lock_guard<std::mutex> lock(mtx_);
+            stack_.push(std::move(obj));
+        }
+
+    private:
+        std::stack<std::shared_ptr<Buffer>> stack_;
+        std::mutex mtx_;
+        std::atomic<std::size_t>& created_;
+    };
+
+    template<typename Fn>
+    double run(int threads, std::size_t perThread, Fn&& fn) {
+        std::vector<std::thread> workers;
+        Stopwatch sw;
+        for (int t = 0; t < threads; ++t) {
+            workers.emplace_back([&] {
+                for (std::size_t i = 0; i < perThread; ++i) fn(i);
+            });
+        }
+        for (auto& w : workers) w.join();
+        return sw.Seconds() * 1e9 / static_cast<double>(perThread * static_cast<std::size_t>(threads));
+    }
+
+    void report(const char* name, int threads, double ns, std::size_t created) {
+        std::printf("%-14s %8d %10.1f %10zu\n", name, threads, ns, created);
+    }
+
+} // namespace
+
+int main() {
+    const std::size_t ops = Scaled(4'000'000, 1000);
+    const int threadCounts[] = {1, 4, 32};
+
+    Header("sync::Pool Get/Put, 64 KiB buffers");
+    std::printf("%-14s %8s %10s %10s\n", "pool", "threads", "ns/op", "created");
+    for (int threads : threadCounts) {
+        const std::size_t perThread = ops / static_cast<std::size_t>(threads);
+
+        std::atomic<std::size_t> created{0};
+        {
+            LockedPool pool(created);
+            double ns = run(threads, perThread, [&](std::size_t i) {
+                auto buf = pool.Get();
+                buf->data[i & 0xffff] = 1;
+                pool.Put(std::move(buf));
+            });
+            report("mutex+stack", threads, ns, created.load());
+        }
+
+        created = 0;
+        {
+            Pool<Buffer> pool([&] {
+                created++;
+                return std::make_shared<Buffer>();
+            });
+            double ns = run(threads, perThread, [&](std::size_t i) {
+                auto buf = pool.Get();
+                buf->data[i & 0xffff] = 1;
+                pool.Put(std::move(buf));
+            });
+            report("Pool", threads, ns, created.load());
+        }
+
+        created = 0;
+        {
+            UniquePool<Buffer> pool([&] {
+                created++;
+                return std::make_unique<Buffer>();
+            });
+            double ns = run(threads, perThread, [&](std::size_t i) {
+                auto buf = pool.Get();
+                buf->data[i & 0xffff] = 1;
+            });
+            report("UniquePool", threads, ns, created.load());
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,89 @@
+/**
+ * @file rwmutex_bench.cpp
+ * @brief Read-lock throughput at 1 to 64 threads, std::shared_mutex vs sync::RWMutex
+ *
+ * Every thread looks up a small routing table under a read lock in a
+ * loop. In the "1% writes" rows, one writer thread also replaces an entry
+ * under the write lock every 100 reads it makes itself. Reports total reads
+ * per microsecond; higher is better.
+ */
+
+#include "bench.h"
+
+#include <gocxx/sync/rwmutex.h>
+
+#include <array>
+#include <atomic>
+#include <cstdio>
+#include <shared_mutex>
+#include <thread>
+#include <vector>
+
+using namespace gocxx::bench;
+
+namespace {
+
+    struct Table {
+        std::array<uint64_t, 64> routes{};
+    };
+
+    template<typename M>
+    double readsPerUs(int threads, std::size_t perThread, bool withWriter) {
+        M mtx;
+        Table table;
+        std::atomic<bool> stop{false};
+        std::atomic<uint64_t> sink{0};
+        std::thread writer;
+        if (withWriter) {
+            writer = std::thread([&] {
+                uint64_t n = 0;
+                while (!stop.load(std::memory_order_relaxed)) {
+                    for (int i = 0; i < 100; ++i) {
+                        std::shared_lock<M> lock(mtx);
+                        n += table.routes[static_cast<std::size_t>(i) & 63];
+                    }
+                    std::unique_lock<M> lock(mtx);
+                    table.routes[n & 63] = n;
+                }
+                sink += n;
+            });
+        }
+
+        std::vector<std::thread> readers;
+        Stopwatch sw;
+        for (int t = 0; t < threads; ++t) {
+            readers.emplace_back([&, t] {
+                uint64_t sum = 0;
+                for (std::size_t i = 0; i < perThread; ++i) {
+                    std::shared_lock<M> lock(mtx);
+                    sum += table.routes[(i + static_cast<std::size_t>(t)) & 63];
+                }
+                sink += sum;
+            });
+        }
+        for (auto& r : readers) r.join();
+        double seconds = sw.Seconds();
+        stop = true;
+        if (writer.joinable()) writer.join();
+        return static_cast<double>(perThread * static_cast<std::size_t>(threads)) / (seconds * 1e6);
+    }
+
+} // namespace
+
+int main() {
+    const std::size_t reads = Scaled(16'000'000, 1000);
+    const int threadCounts[] = {1, 2, 4, 8, 16, 32, 64};
+
+    Header("read locks per microsecond (CPUs: " + std::to_string(std::thread::hardware_concurrency()) +
+           ", reader slots: " + std::to_string(gocxx::sync::detail::ShardCount()) + ")");
+    std::printf("%8s %14s %14s %14s %14s\n", "threads", "shared_mutex", "RWMutex", "shared 1%w", "RWMutex 1%w");
+    for (int threads : threadCounts) {
+        const std::size_t perThread = reads / static_cast<std::size_t>(threads);
+        std::printf("%8d %14.1f %14.1f %14.1f %14.1f\n", threads,
+                    readsPerUs<std::shared_mutex>(threads, perThread, false),
+                    readsPerUs<gocxx::sync::RWMutex>(threads, perThread, false),
+                    readsPerUs<std::shared_mutex>(threads, perThread, true),
+                    readsPerUs<gocxx::sync::RWMutex>(threads, perThread, true));
+    }
+    return 0;
+}
@@ -0,0 +1,77 @@
+/**
+ * @file select_bench.cpp
+ * @brief ns/op of 2-, 4- and 8-way selects: stack-resident select() vs. the heap-based Select class
+ *
+ * Every channel always holds one value, so each select finds all cases ready
+ * and picks one at random; the chosen channel is refilled before the next
+ * iteration. This measures the per-select overhead rather than blocking.
+ */
+
+#include "bench.h"
+
+#include <gocxx/base/select.h>
+
+#include <array>
+#include <memory>
+#include <utility>
+
+using namespace gocxx::base;
+using namespace gocxx::bench;
+
+namespace {
+
+    template<std::size_t N, std::size_t... I>
+    double runStack(std::array<Chan<int>, N>& chans, std::size_t iterations, std::index_sequence<I...>) {
+        int64_t sum = 0;
+        std::size_t hit = 0;
+        Stopwatch sw;
+        for (std::size_t it = 0; it < iterations; ++it) {
+            select(recv(chans[I], [&](std::optional<int> v) { sum += *v; hit = I; })...);
+            chans[hit].trySend(1);
+        }
+        double ns = static_cast<double>(sw.Nanoseconds()) / static_cast<double>(iterations);
+        if (sum != static_cast<int64_t>(iterations)) std::exit(1);
+        return ns;
+    }
+
+    template<std::size_t N, std::size_t... I>
+    double runLegacy(std::array<Chan<int>, N>& chans, std::size_t iterations, std::index_sequence<I...>) {
+        int64_t sum = 0;
+        std::size_t hit = 0;
+        Stopwatch sw;
+        for (std::size_t it = 0; it < iterations; ++it) {
+            Select sel;
+            (sel.addCase(std::make_unique<RecvCase<int>>(chans[I],
+                std::function<void(std::optional<int>)>([&](std::optional<int> v) { sum += *v; hit = I; }))), ...);
+            sel.run();
+            chans[hit].trySend(1);
+        }
+        double ns = static_cast<double>(sw.Nanoseconds()) / static_cast<double>(iterations);
+        if (sum != static_cast<int64_t>(iterations)) std::exit(1);
+        return ns;
+    }
+
+    template<std::size_t N>
+    void row(std::size_t iterations) {
+        std::array<Chan<int>, N> chans;
+        for (auto& ch : chans) {
+            ch = Chan<int>(4);
+            ch.trySend(1);
+        }
+        double legacy = runLegacy(chans, iterations, std::make_index_sequence<N>{});
+        double stack = runStack(chans, iterations, std::make_index_sequence<N>{});
+        std::printf("%-8zu %14.1f %14.1f %7.2fx\n", N, legacy, stack, legacy / stack);
+    }
+
+} // namespace
+
+int main() {
+    const std::size_t iterations = Scaled(1'000'000, 1000);
+
+    Header("select over buffered Chan<int>, all cases ready");
+    std::printf("%-8s %14s %14s %8s\n", "cases", "Select ns/op", "select ns/op", "speedup");
+    row<2>(iterations);
+    row<4>(iterations);
+    row<8>(iterations);
+    return 0;
+}
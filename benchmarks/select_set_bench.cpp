@@ -0,0 +1,76 @@
+/**
+ * @file select_set_bench.cpp
+ * @brief Fan-in from N channels: SelectSet vs. polling every channel with tryRecv
+ *
+ * One producer sends to the channels in a scattered order while a single
+ * consumer drains them, either by looping over all channels with canRecv()
+ * and tryRecv() or by waiting on a SelectSet. Reports messages per second.
+ */
+
+#include "bench.h"
+
+#include <gocxx/base/select.h>
+
+#include <thread>
+#include <vector>
+
+using namespace gocxx::base;
+using namespace gocxx::bench;
+
+namespace {
+
+    std::vector<Chan<int>> makeChannels(std::size_t n) {
+        std::vector<Chan<int>> chans;
+        for (std::size_t i = 0; i < n; ++i) chans.emplace_back(16);
+        return chans;
+    }
+
+    std::thread produce(std::vector<Chan<int>>& chans, std::size_t messages) {
+        return std::thread([&chans, messages] {
+            for (std::size_t i = 0; i < messages; ++i) {
+                chans[(i * 7919) % chans.size()] << 1;
+            }
+        });
+    }
+
+    double runPolling(std::size_t n, std::size_t messages) {
+        auto chans = makeChannels(n);
+        Stopwatch sw;
+        std::thread producer = produce(chans, messages);
+        std::size_t received = 0;
+        while (received < messages) {
+            for (auto& ch : chans) {
+                if (ch.canRecv() && ch.tryRecv().Ok()) ++received;
+            }
+        }
+        producer.join();
+        return static_cast<double>(messages) / sw.Seconds();
+    }
+
+    double runSelectSet(std::size_t n, std::size_t messages) {
+        auto chans = makeChannels(n);
+        SelectSet<int> set;
+        for (auto& ch : chans) set.add(ch);
+        Stopwatch sw;
+        std::thread producer = produce(chans, messages);
+        for (std::size_t received = 0; received < messages; ++received) {
+            set.recv();
+        }
+        producer.join();
+        return static_cast<double>(messages) / sw.Seconds();
+    }
+
+} // namespace
+
+int main() {
+    const std::size_t messages = Scaled(200'000, 1000);
+
+    Header("fan-in to one consumer, buffered Chan<int>(16)");
+    std::printf("%-10s %16s %16s\n", "channels", "polling msg/s", "SelectSet msg/s");
+    for (std::size_t n : {10, 100, 1000}) {
+        double polling = runPolling(n, messages);
+        double set = runSelectSet(n, messages);
+        std::printf("%-10zu %16.0f %16.0f\n", n, polling, set);
+    }
+    return 0;
+}
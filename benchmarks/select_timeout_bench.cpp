@@ -0,0 +1,65 @@
+/**
+ * @file select_timeout_bench.cpp
+ * @brief Cost of a timed select whose reply is already there: time::Timer vs. timeoutCase()
+ *
+ * Models an RPC wait: the reply channel holds a value and the select also
+ * carries a one-second deadline. With time::Timer every call starts (and
+ * stops) a timer thread; timeoutCase() only records a deadline. Reports the
+ * mean and p99 cost per select.
+ */
+
+#include "bench.h"
+
+#include <gocxx/base/select.h>
+#include <gocxx/time/timer.h>
+
+#include <vector>
+
+using namespace gocxx::base;
+using namespace gocxx::bench;
+
+namespace {
+
+    template<typename SelectOnce>
+    void run(const char* name, std::size_t iterations, SelectOnce&& selectOnce) {
+        Chan<int> reply(1);
+        std::vector<int64_t> samples;
+        samples.reserve(iterations);
+        Stopwatch total;
+        for (std::size_t i = 0; i < iterations; ++i) {
+            reply.trySend(1);
+            Stopwatch sw;
+            selectOnce(reply);
+            samples.push_back(sw.Nanoseconds());
+        }
+        double mean = static_cast<double>(total.Nanoseconds()) / static_cast<double>(iterations);
+        std::printf("%-14s %12.0f %12lld\n", name, mean,
+                    static_cast<long long>(Percentile(samples, 99)));
+    }
+
+} // namespace
+
+int main() {
+    const std::size_t iterations = Scaled(20'000, 100);
+
+    Header("timed select, reply ready");
+    std::printf("%-14s %12s %12s\n", "deadline via", "mean ns", "p99 ns");
+
+    run("time::Timer", iterations, [](Chan<int>& reply) {
+        auto timer = gocxx::time::NewTimer(gocxx::time::Milliseconds(1000));
+        auto timeout = timer->C();
+        select(
+            recv(reply, [](std::optional<int>) {}),
+            recv(*timeout, [](std::optional<gocxx::time::Time>) {})
+        );
+        timer->Stop();
+    });
+
+    run("timeoutCase", iterations, [](Chan<int>& reply) {
+        select(
+            recv(reply, [](std::optional<int>) {}),
+            timeoutCase(gocxx::time::Milliseconds(1000), [] {})
+        );
+    });
+    return 0;
+}
@@ -0,0 +1,69 @@
+/**
+ * @file semaphore_bench.cpp
+ * @brief Bounding concurrency: a buffered Chan<bool> used as a semaphore vs sync::Semaphore
+ *
+ * Each thread repeatedly takes a token, does a little work and gives the
+ * token back. The channel version sends to take and receives to give back,
+ * the idiom sync::Semaphore replaces. Reports nanoseconds per acquire/release
+ * pair, summed over threads; lower is better.
+ */
+
+#include "bench.h"
+
+#include <gocxx/base/chan.h>
+#include <gocxx/sync/semaphore.h>
+
+#include <atomic>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+using namespace gocxx::bench;
+
+namespace {
+
+    struct ChanSemaphore {
+        explicit ChanSemaphore(int64_t n) : tokens(static_cast<std::size_t>(n)) {}
+        void Acquire() { tokens.send(true); }
+        void Release() { tokens.recv(); }
+
+        gocxx::base::Chan<bool> tokens;
+    };
+
+    template<typename Sem>
+    double nsPerPair(int threads, int64_t limit, std::size_t perThread) {
+        Sem sem(limit);
+        std::atomic<uint64_t> sink{0};
+        std::vector<std::thread> workers;
+        Stopwatch sw;
+        for (int t = 0; t < threads; ++t) {
+            workers.emplace_back([&] {
+                uint64_t work = 0;
+                for (std::size_t i = 0; i < perThread; ++i) {
+                    sem.Acquire();
+                    work += i * 2654435761u;
+                    sem.Release();
+                }
+                sink += work;
+            });
+        }
+        for (auto& w : workers) w.join();
+        return static_cast<double>(sw.Nanoseconds()) / static_cast<double>(perThread * static_cast<std::size_t>(threads));
+    }
+
+} // namespace
+
+int main() {
+    const std::size_t pairs = Scaled(4'000'000, 1000);
+
+    Header("ns per acquire/release pair (CPUs: " + std::to_string(std::thread::hardware_concurrency()) + ")");
+    std::printf("%8s %8s %14s %14s\n", "threads", "limit", "Chan<bool>", "Semaphore");
+    const int rows[][2] = {{1, 4}, {4, 4}, {8, 4}, {8, 1}, {16, 8}};
+    for (const auto& row : rows) {
+        const std::size_t perThread = pairs / static_cast<std::size_t>(row[0]);
+        std::printf("%8d %8d %14.1f %14.1f\n", row[0], row[1],
+                    nsPerPair<ChanSemaphore>(row[0], row[1], perThread),
+                    nsPerPair<gocxx::sync::Semaphore>(row[0], row[1], perThread));
+    }
+    return 0;
+}
@@ -0,0 +1,83 @@
+/**
+ * @file singleflight_bench.cpp
+ * @brief Cache-flush stampede: 10k concurrent callers over 100 keys, direct vs singleflight
+ *
+ * Each round spawns 10,000 tasks at once, as a burst of cache misses after
+ * a flush would. Caller i loads key i % 100 from a simulated backing store
+ * that takes 1ms per load. The "direct" rows send every caller to the store.
+ * The "singleflight" rows coalesce callers through singleflight::Group.
+ * Reports store loads and wall time per round; lower is better.
+ */
+
+#include "bench.h"
+
+#include <gocxx/runtime/scheduler.h>
+#include <gocxx/sync/singleflight.h>
+#include <gocxx/sync/waitgroup.h>
+#include <gocxx/time/time.h>
+
+#include <atomic>
+#include <cstdio>
+#include <thread>
+
+using namespace gocxx::bench;
+using gocxx::base::Result;
+
+namespace {
+
+    constexpr int callers = 10'000;
+    constexpr int keys = 100;
+
+    struct Store {
+        std::atomic<uint64_t> loads{0};
+
+        Result<uint64_t> Load(int key) {
+            loads.fetch_add(1, std::memory_order_relaxed);
+            gocxx::time::Sleep(gocxx::time::Milliseconds(1));
+            return Result<uint64_t>(static_cast<uint64_t>(key) * 31);
+        }
+    };
+
+    struct Round {
+        double loads;
+        double ms;
+    };
+
+    template<typename Get>
+    Round run(int rounds, Store& store, Get get) {
+        std::atomic<uint64_t> sink{0};
+        store.loads = 0;
+        Stopwatch sw;
+        for (int r = 0; r < rounds; ++r) {
+            gocxx::sync::WaitGroup wg;
+            wg.Add(callers);
+            for (int i = 0; i < callers; ++i) {
+                gocxx::Go([&, i] {
+                    sink.fetch_add(get(i % keys).value, std::memory_order_relaxed);
+                    wg.Done();
+                });
+            }
+            wg.Wait();
+        }
+        return {static_cast<double>(store.loads.load()) / rounds, sw.Seconds() * 1e3 / rounds};
+    }
+
+} // namespace
+
+int main() {
+    const int rounds = static_cast<int>(Scaled(20, 2));
+    Store store;
+    gocxx::sync::singleflight::Group<int, uint64_t> group;
+
+    Round direct = run(rounds, store, [&](int key) { return store.Load(key); });
+    Round coalesced = run(rounds, store, [&](int key) {
+        return group.Do(key, [&] { return store.Load(key); });
+    });
+
+    Header("per round of " + std::to_string(callers) + " callers over " + std::to_string(keys) +
+           " keys (procs: " + std::to_string(gocxx::runtime::GOMAXPROCS()) + ")");
+    std::printf("%14s %14s %14s\n", "", "store loads", "ms");
+    std::printf("%14s %14.0f %14.2f\n", "direct", direct.loads, direct.ms);
+    std::printf("%14s %14.0f %14.2f\n", "singleflight", coalesced.loads, coalesced.ms);
+    return 0;
+}
@@ -0,0 +1,68 @@
+/**
+ * @file timer_bench.cpp
+ * @brief Create, reset and stop 1M timers on the shared timer service
+ *
+ * All timers are created with a one-hour timeout so none fires, reset once
+ * and then stopped. Reports ns per operation, CPU time, and the growth in
+ * peak RSS while all timers are alive. The previous implementation started
+ * one thread per Timer, so this many timers could not exist at once.
+ */
+
+#include "bench.h"
+
+#include <gocxx/time/timer.h>
+#include <gocxx/time/timer_service.h>
+
+#include <memory>
+#include <vector>
+
+using namespace gocxx::time;
+using namespace gocxx::bench;
+
+namespace {
+
+    void phase(const char* name, std::size_t n, double wallSeconds, double cpuSeconds) {
+        std::printf("%-10s %12.0f %12.3f\n", name, wallSeconds * 1e9 / static_cast<double>(n), cpuSeconds);
+    }
+
+} // namespace
+
+int main() {
+    const std::size_t n = Scaled(1'000'000, 1000);
+    const Duration hour(Duration::Hour);
+    const Duration later(2 * Duration::Hour);
+
+    Header("Timer (channel) x " + std::to_string(n));
+    std::printf("%-10s %12s %12s\n", "phase", "ns/op", "cpu s");
+
+    long rssBefore = PeakRssKb();
+    std::vector<std::unique_ptr<Timer>> timers;
+    timers.reserve(n);
+
+    double cpu = CpuSeconds();
+    Stopwatch sw;
+    for (std::size_t i = 0; i < n; ++i) timers.push_back(NewTimer(hour));
+    phase("create", n, sw.Seconds(), CpuSeconds() - cpu);
+    long rssAlive = PeakRssKb();
+
+    cpu = CpuSeconds();
+    sw.Reset();
+    for (auto& t : timers) t->Reset(later);
+    phase("reset", n, sw.Seconds(), CpuSeconds() - cpu);
+
+    cpu = CpuSeconds();
+    sw.Reset();
+    for (auto& t : timers) t->Stop();
+    phase("stop", n, sw.Seconds(), CpuSeconds() - cpu);
+
+    cpu = CpuSeconds();
+    sw.Reset();
+    timers.clear();
+    phase("destroy", n, sw.Seconds(), CpuSeconds() - cpu);
+
+    std::printf("pending after stop: %zu\n", TimerService::Global().Pending());
+    std::printf("peak RSS growth with %zu live timers: %.1f MiB (%.0f bytes/timer)\n", n,
+                static_cast<double>(rssAlive - rssBefore) / 1024.0,
+                static_cast<double>(rssAlive - rssBefore) * 1024.0 / static_cast<double>(n));
+    return 0;
+}
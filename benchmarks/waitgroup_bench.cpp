@@ -0,0 +1,79 @@
+/**
+ * @file waitgroup_bench.cpp
+ * @brief ns per WaitGroup::Done() with 1, 8 and 64 threads finishing at once
+ *
+ * Each thread calls Done() n times on a group set to threads * n while the
+ * main thread waits. Compares sync::WaitGroup, whose Done() is one
+ * fetch_add, with a mutex-guarded counter and condition variable, the
+ * previous design.
+ */
+
+#include "bench.h"
+
+#include <gocxx/sync/waitgroup.h>
+
+#include <condition_variable>
+#include <cstdio>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace gocxx::bench;
+using gocxx::sync::WaitGroup;
+
+namespace {
+
+    /// Mutex on every Add/Done: the WaitGroup this benchmark replaces
+    class LockedWaitGroup {
+    public:
+        void Add(int delta) {
+            std::lock_guard<std::mutex> lock(mtx_);
+            count_ += delta;
+            if (count_ == 0) cv_.notify_all();
+        }
+
+        void Done() { Add(-1); }
+
+        void Wait() {
+            std::unique_lock<std::mutex> lock(mtx_);
+            cv_.wait(lock, [this] { return count_ == 0; });
+        }
+
+    private:
+        std::mutex mtx_;
+        std::condition_variable cv_;
+        int count_ = 0;
+    };
+
+    template<typename Group>
+    double burst(int threads, std::size_t perThread) {
+        Group wg;
+        wg.Add(static_cast<int>(perThread) * threads);
+        std::vector<std::thread> workers;
+        Stopwatch sw;
+        for (int t = 0; t < threads; ++t) {
+            workers.emplace_back([&] {
+                for (std::size_t i = 0; i < perThread; ++i) wg.Done();
+            });
+        }
+        wg.Wait();
+        double seconds = sw.Seconds();
+        for (auto& w : workers) w.join();
+        return seconds * 1e9 / static_cast<double>(perThread * static_cast<std::size_t>(threads));
+    }
+
+} // namespace
+
+int main() {
+    const std::size_t total = Scaled(8'000'000, 1000);
+    const int threadCounts[] = {1, 8, 64};
+
+    Header("WaitGroup Done() burst");
+    std::printf("%-14s %8s %10s\n", "group", "threads", "ns/Done");
+    for (int threads : threadCounts) {
+        const std::size_t perThread = total / static_cast<std::size_t>(threads);
+        std::printf("%-14s %8d %10.1f\n", "mutex+cv", threads, burst<LockedWaitGroup>(threads, perThread));
+        std::printf("%-14s %8d %10.1f\n", "WaitGroup", threads, burst<WaitGroup>(threads, perThread));
+    }
+    return 0;
+}
@@ -12,14 +12,17 @@
 #include <optional>
 #include <stdexcept>
 #include <gocxx/sync/sync.h>
-#include <queue>
 #include <type_traits>
 #include <vector>
 #include <atomic>
-#include <condition_variable>
+#include <gocxx/runtime/condvar.h>
+#include <gocxx/runtime/executor.h>
 #include <algorithm>
+#include <cstdint>
+#include <new>
 #include <gocxx/errors/errors.h>
 #include <gocxx/base/result.h>
+#include <iterator>
 
 /**
  * @namespace gocxx
@@ -36,6 +39,108 @@ namespace gocxx {
  */
 namespace base {
 
+    /**
+     * @interface ChanWaiter
+     * @brief Callback a channel invokes when a blocked select may proceed
+     *
+     * Registered with IChan::addRecvWaiter / IChan::addSendWaiter. notify()
+     * runs with the channel's internal lock held, so it must be short, must
+     * not throw and must not call back into the channel.
+     */
+    class ChanWaiter {
+    public:
+        virtual void notify() noexcept = 0;
+
+    protected:
+        ~ChanWaiter() = default;
+    };
+
+    namespace detail {
+
+        /// One registered select: either a ChanWaiter or a legacy (cv, ready flag) pair.
+        struct SelectWaiterEntry {
+            gocxx::runtime::CondVar* cv = nullptr;
+            bool* ready = nullptr;
+            ChanWaiter* waiter = nullptr;
+
+            void notify() const {
+                if (waiter) {
+                    waiter->notify();
+                    return;
+                }
+                if (ready) *ready = true;
+                if (cv) cv->notify_one();
+            }
+        };
+
+        using SelectWaiters = std::vector<SelectWaiterEntry>;
+
+        inline void notifyAll(const SelectWaiters& waiters) {
+            for (const auto& entry : waiters) entry.notify();
+        }
+
+        /**
+         * @brief Fixed-capacity FIFO used as ChanImpl's buffer
+         *
+         * Storage is allocated on the first push, so channels that are
+         * created but never used (e.g. timer channels) stay small.
+         */
+        template<typename T>
+        class BoundedQueue {
+        public:
+            explicit BoundedQueue(std::size_t capacity) : capacity_(capacity) {}
+
+            bool empty() const { return size_ == 0; }
+            std::size_t size() const { return size_; }
+
+            void push(T&& value) {
+                if (!slots_) slots_ = std::make_unique<std::optional<T>[]>(capacity_);
+                std::size_t tail = head_ + size_;
+                if (tail >= capacity_) tail -= capacity_;
+                slots_[tail].emplace(std::move(value));
+                ++size_;
+            }
+
+            T& front() { return *slots_[head_]; }
+
+            void pop() {
+                slots_[head_].reset();
+                if (++head_ == capacity_) head_ = 0;
+                --size_;
+            }
+
+        private:
+            std::size_t capacity_;
+            std::size_t head_ = 0;
+            std::size_t size_ = 0;
+            std::unique_ptr<std::optional<T>[]> slots_;
+        };
+
+        /// Remove every entry matching @p pred; returns how many were removed.
+        template<typename Pred>
+        std::size_t removeWaiters(SelectWaiters& waiters, Pred pred) {
+            auto it = std::remove_if(waiters.begin(), waiters.end(), pred);
+            auto removed = static_cast<std::size_t>(waiters.end() - it);
+            waiters.erase(it, waiters.end());
+            return removed;
+        }
+
+        /// True if [first, last) of @p It is contiguous, mutable storage of T, sendable in place.
+        template<typename It, typename T>
+        constexpr bool isInPlaceRange() {
+            if constexpr (!std::is_same_v<typename std::iterator_traits<It>::reference, T&>) {
+                return false;
+            } else {
+#if __cplusplus >= 202002L
+                return std::contiguous_iterator<It>;
+#else
+                return std::is_same_v<It, T*> || std::is_same_v<It, typename std::vector<T>::iterator>;
+#endif
+            }
+        }
+
+    } // namespace detail
+
     /**
      * @interface IChan
      * @brief Interface for channel operations
@@ -62,7 +167,7 @@ namespace base {
         
         /**
          * @brief Try to send a value without blocking
-         * @param value The value to send
+         * @param value The value to send; left untouched if the send fails
          * @return Result indicating success or failure reason
          */
         virtual Result<void> trySend(T&& value) = 0;
@@ -72,6 +177,41 @@ namespace base {
          * @return Result containing the value or error
          */
         virtual Result<T> tryRecv() = 0;
+
+        /**
+         * @brief Send a batch of values in order (blocking)
+         * @param values Values to send; each one is moved from once sent
+         * @param count Number of values
+         * @throws std::runtime_error if the channel is closed before all values are sent
+         *
+         * Implementations move as many values as fit per lock acquisition or
+         * slot claim and wake receivers once per round instead of per value.
+         */
+        virtual void sendBatch(T* values, std::size_t count) = 0;
+
+        /**
+         * @brief Send as many leading values as fit without blocking
+         * @param values Values to send; the sent prefix is moved from
+         * @param count Number of values
+         * @return Number of values sent (0 if full or closed)
+         */
+        virtual std::size_t trySendBatch(T* values, std::size_t count) = 0;
+
+        /**
+         * @brief Receive up to @p max values (blocking until at least one is available)
+         * @param out Vector the received values are appended to
+         * @param max Maximum number of values to receive
+         * @return Number of values appended; 0 means the channel is closed and drained
+         */
+        virtual std::size_t recvBatch(std::vector<T>& out, std::size_t max) = 0;
+
+        /**
+         * @brief Receive up to @p max values without blocking
+         * @param out Vector the received values are appended to
+         * @param max Maximum number of values to receive
+         * @return Number of values appended (0 if empty)
+         */
+        virtual std::size_t tryRecvBatch(std::vector<T>& out, std::size_t max) = 0;
         
         /**
          * @brief Close the channel
@@ -90,22 +230,46 @@ namespace base {
         /**
          * @brief Register a condition variable for receive waiting (internal use)
          */
-        virtual void registerRecvWaiter(std::condition_variable* cv, bool* ready) = 0;
+        virtual void registerRecvWaiter(gocxx::runtime::CondVar* cv, bool* ready) = 0;
         
         /**
          * @brief Unregister a condition variable for receive waiting (internal use)
          */
-        virtual void unregisterRecvWaiter(std::condition_variable* cv) = 0;
+        virtual void unregisterRecvWaiter(gocxx::runtime::CondVar* cv) = 0;
         
         /**
          * @brief Register a condition variable for send waiting (internal use)
          */
-        virtual void registerSendWaiter(std::condition_variable* cv, bool* ready) = 0;
+        virtual void registerSendWaiter(gocxx::runtime::CondVar* cv, bool* ready) = 0;
         
         /**
          * @brief Unregister a condition variable for send waiting (internal use)
          */
-        virtual void unregisterSendWaiter(std::condition_variable* cv) = 0;
+        virtual void unregisterSendWaiter(gocxx::runtime::CondVar* cv) = 0;
+
+        /**
+         * @brief Call @p waiter->notify() whenever a receive may have become possible
+         *
+         * Unlike the condition variable registration, the waiter is told
+         * about every state change under the channel lock, so a select that
+         * registers first and then polls cannot miss a wakeup.
+         */
+        virtual void addRecvWaiter(ChanWaiter* waiter) = 0;
+
+        /**
+         * @brief Stop notifying @p waiter about receive readiness
+         */
+        virtual void removeRecvWaiter(ChanWaiter* waiter) = 0;
+
+        /**
+         * @brief Call @p waiter->notify() whenever a send may have become possible
+         */
+        virtual void addSendWaiter(ChanWaiter* waiter) = 0;
+
+        /**
+         * @brief Stop notifying @p waiter about send readiness
+         */
+        virtual void removeSendWaiter(ChanWaiter* waiter) = 0;
         
         /**
          * @brief Check if the channel can accept a send operation
@@ -118,15 +282,31 @@ namespace base {
          * @return true if receive won't block, false otherwise
          */
         virtual bool canRecv() const = 0;
+
+        /**
+         * @brief How blocking operations on this channel resolved so far
+         * @return Spin/yield/park counts; all zero for implementations that do not track them
+         */
+        virtual gocxx::sync::WaitCounts waitStats() const { return {}; }
         
         virtual ~IChan() = default;
     };
 
+    /**
+     * @brief Mutex-based channel implementation
+     * @tparam T The type of data transmitted through the channel
+     *
+     * Serializes every operation through a single mutex and two condition
+     * variables. Chan<T> uses it for unbuffered (rendezvous) and single-slot
+     * channels; larger buffered channels use RingChanImpl.
+     */
     template<typename T>
     class ChanImpl : public IChan<T> {
     public:
-        explicit ChanImpl(std::size_t bufferSize)
-            : bufferSize_(bufferSize), closed_(false) {}
+        explicit ChanImpl(std::size_t bufferSize,
+                          gocxx::sync::WaitPolicy wait = gocxx::sync::WaitPolicy())
+            : bufferSize_(bufferSize), closed_(false), cond_recv_(wait), cond_send_(wait),
+              queue_(bufferSize) {}
 
         void send(T&& value) override {
             gocxx::sync::UniqueLock lock(mutex_);
@@ -183,6 +363,7 @@ namespace base {
                     sendValue_.reset();
                     hasSendValue_ = false;
                     cond_send_.NotifyOne(); // Wake up the sender
+                    notifySelectWaiters(sendWaiters_);
                     return val;
                 }
                 
@@ -200,6 +381,7 @@ namespace base {
                 auto val = std::move(queue_.front());
                 queue_.pop();
                 cond_send_.NotifyOne(); // Wake up any waiting senders
+                notifySelectWaiters(sendWaiters_);
                 return val;
             }
         }
@@ -251,6 +433,7 @@ namespace base {
                 sendValue_.reset();
                 hasSendValue_ = false;
                 cond_send_.NotifyOne();
+                notifySelectWaiters(sendWaiters_);
                 return Result<T>(std::move(val));
             } else {
                 // Buffered channel
@@ -264,10 +447,84 @@ namespace base {
                 auto val = std::move(queue_.front());
                 queue_.pop();
                 cond_send_.NotifyOne();
+                notifySelectWaiters(sendWaiters_);
                 return Result<T>(std::move(val));
             }
         }
 
+        void sendBatch(T* values, std::size_t count) override {
+            if (bufferSize_ == 0) {
+                // Rendezvous channels hand over one value per receiver
+                for (std::size_t i = 0; i < count; ++i) {
+                    send(std::move(values[i]));
+                }
+                return;
+            }
+
+            gocxx::sync::UniqueLock lock(mutex_);
+            std::size_t sent = 0;
+            while (sent < count) {
+                while (!closed_ && queue_.size() >= bufferSize_) {
+                    cond_send_.Wait(lock);
+                }
+                if (closed_) {
+                    throw std::runtime_error("send on closed channel");
+                }
+
+                std::size_t n = std::min(count - sent, bufferSize_ - queue_.size());
+                for (std::size_t i = 0; i < n; ++i) {
+                    queue_.push(std::move(values[sent + i]));
+                }
+                sent += n;
+                notifyRecv(n);
+            }
+        }
+
+        std::size_t trySendBatch(T* values, std::size_t count) override {
+            if (bufferSize_ == 0) {
+                return (count > 0 && trySend(std::move(values[0])).Ok()) ? 1 : 0;
+            }
+
+            gocxx::sync::Lock lock(mutex_);
+            if (closed_) return 0;
+
+            std::size_t n = std::min(count, bufferSize_ - queue_.size());
+            for (std::size_t i = 0; i < n; ++i) {
+                queue_.push(std::move(values[i]));
+            }
+            if (n > 0) notifyRecv(n);
+            return n;
+        }
+
+        std::size_t recvBatch(std::vector<T>& out, std::size_t max) override {
+            if (max == 0) return 0;
+            if (bufferSize_ == 0) {
+                auto val = recv();
+                if (!val) return 0;
+                out.push_back(std::move(*val));
+                return 1;
+            }
+
+            gocxx::sync::UniqueLock lock(mutex_);
+            while (!closed_ && queue_.empty()) {
+                cond_recv_.Wait(lock);
+            }
+            return drainLocked(out, max);
+        }
+
+        std::size_t tryRecvBatch(std::vector<T>& out, std::size_t max) override {
+            if (max == 0) return 0;
+            if (bufferSize_ == 0) {
+                auto res = tryRecv();
+                if (!res.Ok()) return 0;
+                out.push_back(std::move(res.value));
+                return 1;
+            }
+
+            gocxx::sync::Lock lock(mutex_);
+            return drainLocked(out, max);
+        }
+
         void close() override {
             gocxx::sync::Lock lock(mutex_);
             if (closed_) return;  // Already closed
@@ -286,36 +543,52 @@ namespace base {
             return closed_;
         }
 
-        void registerRecvWaiter(std::condition_variable* cv, bool* ready) override {
+        void registerRecvWaiter(gocxx::runtime::CondVar* cv, bool* ready) override {
             if (!cv) return;
             gocxx::sync::Lock lock(mutex_);
-            recvWaiters_.emplace_back(cv, ready);
+            recvWaiters_.push_back({cv, ready, nullptr});
         }
 
-        void unregisterRecvWaiter(std::condition_variable* cv) override {
+        void unregisterRecvWaiter(gocxx::runtime::CondVar* cv) override {
             if (!cv) return;
             gocxx::sync::Lock lock(mutex_);
-            recvWaiters_.erase(
-                std::remove_if(recvWaiters_.begin(), recvWaiters_.end(),
-                    [cv](const auto& pair) { return pair.first == cv; }),
-                recvWaiters_.end()
-            );
+            detail::removeWaiters(recvWaiters_, [cv](const auto& e) { return e.cv == cv; });
         }
 
-        void registerSendWaiter(std::condition_variable* cv, bool* ready) override {
+        void registerSendWaiter(gocxx::runtime::CondVar* cv, bool* ready) override {
             if (!cv) return;
             gocxx::sync::Lock lock(mutex_);
-            sendWaiters_.emplace_back(cv, ready);
+            sendWaiters_.push_back({cv, ready, nullptr});
         }
 
-        void unregisterSendWaiter(std::condition_variable* cv) override {
+        void unregisterSendWaiter(gocxx::runtime::CondVar* cv) override {
             if (!cv) return;
             gocxx::sync::Lock lock(mutex_);
-            sendWaiters_.erase(
-                std::remove_if(sendWaiters_.begin(), sendWaiters_.end(),
-                    [cv](const auto& pair) { return pair.first == cv; }),
-                sendWaiters_.end()
-            );
+            detail::removeWaiters(sendWaiters_, [cv](const auto& e) { return e.cv == cv; });
+        }
+
+        void addRecvWaiter(ChanWaiter* waiter) override {
+            if (!waiter) return;
+            gocxx::sync::Lock lock(mutex_);
+            recvWaiters_.push_back({nullptr, nullptr, waiter});
+        }
+
+        void removeRecvWaiter(ChanWaiter* waiter) override {
+            if (!waiter) return;
+            gocxx::sync::Lock lock(mutex_);
+            detail::removeWaiters(recvWaiters_, [waiter](const auto& e) { return e.waiter == waiter; });
+        }
+
+        void addSendWaiter(ChanWaiter* waiter) override {
+            if (!waiter) return;
+            gocxx::sync::Lock lock(mutex_);
+            sendWaiters_.push_back({nullptr, nullptr, waiter});
+        }
+
+        void removeSendWaiter(ChanWaiter* waiter) override {
+            if (!waiter) return;
+            gocxx::sync::Lock lock(mutex_);
+            detail::removeWaiters(sendWaiters_, [waiter](const auto& e) { return e.waiter == waiter; });
         }
 
         bool canSend() const override {
@@ -342,12 +615,41 @@ namespace base {
             }
         }
 
+        gocxx::sync::WaitCounts waitStats() const override {
+            gocxx::sync::WaitCounts counts = cond_recv_.Stats();
+            counts += cond_send_.Stats();
+            return counts;
+        }
+
     private:
-        void notifySelectWaiters(const std::vector<std::pair<std::condition_variable*, bool*>>& waiters) {
-            for (const auto& [cv, ready] : waiters) {
-                if (ready) *ready = true;
-                if (cv) cv->notify_one();
+        void notifySelectWaiters(const detail::SelectWaiters& waiters) {
+            detail::notifyAll(waiters);
+        }
+
+        // Wake receivers for n newly queued values; caller holds mutex_.
+        void notifyRecv(std::size_t n) {
+            if (n == 1) {
+                cond_recv_.NotifyOne();
+            } else {
+                cond_recv_.NotifyAll();
             }
+            notifySelectWaiters(recvWaiters_);
+        }
+
+        // Move up to max queued values into out; caller holds mutex_.
+        std::size_t drainLocked(std::vector<T>& out, std::size_t max) {
+            std::size_t n = std::min(max, queue_.size());
+            for (std::size_t i = 0; i < n; ++i) {
+                out.push_back(std::move(queue_.front()));
+                queue_.pop();
+            }
+            if (n == 1) {
+                cond_send_.NotifyOne();
+            } else if (n > 1) {
+                cond_send_.NotifyAll();
+            }
+            if (n > 0) notifySelectWaiters(sendWaiters_);
+            return n;
         }
 
         std::size_t bufferSize_;
@@ -361,13 +663,855 @@ namespace base {
         bool hasSendValue_ = false;
 
         // Buffered channel state
-        std::queue<T> queue_;
+        detail::BoundedQueue<T> queue_;
 
         // Select statement waiters
-        std::vector<std::pair<std::condition_variable*, bool*>> recvWaiters_;
-        std::vector<std::pair<std::condition_variable*, bool*>> sendWaiters_;
+        detail::SelectWaiters recvWaiters_;
+        detail::SelectWaiters sendWaiters_;
+    };
+
+    namespace detail {
+
+        /// Assumed cache line size, used to keep producer and consumer state apart
+        inline constexpr std::size_t cacheLineSize = 64;
+
+        /**
+         * @brief Parking and wakeup bookkeeping for the lock-free channel engines
+         *
+         * The engines move data without locks and only come here when a caller
+         * must block, when a blocked caller or select statement must be woken,
+         * or on close. Each direction keeps a count of parked threads plus
+         * registered selects, so wake() is a single load when nobody waits.
+         *
+         * Engines publish data with a seq_cst store before calling wake(); a
+         * parking thread bumps the count and fences before re-checking, so
+         * one side always sees the other and no wakeup is lost.
+         *
+         * Senders hold a Sending scope while they enqueue. close() does not
+         * wait for them; instead receivers treat the channel as closed only
+         * once isDrained(), so a send that raced the close is either rejected
+         * or delivered before any receiver reports the end.
+         */
+        class ChanParker {
+        public:
+            /// Direction a caller waits in: receivers wait for data, senders for room.
+            enum Side { Recv = 0, Send = 1 };
+
+            explicit ChanParker(gocxx::sync::WaitPolicy policy) : policy_(policy) {}
+
+            /**
+             * @brief Block until @p attempt returns true
+             *
+             * @p attempt is first retried lock-free for the spin and yield
+             * phases of the wait policy, then re-run under the park mutex after
+             * every wakeup. It returns true once the operation completed or the
+             * caller should stop waiting (e.g. the channel closed) and must not
+             * throw.
+             */
+            template<typename Attempt>
+            void park(Side side, Attempt&& attempt) {
+                gocxx::sync::WaitPhase phase = gocxx::sync::SpinWait(policy_, attempt);
+                stats_.Record(phase);
+                if (phase != gocxx::sync::WaitPhase::Park) return;
+
+                gocxx::sync::UniqueLock lock(mutex_);
+                waiting_[side].fetch_add(1, std::memory_order_seq_cst);
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                while (!attempt()) {
+                    conds_[side].Wait(lock);
+                }
+                waiting_[side].fetch_sub(1, std::memory_order_relaxed);
+            }
+
+            /// Wake one parked caller and every select waiting on @p side.
+            void wake(Side side) {
+                if (waiting_[side].load(std::memory_order_seq_cst) == 0) return;
+                gocxx::sync::Lock lock(mutex_);
+                conds_[side].NotifyOne();
+                notifySelectWaiters(selects_[side]);
+            }
+
+            /**
+             * @brief Wake up to @p n parked callers on @p side under one lock
+             *
+             * Used after a batch made @p n values (or slots) available.
+             * Engines that publish a batch with release stores must issue a
+             * seq_cst fence before calling this.
+             */
+            void wake(Side side, std::size_t n) {
+                if (n == 0) return;
+                std::size_t waiting = waiting_[side].load(std::memory_order_seq_cst);
+                if (waiting == 0) return;
+                gocxx::sync::Lock lock(mutex_);
+                if (n >= waiting) {
+                    conds_[side].NotifyAll();
+                } else {
+                    for (std::size_t i = 0; i < n; ++i) conds_[side].NotifyOne();
+                }
+                notifySelectWaiters(selects_[side]);
+            }
+
+            /**
+             * @brief A sender's claim on the channel, taken before checking closed
+             *
+             * Converts to false if the channel was already closed; the send
+             * must then be rejected. Releasing the last claim after a close
+             * wakes the receivers so they can see the end.
+             */
+            class Sending {
+            public:
+                explicit Sending(ChanParker& parker) : parker_(parker) {
+                    parker_.senders_.fetch_add(1, std::memory_order_seq_cst);
+                    open_ = !parker_.closed_.load(std::memory_order_seq_cst);
+                }
+
+                ~Sending() { parker_.endSend(); }
+
+                Sending(const Sending&) = delete;
+                Sending& operator=(const Sending&) = delete;
+
+                explicit operator bool() const { return open_; }
+
+            private:
+                ChanParker& parker_;
+                bool open_;
+            };
+
+            /// Mark closed and wake everyone; returns false if already closed.
+            bool close() {
+                gocxx::sync::Lock lock(mutex_);
+                if (closed_.exchange(true, std::memory_order_seq_cst)) return false;
+                conds_[Recv].NotifyAll();
+                conds_[Send].NotifyAll();
+                notifySelectWaiters(selects_[Recv]);
+                notifySelectWaiters(selects_[Send]);
+                return true;
+            }
+
+            bool isClosed() const {
+                return closed_.load(std::memory_order_acquire);
+            }
+
+            /**
+             * @brief Closed, and no send that raced the close can still land
+             *
+             * A send may have completed between a failed dequeue and this
+             * call, so receivers dequeue once more before reporting the end.
+             */
+            bool isDrained() const {
+                return closed_.load(std::memory_order_seq_cst) &&
+                       senders_.load(std::memory_order_seq_cst) == 0;
+            }
+
+            gocxx::sync::WaitCounts stats() const {
+                return stats_.Snapshot();
+            }
+
+            void registerSelect(Side side, SelectWaiterEntry entry) {
+                gocxx::sync::Lock lock(mutex_);
+                selects_[side].push_back(entry);
+                waiting_[side].fetch_add(1, std::memory_order_seq_cst);
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+            }
+
+            template<typename Pred>
+            void unregisterSelect(Side side, Pred pred) {
+                gocxx::sync::Lock lock(mutex_);
+                std::size_t removed = removeWaiters(selects_[side], pred);
+                waiting_[side].fetch_sub(removed, std::memory_order_relaxed);
+            }
+
+        private:
+            static void notifySelectWaiters(const SelectWaiters& waiters) {
+                notifyAll(waiters);
+            }
+
+            void endSend() {
+                if (senders_.fetch_sub(1, std::memory_order_seq_cst) != 1) return;
+                if (!closed_.load(std::memory_order_seq_cst)) return;
+                // Receivers that saw this send in flight are waiting for the end
+                gocxx::sync::Lock lock(mutex_);
+                conds_[Recv].NotifyAll();
+                notifySelectWaiters(selects_[Recv]);
+            }
+
+            std::atomic<std::size_t> waiting_[2] = {};
+            std::atomic<std::size_t> senders_{0};  // Senders inside a Sending scope
+            std::atomic<bool> closed_{false};
+
+            gocxx::sync::WaitPolicy policy_;
+            gocxx::sync::WaitStats stats_;
+
+            gocxx::sync::Mutex mutex_;
+            // park() already spun, so the conds block straight away
+            gocxx::sync::Cond conds_[2] = {gocxx::sync::Cond(gocxx::sync::WaitPolicy::Block()),
+                                           gocxx::sync::Cond(gocxx::sync::WaitPolicy::Block())};
+            SelectWaiters selects_[2];
+        };
+
+        /**
+         * @brief IChan on top of a non-blocking ring engine
+         *
+         * Implements the blocking, try, batch and select parts of IChan once
+         * for the lock-free engines. @p Engine supplies the data movement:
+         *
+         * - bool tryEnqueue(T&) / bool tryDequeue(std::optional<T>&)
+         * - std::size_t enqueueBulk(T*, std::size_t) /
+         *   std::size_t dequeueBulk(std::vector<T>&, std::size_t)
+         * - bool hasRoom() const / bool hasData() const
+         *
+         * Single-value operations publish with a seq_cst store; bulk ones use
+         * release stores and this class fences once before waking.
+         */
+        template<typename T, typename Engine>
+        class LockFreeChan : public IChan<T> {
+            using Parker = ChanParker;
+
+        public:
+            void send(T&& value) override {
+                Parker::Sending sending(parker_);
+                if (!sending) {
+                    throw std::runtime_error("send on closed channel");
+                }
+                if (!engine().tryEnqueue(value)) {
+                    bool closed = false;
+                    parker_.park(Parker::Send, [&] {
+                        closed = parker_.isClosed();
+                        return closed || engine().tryEnqueue(value);
+                    });
+                    if (closed) {
+                        throw std::runtime_error("send on closed channel");
+                    }
+                }
+                parker_.wake(Parker::Recv);
+            }
+
+            std::optional<T> recv() override {
+                std::optional<T> out;
+                if (!engine().tryDequeue(out)) {
+                    parker_.park(Parker::Recv, [&] { return dequeueOrDrained(out); });
+                    if (!out) return std::nullopt;
+                }
+                parker_.wake(Parker::Send);
+                return out;
+            }
+
+            Result<void> trySend(T&& value) override {
+                Parker::Sending sending(parker_);
+                if (!sending) {
+                    return Result<void>(gocxx::errors::New("trySend on closed channel"));
+                }
+                if (!engine().tryEnqueue(value)) {
+                    return Result<void>(gocxx::errors::New("buffer full"));
+                }
+                parker_.wake(Parker::Recv);
+                return Result<void>();
+            }
+
+            Result<T> tryRecv() override {
+                std::optional<T> out;
+                if (!dequeueOrDrained(out)) {
+                    return Result<T>(gocxx::errors::New("buffer empty"));
+                }
+                if (!out) {
+                    return Result<T>(gocxx::errors::New("channel closed"));
+                }
+                parker_.wake(Parker::Send);
+                return Result<T>(std::move(*out));
+            }
+
+            void sendBatch(T* values, std::size_t count) override {
+                Parker::Sending sending(parker_);
+                if (!sending) {
+                    throw std::runtime_error("send on closed channel");
+                }
+                std::size_t sent = 0;
+                while (sent < count) {
+                    std::size_t n = engine().enqueueBulk(values + sent, count - sent);
+                    if (n == 0) {
+                        bool closed = false;
+                        parker_.park(Parker::Send, [&] {
+                            closed = parker_.isClosed();
+                            return closed || (n = engine().enqueueBulk(values + sent, count - sent)) > 0;
+                        });
+                        if (closed) {
+                            throw std::runtime_error("send on closed channel");
+                        }
+                    }
+                    sent += n;
+                    std::atomic_thread_fence(std::memory_order_seq_cst);
+                    parker_.wake(Parker::Recv, n);
+                }
+            }
+
+            std::size_t trySendBatch(T* values, std::size_t count) override {
+                Parker::Sending sending(parker_);
+                if (!sending) return 0;
+                std::size_t n = engine().enqueueBulk(values, count);
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                parker_.wake(Parker::Recv, n);
+                return n;
+            }
+
+            std::size_t recvBatch(std::vector<T>& out, std::size_t max) override {
+                if (max == 0) return 0;
+                std::size_t n = engine().dequeueBulk(out, max);
+                if (n == 0) {
+                    parker_.park(Parker::Recv, [&] {
+                        n = engine().dequeueBulk(out, max);
+                        if (n > 0) return true;
+                        if (!parker_.isDrained()) return false;
+                        n = engine().dequeueBulk(out, max);  // See dequeueOrDrained()
+                        return true;
+                    });
+                }
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                parker_.wake(Parker::Send, n);
+                return n;
+            }
+
+            std::size_t tryRecvBatch(std::vector<T>& out, std::size_t max) override {
+                std::size_t n = engine().dequeueBulk(out, max);
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                parker_.wake(Parker::Send, n);
+                return n;
+            }
+
+            void close() override {
+                parker_.close();
+            }
+
+            /// True once closed and every send that raced the close has landed
+            bool isClosed() const override {
+                return parker_.isDrained();
+            }
+
+            void registerRecvWaiter(gocxx::runtime::CondVar* cv, bool* ready) override {
+                if (!cv) return;
+                parker_.registerSelect(Parker::Recv, {cv, ready, nullptr});
+            }
+
+            void unregisterRecvWaiter(gocxx::runtime::CondVar* cv) override {
+                if (!cv) return;
+                parker_.unregisterSelect(Parker::Recv, [cv](const auto& e) { return e.cv == cv; });
+            }
+
+            void addRecvWaiter(ChanWaiter* waiter) override {
+                if (!waiter) return;
+                parker_.registerSelect(Parker::Recv, {nullptr, nullptr, waiter});
+            }
+
+            void removeRecvWaiter(ChanWaiter* waiter) override {
+                if (!waiter) return;
+                parker_.unregisterSelect(Parker::Recv, [waiter](const auto& e) { return e.waiter == waiter; });
+            }
+
+            void registerSendWaiter(gocxx::runtime::CondVar* cv, bool* ready) override {
+                if (!cv) return;
+                parker_.registerSelect(Parker::Send, {cv, ready, nullptr});
+            }
+
+            void unregisterSendWaiter(gocxx::runtime::CondVar* cv) override {
+                if (!cv) return;
+                parker_.unregisterSelect(Parker::Send, [cv](const auto& e) { return e.cv == cv; });
+            }
+
+            void addSendWaiter(ChanWaiter* waiter) override {
+                if (!waiter) return;
+                parker_.registerSelect(Parker::Send, {nullptr, nullptr, waiter});
+            }
+
+            void removeSendWaiter(ChanWaiter* waiter) override {
+                if (!waiter) return;
+                parker_.unregisterSelect(Parker::Send, [waiter](const auto& e) { return e.waiter == waiter; });
+            }
+
+            bool canSend() const override {
+                return !parker_.isClosed() && engine().hasRoom();
+            }
+
+            bool canRecv() const override {
+                return engine().hasData() || parker_.isDrained();
+            }
+
+            gocxx::sync::WaitCounts waitStats() const override {
+                return parker_.stats();
+            }
+
+        protected:
+            explicit LockFreeChan(gocxx::sync::WaitPolicy wait) : parker_(wait) {}
+
+        private:
+            /**
+             * @brief Dequeue into @p out; false only if it is empty and may still get a value
+             *
+             * Returns true with @p out empty once the channel is drained. A
+             * send can land between a failed dequeue and isDrained(), so the
+             * dequeue is retried once before reporting the end.
+             */
+            bool dequeueOrDrained(std::optional<T>& out) {
+                if (engine().tryDequeue(out)) return true;
+                if (!parker_.isDrained()) return false;
+                engine().tryDequeue(out);
+                return true;
+            }
+
+            Engine& engine() { return static_cast<Engine&>(*this); }
+            const Engine& engine() const { return static_cast<const Engine&>(*this); }
+
+            mutable Parker parker_;
+        };
+
+    } // namespace detail
+
+    /**
+     * @brief Lock-free buffered channel implementation
+     * @tparam T The type of data transmitted through the channel
+     *
+     * A bounded multi-producer/multi-consumer ring with a sequence number per
+     * slot (Vyukov's algorithm). Senders and receivers claim slots with a
+     * single CAS on their own cache line, so a lock is only taken when the
+     * ring is full or empty and a caller has to park, or when a parked
+     * thread or a select statement must be woken. Batch operations claim a
+     * run of consecutive slots with one CAS.
+     *
+     * The ring holds exactly @p bufferSize elements. Power-of-two sizes map
+     * positions to slots with a mask, other sizes fall back to a modulo. The
+     * sequence scheme needs at least two slots to tell a full slot from one
+     * freed for the next lap, so single-slot channels stay on ChanImpl.
+     */
+    template<typename T>
+    class RingChanImpl : public detail::LockFreeChan<T, RingChanImpl<T>> {
+        friend class detail::LockFreeChan<T, RingChanImpl<T>>;
+
+    public:
+        explicit RingChanImpl(std::size_t bufferSize,
+                              gocxx::sync::WaitPolicy wait = gocxx::sync::WaitPolicy())
+            : detail::LockFreeChan<T, RingChanImpl<T>>(wait),
+              capacity_(bufferSize),
+              mask_((bufferSize & (bufferSize - 1)) == 0 ? bufferSize - 1 : 0),
+              slots_(std::make_unique<Slot[]>(bufferSize)) {
+            if (bufferSize < 2) {
+                throw std::invalid_argument("RingChanImpl requires a buffer size of at least 2");
+            }
+            for (std::size_t i = 0; i < capacity_; ++i) {
+                slots_[i].seq.store(i, std::memory_order_relaxed);
+            }
+        }
+
+        ~RingChanImpl() override {
+            std::optional<T> discard;
+            while (tryDequeue(discard)) {
+                discard.reset();
+            }
+        }
+
+        RingChanImpl(const RingChanImpl&) = delete;
+        RingChanImpl& operator=(const RingChanImpl&) = delete;
+
+    private:
+        struct Slot {
+            std::atomic<std::size_t> seq{0};
+            alignas(T) unsigned char storage[sizeof(T)];
+
+            T* value() { return std::launder(reinterpret_cast<T*>(storage)); }
+        };
+
+        std::size_t index(std::size_t pos) const {
+            return mask_ ? (pos & mask_) : pos % capacity_;
+        }
+
+        // Claim up to max consecutive slots whose sequence equals pos + i + offset.
+        // Returns the number claimed (0 = none available) and sets pos to the first.
+        std::size_t claim(std::atomic<std::size_t>& cursor, std::size_t& pos,
+                          std::size_t max, std::size_t offset) {
+            pos = cursor.load(std::memory_order_relaxed);
+            max = std::min(max, capacity_);
+            while (true) {
+                std::size_t n = 0;
+                std::intptr_t diff = 0;
+                while (n < max) {
+                    std::size_t seq = slots_[index(pos + n)].seq.load(std::memory_order_acquire);
+                    diff = static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos + n + offset);
+                    if (diff != 0) break;
+                    ++n;
+                }
+                if (n == 0) {
+                    if (diff < 0) return 0;  // Full (enqueue) or empty (dequeue)
+                    pos = cursor.load(std::memory_order_relaxed);
+                    continue;
+                }
+                if (cursor.compare_exchange_weak(pos, pos + n, std::memory_order_relaxed)) {
+                    return n;
+                }
+            }
+        }
+
+        // Moves from value only when a slot was claimed.
+        bool tryEnqueue(T& value) {
+            std::size_t pos;
+            if (claim(enqueuePos_, pos, 1, 0) == 0) return false;
+            Slot& slot = slots_[index(pos)];
+            new (slot.storage) T(std::move(value));
+            slot.seq.store(pos + 1, std::memory_order_seq_cst);  // Pairs with ChanParker::park
+            return true;
+        }
+
+        bool tryDequeue(std::optional<T>& out) {
+            std::size_t pos;
+            if (claim(dequeuePos_, pos, 1, 1) == 0) return false;
+            Slot& slot = slots_[index(pos)];
+            out.emplace(std::move(*slot.value()));
+            slot.value()->~T();
+            slot.seq.store(pos + capacity_, std::memory_order_seq_cst);  // Pairs with ChanParker::park
+            return true;
+        }
+
+        std::size_t enqueueBulk(T* values, std::size_t count) {
+            std::size_t pos;
+            std::size_t n = claim(enqueuePos_, pos, count, 0);
+            for (std::size_t i = 0; i < n; ++i) {
+                Slot& slot = slots_[index(pos + i)];
+                new (slot.storage) T(std::move(values[i]));
+                slot.seq.store(pos + i + 1, std::memory_order_release);
+            }
+            return n;
+        }
+
+        std::size_t dequeueBulk(std::vector<T>& out, std::size_t max) {
+            std::size_t pos;
+            std::size_t n = claim(dequeuePos_, pos, max, 1);
+            for (std::size_t i = 0; i < n; ++i) {
+                Slot& slot = slots_[index(pos + i)];
+                out.push_back(std::move(*slot.value()));
+                slot.value()->~T();
+                slot.seq.store(pos + i + capacity_, std::memory_order_release);
+            }
+            return n;
+        }
+
+        bool hasRoom() const {
+            std::size_t pos = enqueuePos_.load(std::memory_order_relaxed);
+            return slots_[index(pos)].seq.load(std::memory_order_acquire) == pos;
+        }
+
+        bool hasData() const {
+            std::size_t pos = dequeuePos_.load(std::memory_order_relaxed);
+            return slots_[index(pos)].seq.load(std::memory_order_acquire) == pos + 1;
+        }
+
+        const std::size_t capacity_;
+        const std::size_t mask_;
+        std::unique_ptr<Slot[]> slots_;
+
+        alignas(detail::cacheLineSize) std::atomic<std::size_t> enqueuePos_{0};
+        alignas(detail::cacheLineSize) std::atomic<std::size_t> dequeuePos_{0};
     };
 
+    /**
+     * @brief Single-producer/single-consumer channel implementation
+     * @tparam T The type of data transmitted through the channel
+     *
+     * A bounded ring where the producer owns the tail index and the consumer
+     * owns the head index, each on its own cache line together with a cached
+     * copy of the other side's index. A send or receive that does not have to
+     * wait is a handful of plain loads and one store, with no CAS and no lock;
+     * a batch publishes all of its values with a single index store.
+     *
+     * Only one thread may send and only one thread may receive at a time
+     * (select cases count as the sender or receiver they run on). Create it
+     * through Chan with ChanOptions::spsc set.
+     */
+    template<typename T>
+    class SpscChanImpl : public detail::LockFreeChan<T, SpscChanImpl<T>> {
+        friend class detail::LockFreeChan<T, SpscChanImpl<T>>;
+
+    public:
+        explicit SpscChanImpl(std::size_t bufferSize,
+                              gocxx::sync::WaitPolicy wait = gocxx::sync::WaitPolicy())
+            : detail::LockFreeChan<T, SpscChanImpl<T>>(wait),
+              capacity_(bufferSize),
+              mask_((bufferSize & (bufferSize - 1)) == 0 ? bufferSize - 1 : 0),
+              slots_(std::make_unique<Slot[]>(bufferSize)) {
+            if (bufferSize == 0) {
+                throw std::invalid_argument("SpscChanImpl requires a non-zero buffer size");
+            }
+        }
+
+        ~SpscChanImpl() override {
+            std::optional<T> discard;
+            while (tryDequeue(discard)) {
+                discard.reset();
+            }
+        }
+
+        SpscChanImpl(const SpscChanImpl&) = delete;
+        SpscChanImpl& operator=(const SpscChanImpl&) = delete;
+
+    private:
+        struct Slot {
+            alignas(T) unsigned char storage[sizeof(T)];
+
+            T* value() { return std::launder(reinterpret_cast<T*>(storage)); }
+        };
+
+        std::size_t index(std::size_t pos) const {
+            return mask_ ? (pos & mask_) : pos % capacity_;
+        }
+
+        // Producer side only: free slots, refreshing the cached head if needed.
+        std::size_t freeSlots(std::size_t tail, std::size_t want) {
+            std::size_t free = capacity_ - (tail - producer_.headCache);
+            if (free < want) {
+                producer_.headCache = consumer_.head.load(std::memory_order_acquire);
+                free = capacity_ - (tail - producer_.headCache);
+            }
+            return free;
+        }
+
+        // Consumer side only: queued values, refreshing the cached tail if needed.
+        std::size_t queued(std::size_t head, std::size_t want) {
+            std::size_t avail = consumer_.tailCache - head;
+            if (avail < want) {
+                consumer_.tailCache = producer_.tail.load(std::memory_order_acquire);
+                avail = consumer_.tailCache - head;
+            }
+            return avail;
+        }
+
+        // Moves from value only on success.
+        bool tryEnqueue(T& value) {
+            std::size_t tail = producer_.tail.load(std::memory_order_relaxed);
+            if (freeSlots(tail, 1) == 0) return false;  // Full
+            new (slots_[index(tail)].storage) T(std::move(value));
+            producer_.tail.store(tail + 1, std::memory_order_seq_cst);  // Pairs with ChanParker::park
+            return true;
+        }
+
+        bool tryDequeue(std::optional<T>& out) {
+            std::size_t head = consumer_.head.load(std::memory_order_relaxed);
+            if (queued(head, 1) == 0) return false;  // Empty
+            T* value = slots_[index(head)].value();
+            out.emplace(std::move(*value));
+            value->~T();
+            consumer_.head.store(head + 1, std::memory_order_seq_cst);  // Pairs with ChanParker::park
+            return true;
+        }
+
+        std::size_t enqueueBulk(T* values, std::size_t count) {
+            std::size_t tail = producer_.tail.load(std::memory_order_relaxed);
+            std::size_t n = std::min(count, freeSlots(tail, count));
+            for (std::size_t i = 0; i < n; ++i) {
+                new (slots_[index(tail + i)].storage) T(std::move(values[i]));
+            }
+            if (n > 0) producer_.tail.store(tail + n, std::memory_order_release);
+            return n;
+        }
+
+        std::size_t dequeueBulk(std::vector<T>& out, std::size_t max) {
+            std::size_t head = consumer_.head.load(std::memory_order_relaxed);
+            std::size_t n = std::min(max, queued(head, max));
+            for (std::size_t i = 0; i < n; ++i) {
+                T* value = slots_[index(head + i)].value();
+                out.push_back(std::move(*value));
+                value->~T();
+            }
+            if (n > 0) consumer_.head.store(head + n, std::memory_order_release);
+            return n;
+        }
+
+        bool hasRoom() const {
+            return producer_.tail.load(std::memory_order_relaxed)
+                 - consumer_.head.load(std::memory_order_acquire) < capacity_;
+        }
+
+        bool hasData() const {
+            return consumer_.head.load(std::memory_order_relaxed)
+                != producer_.tail.load(std::memory_order_acquire);
+        }
+
+        struct alignas(detail::cacheLineSize) ProducerState {
+            std::atomic<std::size_t> tail{0};
+            std::size_t headCache = 0;
+        };
+
+        struct alignas(detail::cacheLineSize) ConsumerState {
+            std::atomic<std::size_t> head{0};
+            std::size_t tailCache = 0;
+        };
+
+        const std::size_t capacity_;
+        const std::size_t mask_;
+        std::unique_ptr<Slot[]> slots_;
+
+        ProducerState producer_;
+        ConsumerState consumer_;
+    };
+
+    /**
+     * @brief Construction options for Chan
+     */
+    struct ChanOptions {
+        /**
+         * @brief Promise that at most one thread sends and one thread receives
+         *
+         * Selects SpscChanImpl for buffered channels. Breaking the promise
+         * corrupts the channel. Ignored for unbuffered channels.
+         */
+        bool spsc = false;
+
+        /**
+         * @brief How blocked senders and receivers wait
+         *
+         * Defaults to a short spin, then yield, then park. Use
+         * gocxx::sync::WaitPolicy::Block() to park immediately.
+         */
+        gocxx::sync::WaitPolicy wait;
+    };
+
+#if GOCXX_HAS_COROUTINES
+    namespace detail {
+
+        /**
+         * Common part of the channel awaiters. While suspended the awaiter
+         * sits in the channel's wait list as a ChanWaiter, inside the
+         * coroutine frame, so an await allocates nothing. Each notification
+         * posts it to the executor once; there it polls the channel again
+         * and resumes the coroutine when the operation went through.
+         */
+        template<typename T, typename Op>
+        class ChanAwaiter : public ChanWaiter {
+        public:
+            ChanAwaiter(const ChanAwaiter&) = delete;
+            ChanAwaiter& operator=(const ChanAwaiter&) = delete;
+
+            bool await_ready() {
+                return op().poll();
+            }
+
+            void await_suspend(std::coroutine_handle<> h) {
+                exec_ = &gocxx::runtime::detail::AwaitingExecutor(Op::kName);
+                handle_ = h;
+                pending_.store(true, std::memory_order_relaxed);
+                if constexpr (Op::kRecv) chan_->addRecvWaiter(this); else chan_->addSendWaiter(this);
+                // Poll once more from the executor: a change between
+                // await_ready() and registering is not lost
+                exec_->Post(&step_);
+            }
+
+            void notify() noexcept override {
+                if (!pending_.exchange(true, std::memory_order_acq_rel)) exec_->Post(&step_);
+            }
+
+        protected:
+            explicit ChanAwaiter(std::shared_ptr<IChan<T>> chan) : chan_(std::move(chan)) {
+                step_.run = &ChanAwaiter::step;
+                step_.self = this;
+            }
+
+            std::shared_ptr<IChan<T>> chan_;
+
+        private:
+            /// Queued on the executor; points back at its awaiter
+            struct Step : gocxx::runtime::Executor::Work {
+                ChanAwaiter* self = nullptr;
+            };
+
+            static void step(gocxx::runtime::Executor::Work* work) {
+                ChanAwaiter* self = static_cast<Step*>(work)->self;
+                self->pending_.store(false, std::memory_order_seq_cst);
+                if (self->done_) {
+                    self->handle_.resume();
+                    return;
+                }
+                if (!self->op().poll()) return;  // Lost a race; wait for the next change
+                if constexpr (Op::kRecv) {
+                    self->chan_->removeRecvWaiter(self);
+                } else {
+                    self->chan_->removeSendWaiter(self);
+                }
+                if (self->pending_.exchange(true, std::memory_order_seq_cst)) {
+                    // Notified again before leaving the wait list: resume
+                    // from that queued run, not while it still points here
+                    self->done_ = true;
+                    return;
+                }
+                self->handle_.resume();
+            }
+
+            Op& op() { return static_cast<Op&>(*this); }
+
+            Step step_;
+            gocxx::runtime::Executor* exec_ = nullptr;
+            std::coroutine_handle<> handle_;
+            std::atomic<bool> pending_{false};
+            bool done_ = false;
+        };
+
+        /// Awaiter of Chan::recvAsync().
+        template<typename T>
+        class RecvAwaiter : public ChanAwaiter<T, RecvAwaiter<T>> {
+        public:
+            static constexpr const char* kName = "recvAsync";
+            static constexpr bool kRecv = true;
+
+            explicit RecvAwaiter(std::shared_ptr<IChan<T>> chan)
+                : ChanAwaiter<T, RecvAwaiter<T>>(std::move(chan)) {}
+
+            std::optional<T> await_resume() {
+                return std::move(value_);
+            }
+
+            bool poll() {
+                if (!this->chan_->canRecv()) return false;
+                auto result = this->chan_->tryRecv();
+                if (result.Ok()) {
+                    value_.emplace(std::move(result.value));
+                    return true;
+                }
+                if (!this->chan_->isClosed()) return false;
+                // A value sent just before the close is still delivered
+                auto last = this->chan_->tryRecv();
+                if (last.Ok()) value_.emplace(std::move(last.value));
+                return true;
+            }
+
+        private:
+            std::optional<T> value_;
+        };
+
+        /// Awaiter of Chan::sendAsync().
+        template<typename T>
+        class SendAwaiter : public ChanAwaiter<T, SendAwaiter<T>> {
+        public:
+            static constexpr const char* kName = "sendAsync";
+            static constexpr bool kRecv = false;
+
+            SendAwaiter(std::shared_ptr<IChan<T>> chan, T value)
+                : ChanAwaiter<T, SendAwaiter<T>>(std::move(chan)), value_(std::move(value)) {}
+
+            void await_resume() const {
+                if (closed_) throw std::runtime_error("send on closed channel");
+            }
+
+            bool poll() {
+                if (!this->chan_->canSend()) {
+                    closed_ = this->chan_->isClosed();
+                    return closed_;
+                }
+                if (this->chan_->trySend(std::move(value_)).Ok()) return true;  // Moved from only on success
+                closed_ = this->chan_->isClosed();
+                return closed_;
+            }
+
+        private:
+            T value_;
+            bool closed_ = false;
+        };
+
+    } // namespace detail
+#endif // GOCXX_HAS_COROUTINES
+
     /**
      * @class Chan
      * @brief Thread-safe channel for communication between threads
@@ -381,7 +1525,9 @@ namespace base {
      * Send operations block until a receiver is ready, providing synchronization.
      * 
      * @par Buffered Channels (bufferSize > 0)
-     * Send operations only block when the buffer is full.
+     * Send operations only block when the buffer is full. Channels with two or
+     * more slots are backed by RingChanImpl, so sends and receives that do
+     * not have to wait never take a lock.
      * 
      * @par Example Usage
      * @code
@@ -397,6 +1543,11 @@ namespace base {
      * 
      * // Create a buffered channel
      * Chan<std::string> buffered_ch(5);
+     *
+     * // One reader thread feeding one parser thread
+     * ChanOptions opts;
+     * opts.spsc = true;
+     * Chan<std::string> lines(256, opts);
      * @endcode
      * 
      * @par Thread Safety
@@ -407,7 +1558,22 @@ namespace base {
     class Chan {
     public:
         explicit Chan(std::size_t bufferSize = 0)
-            : impl_(std::make_shared<ChanImpl<T>>(bufferSize)) {}
+            : impl_(makeImpl(bufferSize, ChanOptions{})) {}
+
+        /**
+         * @brief Create a channel with explicit implementation options
+         * @param bufferSize Number of buffered elements (0 = unbuffered)
+         * @param options Implementation choices, see ChanOptions
+         */
+        Chan(std::size_t bufferSize, ChanOptions options)
+            : impl_(makeImpl(bufferSize, options)) {}
+
+        /**
+         * @brief Wrap an existing channel implementation
+         * @param impl The implementation all operations are forwarded to
+         */
+        explicit Chan(std::shared_ptr<IChan<T>> impl)
+            : impl_(std::move(impl)) {}
 
         // Static factory method for Go-like syntax
         static std::shared_ptr<Chan<T>> Make(std::size_t bufferSize = 0) {
@@ -425,7 +1591,7 @@ namespace base {
             impl_->send(std::move(tmp)); 
         }
 
-        std::optional<T> recv() { 
+        std::optional<T> recv() const { 
             return impl_->recv(); 
         }
 
@@ -440,10 +1606,75 @@ namespace base {
             return impl_->trySend(std::move(tmp)); 
         }
 
-        Result<T> tryRecv() { 
+        Result<T> tryRecv() const { 
             return impl_->tryRecv(); 
         }
 
+        /**
+         * @brief Send @p count values in order, moving from each one
+         * @throws std::runtime_error if the channel is closed before all are sent
+         *
+         * Every sendBatch() overload moves from each value it sends and never
+         * copies, so move-only types work with all of them.
+         */
+        void sendBatch(T* values, std::size_t count) {
+            impl_->sendBatch(values, count);
+        }
+
+        /**
+         * @brief Send all values of @p values in order, moving from each one
+         */
+        void sendBatch(std::vector<T>& values) {
+            impl_->sendBatch(values.data(), values.size());
+        }
+
+        /**
+         * @brief Send the range [first, last) in order, moving from each one
+         *
+         * Ranges over contiguous, mutable storage (pointers, std::vector
+         * iterators; any contiguous iterator in C++20) are sent in place.
+         * Other iterators are first moved into a temporary buffer, so they
+         * cost one allocation per call.
+         */
+        template<typename Iterator>
+        void sendBatch(Iterator first, Iterator last) {
+            if constexpr (detail::isInPlaceRange<Iterator, T>()) {
+                if (first == last) return;
+                impl_->sendBatch(std::addressof(*first), static_cast<std::size_t>(last - first));
+            } else {
+                std::vector<T> staged(std::make_move_iterator(first), std::make_move_iterator(last));
+                impl_->sendBatch(staged.data(), staged.size());
+            }
+        }
+
+        /**
+         * @brief Send as many leading values as fit without blocking
+         * @return Number of values sent; only those are moved from
+         */
+        std::size_t trySendBatch(T* values, std::size_t count) {
+            return impl_->trySendBatch(values, count);
+        }
+
+        std::size_t trySendBatch(std::vector<T>& values) {
+            return impl_->trySendBatch(values.data(), values.size());
+        }
+
+        /**
+         * @brief Append up to @p max values to @p out, blocking until at least one arrives
+         * @return Number of values received; 0 means closed and drained
+         */
+        std::size_t recvBatch(std::vector<T>& out, std::size_t max) const {
+            return impl_->recvBatch(out, max);
+        }
+
+        /**
+         * @brief Append up to @p max already-buffered values to @p out
+         * @return Number of values received (0 if none were ready)
+         */
+        std::size_t tryRecvBatch(std::vector<T>& out, std::size_t max) const {
+            return impl_->tryRecvBatch(out, max);
+        }
+
         void close() { 
             impl_->close(); 
         }
@@ -460,11 +1691,53 @@ namespace base {
             return impl_->canRecv(); 
         }
 
+#if GOCXX_HAS_COROUTINES
+        /**
+         * @brief Receive without blocking a thread: `co_await ch.recvAsync()`
+         *
+         * Yields the value, or nullopt once the channel is closed and
+         * drained, like recv(). The coroutine resumes on the Executor it
+         * awaited from.
+         */
+        detail::RecvAwaiter<T> recvAsync() const {
+            return detail::RecvAwaiter<T>(impl_);
+        }
+
+        /**
+         * @brief Send without blocking a thread: `co_await ch.sendAsync(v)`
+         *
+         * Completes once the channel accepts the value, as a select send
+         * case does; on an unbuffered channel that is when the hand-off slot
+         * is free, not when a receiver has taken it.
+         * @throws std::runtime_error from the co_await if the channel is closed
+         */
+        detail::SendAwaiter<T> sendAsync(T value) {
+            return detail::SendAwaiter<T>(impl_, std::move(value));
+        }
+#endif
+
+        /**
+         * @brief Spin/yield/park counts of blocking operations on this channel
+         */
+        gocxx::sync::WaitCounts waitStats() const {
+            return impl_->waitStats();
+        }
+
         std::shared_ptr<IChan<T>> impl() const { 
             return impl_; 
         }
 
     private:
+        static std::shared_ptr<IChan<T>> makeImpl(std::size_t bufferSize, ChanOptions options) {
+            if (options.spsc && bufferSize > 0) {
+                return std::make_shared<SpscChanImpl<T>>(bufferSize, options.wait);
+            }
+            if (bufferSize < 2) {
+                return std::make_shared<ChanImpl<T>>(bufferSize, options.wait);
+            }
+            return std::make_shared<RingChanImpl<T>>(bufferSize, options.wait);
+        }
+
         std::shared_ptr<IChan<T>> impl_;
     };
 
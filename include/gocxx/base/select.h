@@ -2,15 +2,23 @@
 #pragma once
 #include <vector>
 #include <memory>
-#include <condition_variable>
 #include <mutex>
 #include <random>
 #include <atomic>
 #include <functional>
 #include <optional>
 #include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <tuple>
+#include <type_traits>
+#include <utility>
 #include <gocxx/base/chan.h>
 #include <gocxx/base/defer.h>
+#include <gocxx/runtime/condvar.h>
+#include <gocxx/time/duration.h>
 
 namespace gocxx {
 namespace base {
@@ -61,6 +69,19 @@ namespace base {
          */
         virtual std::string getType() const = 0;
 
+        /**
+         * Whether this is the default case, which runs only if no other case is ready.
+         */
+        virtual bool isDefault() const { return false; }
+
+        /**
+         * Point in time at which this case becomes ready by itself, if any.
+         * Select::run() sleeps no longer than the earliest one.
+         */
+        virtual std::optional<std::chrono::steady_clock::time_point> deadline() const {
+            return std::nullopt;
+        }
+
         /**
          * Get the unique case ID.
          * @return The unique identifier for this case
@@ -69,14 +90,15 @@ namespace base {
 
     private:
         size_t caseId_;
-        static std::atomic<size_t> nextCaseId_;
+        static inline std::atomic<size_t> nextCaseId_{1};
     };
 
-    std::atomic<size_t> SelectCase::nextCaseId_{1};
-
     /**
      * Select implementation that mirrors Go's select statement.
      * Allows waiting on multiple channel operations simultaneously.
+     *
+     * Runtime-polymorphic variant for case lists built at run time. The
+     * select() function below does not use it and does not allocate.
      */
     class Select {
     public:
@@ -126,7 +148,7 @@ namespace base {
                 size_t defaultCaseIndex = 0;
                 
                 for (size_t i = 0; i < cases_.size(); ++i) {
-                    if (cases_[i]->getType() == "DefaultCase") {
+                    if (cases_[i]->isDefault()) {
                         hasDefaultCase = true;
                         defaultCaseIndex = i;
                     } else if (cases_[i]->isReady()) {
@@ -150,10 +172,16 @@ namespace base {
                 ready_ = false;
                 done_.store(false, std::memory_order_release);
 
-                // Wait for notification with proper spurious wakeup protection
-                cv_.wait(lock, [this] { 
-                    return done_.load(std::memory_order_acquire) || ready_; 
-                });
+                // Wait for notification with proper spurious wakeup protection,
+                // but no longer than the earliest timeout case
+                auto wakeCondition = [this] {
+                    return done_.load(std::memory_order_acquire) || ready_;
+                };
+                if (auto until = earliestDeadline()) {
+                    cv_.wait_until(lock, *until, wakeCondition);
+                } else {
+                    cv_.wait(lock, wakeCondition);
+                }
 
                 // After waking up, check again for ready cases
                 // The loop will continue and re-evaluate all cases
@@ -177,7 +205,7 @@ namespace base {
          * Get the condition variable for channel registration.
          * @return Pointer to the internal condition variable
          */
-        std::condition_variable* cv() { return &cv_; }
+        gocxx::runtime::CondVar* cv() { return &cv_; }
 
         /**
          * Get the ready flag for channel registration.
@@ -192,6 +220,15 @@ namespace base {
         size_t getSelectId() const { return selectId_; }
 
     private:
+        std::optional<std::chrono::steady_clock::time_point> earliestDeadline() const {
+            std::optional<std::chrono::steady_clock::time_point> earliest;
+            for (const auto& c : cases_) {
+                auto d = c->deadline();
+                if (d && (!earliest || *d < *earliest)) earliest = d;
+            }
+            return earliest;
+        }
+
         /**
          * Clean up all cases by unregistering them.
          */
@@ -233,14 +270,12 @@ namespace base {
         std::vector<std::unique_ptr<SelectCase>> cases_;
         std::atomic<bool> done_;
         std::mutex mutex_;
-        std::condition_variable cv_;
+        gocxx::runtime::CondVar cv_;
         bool ready_;
         size_t selectId_;
-        static std::atomic<size_t> nextSelectId_;
+        static inline std::atomic<size_t> nextSelectId_{1};
     };
 
-    std::atomic<size_t> Select::nextSelectId_{1};
-
     /**
      * Case for receiving from a channel.
      */
@@ -379,55 +414,609 @@ namespace base {
             return "DefaultCase";
         }
 
+        bool isDefault() const override {
+            return true;
+        }
+
+    private:
+        std::function<void()> fn_;
+    };
+
+    /**
+     * Case that becomes ready once a timeout, measured from its construction, expires.
+     */
+    class TimeoutCase : public SelectCase {
+    public:
+        TimeoutCase(gocxx::time::Duration timeout, std::function<void()> fn)
+            : deadline_(std::chrono::steady_clock::now() + timeout.ToStdDuration()), fn_(std::move(fn)) {}
+
+        bool isReady() override {
+            return std::chrono::steady_clock::now() >= deadline_;
+        }
+
+        void execute() override {
+            if (fn_) fn_();
+        }
+
+        void registerWith(Select* /* sel */) override {}
+
+        void unregister() override {}
+
+        std::string getType() const override {
+            return "TimeoutCase";
+        }
+
+        std::optional<std::chrono::steady_clock::time_point> deadline() const override {
+            return deadline_;
+        }
+
     private:
+        std::chrono::steady_clock::time_point deadline_;
         std::function<void()> fn_;
     };
 
+    // =================== STACK-RESIDENT SELECT ===================
+
+    /**
+     * Receive case built by recv(). Holds the callback as its concrete type.
+     * The callback receives the value, or nullopt if the channel is closed.
+     */
+    template<typename T, typename Fn>
+    class SelectRecv {
+    public:
+        SelectRecv(Chan<T>& ch, Fn fn) : chan_(ch), fn_(std::move(fn)) {}
+
+        /**
+         * Complete the receive and run the callback if it can proceed now.
+         * @return true if the case ran
+         */
+        bool tryRun() {
+            // canRecv() is a cheap probe; tryRecv() builds an error on failure
+            if (!chan_.canRecv()) return false;
+            auto result = chan_.tryRecv();
+            if (result.Ok()) {
+                fn_(std::optional<T>(std::move(result.value)));
+                return true;
+            }
+            if (chan_.isClosed()) {
+                fn_(std::optional<T>());
+                return true;
+            }
+            return false;  // Another receiver won the race
+        }
+
+        void enlist(ChanWaiter* waiter) { chan_.impl()->addRecvWaiter(waiter); }
+        void delist(ChanWaiter* waiter) { chan_.impl()->removeRecvWaiter(waiter); }
+
+    private:
+        Chan<T>& chan_;
+        Fn fn_;
+    };
+
+    /**
+     * Send case built by send(). The callback receives true if the value was
+     * sent and false if the channel was closed.
+     */
+    template<typename T, typename Fn>
+    class SelectSend {
+    public:
+        SelectSend(Chan<T>& ch, T value, Fn fn)
+            : chan_(ch), value_(std::move(value)), fn_(std::move(fn)) {}
+
+        /**
+         * Complete the send and run the callback if it can proceed now.
+         * @return true if the case ran
+         */
+        bool tryRun() {
+            if (chan_.isClosed()) {
+                fn_(false);
+                return true;
+            }
+            if (!chan_.canSend()) return false;
+            // trySend leaves value_ untouched on failure, so it can be retried
+            if (chan_.trySend(std::move(value_)).Ok()) {
+                fn_(true);
+                return true;
+            }
+            if (chan_.isClosed()) {
+                fn_(false);
+                return true;
+            }
+            return false;
+        }
+
+        void enlist(ChanWaiter* waiter) { chan_.impl()->addSendWaiter(waiter); }
+        void delist(ChanWaiter* waiter) { chan_.impl()->removeSendWaiter(waiter); }
+
+    private:
+        Chan<T>& chan_;
+        T value_;
+        Fn fn_;
+    };
+
+    /**
+     * Timeout case built by timeoutCase(). It becomes ready when its deadline,
+     * fixed when the case is created, has passed; select() sleeps until then
+     * with a timed wait instead of starting a timer.
+     */
+    template<typename Fn>
+    class SelectTimeout {
+    public:
+        SelectTimeout(std::chrono::steady_clock::time_point deadline, Fn fn)
+            : deadline_(deadline), fn_(std::move(fn)) {}
+
+        bool tryRun() {
+            if (std::chrono::steady_clock::now() < deadline_) return false;
+            fn_();
+            return true;
+        }
+
+        void enlist(ChanWaiter*) {}
+        void delist(ChanWaiter*) {}
+
+        std::chrono::steady_clock::time_point deadline() const { return deadline_; }
+
+    private:
+        std::chrono::steady_clock::time_point deadline_;
+        Fn fn_;
+    };
+
+    /**
+     * Default case built by defaultCase(); runs when no other case is ready.
+     */
+    template<typename Fn>
+    class SelectDefault {
+    public:
+        explicit SelectDefault(Fn fn) : fn_(std::move(fn)) {}
+
+        void run() { fn_(); }
+
+    private:
+        Fn fn_;
+    };
+
+    namespace detail {
+
+        template<typename C>
+        struct IsSelectDefault : std::false_type {};
+
+        template<typename Fn>
+        struct IsSelectDefault<SelectDefault<Fn>> : std::true_type {};
+
+        template<typename C>
+        inline constexpr bool isSelectDefault = IsSelectDefault<std::decay_t<C>>::value;
+
+        template<typename C, typename = void>
+        struct HasSelectDeadline : std::false_type {};
+
+        template<typename C>
+        struct HasSelectDeadline<C, std::void_t<decltype(std::declval<const C&>().deadline())>>
+            : std::true_type {};
+
+        template<typename C>
+        inline constexpr bool hasSelectDeadline = HasSelectDeadline<std::decay_t<C>>::value;
+
+        /**
+         * Per-thread xorshift generator for case order; seeded once per
+         * thread, no locking and no allocation.
+         */
+        inline uint32_t selectRandom(uint32_t bound) {
+            thread_local uint64_t state = 0;
+            if (state == 0) {
+                state = reinterpret_cast<std::uintptr_t>(&state)
+                      ^ static_cast<uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count())
+                      ^ 0x9E3779B97F4A7C15ull;
+                if (state == 0) state = 1;
+            }
+            state ^= state >> 12;
+            state ^= state << 25;
+            state ^= state >> 27;
+            uint64_t r = (state * 0x2545F4914F6CDD1Dull) >> 32;
+            return static_cast<uint32_t>((r * bound) >> 32);
+        }
+
+        /**
+         * Blocking side of select: channels notify it under their own lock,
+         * and it records the wakeup under its mutex, so a notification
+         * between polling the cases and going to sleep is never lost.
+         */
+        class SelectParker : public ChanWaiter {
+        public:
+            void notify() noexcept override {
+                std::lock_guard<std::mutex> lock(mutex_);
+                signaled_ = true;
+                cv_.notify_one();
+            }
+
+            void wait() {
+                std::unique_lock<std::mutex> lock(mutex_);
+                cv_.wait(lock, [this] { return signaled_; });
+                signaled_ = false;
+            }
+
+            void waitUntil(std::chrono::steady_clock::time_point deadline) {
+                std::unique_lock<std::mutex> lock(mutex_);
+                cv_.wait_until(lock, deadline, [this] { return signaled_; });
+                signaled_ = false;
+            }
+
+        private:
+            std::mutex mutex_;
+            gocxx::runtime::CondVar cv_;
+            bool signaled_ = false;
+        };
+
+        /// Tuple positions of the non-default cases, in argument order.
+        template<typename... Cases>
+        constexpr auto selectableIndices() {
+            std::array<std::size_t, (0 + ... + (isSelectDefault<Cases> ? 0 : 1))> out{};
+            std::size_t next = 0, i = 0;
+            ((isSelectDefault<Cases> ? void() : void(out[next++] = i), ++i), ...);
+            return out;
+        }
+
+        /// Tuple position of the default case (only meaningful if there is one).
+        template<typename... Cases>
+        constexpr std::size_t defaultIndex() {
+            std::size_t found = 0, i = 0;
+            ((isSelectDefault<Cases> ? void(found = i) : void(), ++i), ...);
+            return found;
+        }
+
+        template<typename C>
+        bool tryRunCase(C& c) {
+            if constexpr (isSelectDefault<C>) {
+                return false;
+            } else {
+                return c.tryRun();
+            }
+        }
+
+        template<typename Tuple, std::size_t... I>
+        bool tryRunAt(Tuple& cases, std::size_t index, std::index_sequence<I...>) {
+            bool ran = false;
+            (void)((index == I ? (ran = tryRunCase(std::get<I>(cases)), true) : false) || ...);
+            return ran;
+        }
+
+        template<typename C>
+        void earliestDeadline(const C& c, std::chrono::steady_clock::time_point& earliest) {
+            if constexpr (hasSelectDeadline<C>) {
+                if (c.deadline() < earliest) earliest = c.deadline();
+            }
+        }
+
+        template<typename C>
+        void enlistCase(C& c, ChanWaiter* waiter) {
+            if constexpr (!isSelectDefault<C>) c.enlist(waiter);
+        }
+
+        template<typename C>
+        void delistCase(C& c, ChanWaiter* waiter) {
+            if constexpr (!isSelectDefault<C>) c.delist(waiter);
+        }
+
+    } // namespace detail
+
     // =================== HELPER FUNCTIONS ===================
 
     /**
      * Create a receive case for a select statement.
      * @param ch The channel to receive from
-     * @param fn Function to call with the received value (or nullopt if closed)
-     * @return Unique pointer to the created case
+     * @param fn Callable invoked with the received value (or nullopt if closed)
+     * @return The case, to be passed straight to select()
      */
-    template<typename T>
-    std::unique_ptr<RecvCase<T>> recv(Chan<T>& ch, std::function<void(std::optional<T>)> fn) {
-        return std::make_unique<RecvCase<T>>(ch, std::move(fn));
+    template<typename T, typename Fn>
+    SelectRecv<T, std::decay_t<Fn>> recv(Chan<T>& ch, Fn&& fn) {
+        return SelectRecv<T, std::decay_t<Fn>>(ch, std::forward<Fn>(fn));
     }
 
     /**
      * Create a send case for a select statement.
      * @param ch The channel to send to
      * @param val The value to send
-     * @param fn Function to call with send result (true if successful)
-     * @return Unique pointer to the created case
+     * @param fn Callable invoked with the send result (true if sent)
+     * @return The case, to be passed straight to select()
      */
-    template<typename T>
-    std::unique_ptr<SendCase<T>> send(Chan<T>& ch, T val, std::function<void(bool)> fn) {
-        return std::make_unique<SendCase<T>>(ch, std::move(val), std::move(fn));
+    template<typename T, typename Fn>
+    SelectSend<T, std::decay_t<Fn>> send(Chan<T>& ch, T val, Fn&& fn) {
+        return SelectSend<T, std::decay_t<Fn>>(ch, std::move(val), std::forward<Fn>(fn));
+    }
+
+    /**
+     * Create a timeout case for a select statement.
+     * @param timeout How long, from now, until the case becomes ready
+     * @param fn Callable invoked if the timeout expires before another case is ready
+     * @return The case, to be passed straight to select()
+     */
+    template<typename Fn>
+    SelectTimeout<std::decay_t<Fn>> timeoutCase(gocxx::time::Duration timeout, Fn&& fn) {
+        return SelectTimeout<std::decay_t<Fn>>(
+            std::chrono::steady_clock::now() + timeout.ToStdDuration(), std::forward<Fn>(fn));
     }
 
     /**
      * Create a default case for a select statement.
-     * @param fn Function to call if no other cases are ready
-     * @return Unique pointer to the created case
+     * @param fn Callable invoked if no other case is ready
+     * @return The case, to be passed straight to select()
      */
-    inline std::unique_ptr<DefaultCase> defaultCase(std::function<void()> fn) {
-        return std::make_unique<DefaultCase>(std::move(fn));
+    template<typename Fn>
+    SelectDefault<std::decay_t<Fn>> defaultCase(Fn&& fn) {
+        return SelectDefault<std::decay_t<Fn>>(std::forward<Fn>(fn));
     }
 
     /**
      * Execute a select statement with the given cases.
      * This is the main entry point that mimics Go's select statement.
-     * @param cs Variable number of case arguments
+     *
+     * The cases stay where the caller built them (a tuple of references on
+     * the stack) and their callbacks are called through their concrete
+     * types, so a select that finds a ready case performs no allocation.
+     * Ready cases are polled in a random order, giving each one the same
+     * chance as in Go. Without a ready case the default case runs if there
+     * is one (detected at compile time); otherwise select registers with
+     * every channel and sleeps until one of them changes state or the
+     * earliest timeoutCase() expires. Timeouts use a timed wait on the
+     * select's own condition variable; no timer thread or channel is created.
+     *
+     * Any type with tryRun(), enlist(ChanWaiter*) and delist(ChanWaiter*)
+     * can serve as a case (and deadline() for one that fires by itself),
+     * e.g. gocxx::context::doneCase().
+     *
+     * @param cs Cases created by recv(), send(), timeoutCase() and defaultCase()
      */
     template<typename... Cases>
     void select(Cases&&... cs) {
-        Select sel;
-        (sel.addCase(std::forward<Cases>(cs)), ...);
-        sel.run();
+        constexpr std::size_t defaults = (0 + ... + (detail::isSelectDefault<Cases> ? 1 : 0));
+        static_assert(defaults <= 1, "select: at most one default case");
+        constexpr auto selectable = detail::selectableIndices<Cases...>();
+        constexpr std::size_t n = selectable.size();
+
+        auto cases = std::forward_as_tuple(cs...);
+        auto indices = std::index_sequence_for<Cases...>{};
+
+        auto pollRandomOrder = [&]() {
+            if constexpr (n == 0) {
+                return false;
+            } else {
+                std::array<std::size_t, n> order = selectable;
+                for (std::size_t i = n - 1; i > 0; --i) {
+                    std::swap(order[i], order[detail::selectRandom(static_cast<uint32_t>(i + 1))]);
+                }
+                for (std::size_t index : order) {
+                    if (detail::tryRunAt(cases, index, indices)) return true;
+                }
+                return false;
+            }
+        };
+
+        if (pollRandomOrder()) return;
+        if constexpr (defaults == 1) {
+            std::get<detail::defaultIndex<Cases...>()>(cases).run();
+            return;
+        } else {
+            static_assert(n > 0, "select: needs at least one case");
+
+            detail::SelectParker parker;
+            std::apply([&](auto&... c) { (detail::enlistCase(c, &parker), ...); }, cases);
+            auto delistAll = [&]() {
+                std::apply([&](auto&... c) { (detail::delistCase(c, &parker), ...); }, cases);
+            };
+            defer(delistAll);
+
+            constexpr bool timed = (false || ... || detail::hasSelectDeadline<Cases>);
+            if constexpr (timed) {
+                auto earliest = std::chrono::steady_clock::time_point::max();
+                std::apply([&](const auto&... c) { (detail::earliestDeadline(c, earliest), ...); }, cases);
+                while (!pollRandomOrder()) {
+                    parker.waitUntil(earliest);
+                }
+            } else {
+                while (!pollRandomOrder()) {
+                    parker.wait();
+                }
+            }
+        }
     }
 
+    // =================== DYNAMIC SELECT ===================
+
+    /**
+     * Receive from whichever of a runtime-sized set of channels is ready,
+     * the equivalent of Go's reflect.Select over receive cases.
+     *
+     * Each channel is registered with the set once, in add(), and stays
+     * registered until remove() or destruction. A channel that may have
+     * become ready pushes its index onto a ready queue (at most once until it
+     * is looked at again), so recv() costs O(1) per wakeup no matter how many
+     * channels are in the set. After a successful receive the channel goes to
+     * the back of the queue, so busy channels are served round-robin.
+     *
+     * All methods are thread-safe.
+     *
+     * @par Example
+     * @code
+     * SelectSet<Msg> upstreams;
+     * for (auto& ch : channels) upstreams.add(ch);
+     * while (upstreams.size() > 0) {
+     *     auto [index, msg] = upstreams.recv();
+     *     if (!msg) { upstreams.remove(index); continue; }  // closed
+     *     route(*msg);
+     * }
+     * @endcode
+     */
+    template<typename T>
+    class SelectSet {
+    public:
+        /**
+         * Result of a receive: the index add() returned for the channel that
+         * fired, and its value (nullopt if that channel is closed and drained).
+         */
+        struct Selected {
+            std::size_t index;
+            std::optional<T> value;
+        };
+
+        SelectSet() = default;
+
+        ~SelectSet() {
+            for (auto& entry : entries_) {
+                if (entry) entry->chan->removeRecvWaiter(entry.get());
+            }
+        }
+
+        SelectSet(const SelectSet&) = delete;
+        SelectSet& operator=(const SelectSet&) = delete;
+
+        /**
+         * Add a channel to the set.
+         * @return The index reported by recv() for this channel; indices of
+         *         removed channels are reused
+         */
+        std::size_t add(const Chan<T>& ch) {
+            auto entry = std::make_unique<Entry>(this, ch.impl());
+            Entry* raw = entry.get();
+            std::size_t index;
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (free_.empty()) {
+                    index = entries_.size();
+                    entries_.push_back(nullptr);
+                } else {
+                    index = free_.back();
+                    free_.pop_back();
+                }
+                raw->index = index;
+                entries_[index] = std::move(entry);
+                ++size_;
+            }
+            // Registered without mutex_ held: channels call notify() under their own lock
+            raw->chan->addRecvWaiter(raw);
+            if (raw->chan->canRecv()) raw->notify();
+            return index;
+        }
+
+        /**
+         * Remove the channel at @p index. Unknown indices are ignored.
+         */
+        void remove(std::size_t index) {
+            std::unique_ptr<Entry> entry;
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (index >= entries_.size() || !entries_[index]) return;
+                entry = std::move(entries_[index]);
+                free_.push_back(index);
+                --size_;
+            }
+            // After this returns no notify() for entry is running or will run
+            entry->chan->removeRecvWaiter(entry.get());
+        }
+
+        /**
+         * Number of channels in the set.
+         */
+        std::size_t size() const {
+            std::lock_guard<std::mutex> lock(mutex_);
+            return size_;
+        }
+
+        /**
+         * Block until one of the channels delivers a value or reports closed.
+         */
+        Selected recv() {
+            while (true) {
+                std::size_t index;
+                std::shared_ptr<IChan<T>> chan;
+                {
+                    std::unique_lock<std::mutex> lock(mutex_);
+                    cv_.wait(lock, [this] { return !ready_.empty(); });
+                    if (!popReady(index, chan)) continue;
+                }
+                if (auto selected = tryChannel(index, chan)) return std::move(*selected);
+            }
+        }
+
+        /**
+         * Receive from a ready channel without blocking.
+         * @return nullopt if no channel in the set is ready
+         */
+        std::optional<Selected> tryRecv() {
+            while (true) {
+                std::size_t index;
+                std::shared_ptr<IChan<T>> chan;
+                {
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    if (ready_.empty()) return std::nullopt;
+                    if (!popReady(index, chan)) continue;
+                }
+                if (auto selected = tryChannel(index, chan)) return selected;
+            }
+        }
+
+    private:
+        struct Entry : ChanWaiter {
+            Entry(SelectSet* s, std::shared_ptr<IChan<T>> c) : set(s), chan(std::move(c)) {}
+
+            void notify() noexcept override {
+                set->markReady(this);
+            }
+
+            SelectSet* set;
+            std::shared_ptr<IChan<T>> chan;
+            std::size_t index = 0;
+            bool queued = false;  // Guarded by set->mutex_
+        };
+
+        void markReady(Entry* entry) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (entry->queued) return;
+            entry->queued = true;
+            ready_.push_back(entry->index);
+            cv_.notify_one();
+        }
+
+        // Caller holds mutex_. Clears the queued flag before the channel is
+        // probed, so a send racing with the probe queues the index again.
+        bool popReady(std::size_t& index, std::shared_ptr<IChan<T>>& chan) {
+            index = ready_.front();
+            ready_.pop_front();
+            if (index >= entries_.size() || !entries_[index]) return false;  // Removed
+            Entry& entry = *entries_[index];
+            entry.queued = false;
+            chan = entry.chan;
+            return true;
+        }
+
+        std::optional<Selected> tryChannel(std::size_t index, const std::shared_ptr<IChan<T>>& chan) {
+            if (!chan->canRecv()) return std::nullopt;
+            auto result = chan->tryRecv();
+            if (result.Ok()) {
+                requeue(index, chan);  // It may hold more values
+                return Selected{index, std::optional<T>(std::move(result.value))};
+            }
+            if (chan->isClosed()) {
+                return Selected{index, std::nullopt};
+            }
+            return std::nullopt;
+        }
+
+        void requeue(std::size_t index, const std::shared_ptr<IChan<T>>& chan) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (index < entries_.size() && entries_[index] && entries_[index]->chan == chan
+                && !entries_[index]->queued) {
+                entries_[index]->queued = true;
+                ready_.push_back(index);
+                cv_.notify_one();
+            }
+        }
+
+        mutable std::mutex mutex_;
+        gocxx::runtime::CondVar cv_;
+        std::vector<std::unique_ptr<Entry>> entries_;
+        std::vector<std::size_t> free_;
+        std::deque<std::size_t> ready_;
+        std::size_t size_ = 0;
+    };
+
 } // namespace base
 } // namespace gocxx
\ No newline at end of file
@@ -0,0 +1,288 @@
+/**
+ * @file bufio.h
+ * @brief Go-inspired buffered I/O over io::Reader and io::Writer
+ *
+ * This module mirrors Go's bufio package:
+ * - Reader: buffered reads with Peek, ReadByte, ReadSlice and ReadLine
+ * - Writer: buffered writes, flushed when the buffer fills or on Flush()
+ * - Scanner: token reading with pluggable split functions
+ *
+ * Slices returned by Peek, ReadSlice, ReadLine and Scanner::Bytes are views
+ * into the internal buffer, as in Go: no copy is made, and they stay valid
+ * only until the next call on the same object.
+ *
+ * As elsewhere in gocxx::io, a Read that returns 0 bytes and no error is
+ * taken as end of stream, like ErrEOF.
+ *
+ * @author gocxx
+ * @date 2025
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <gocxx/base/result.h>
+#include <gocxx/errors/errors.h>
+#include <gocxx/io/io.h>
+#include <gocxx/io/io_errors.h>
+
+namespace gocxx::bufio {
+
+    constexpr std::size_t defaultBufSize = 4096;
+
+    /// Largest token a Scanner accepts unless Buffer() raises it
+    constexpr std::size_t MaxScanTokenSize = 64 * 1024;
+
+    // ------------------ Errors ------------------
+
+    inline const std::shared_ptr<errors::Error> ErrBufferFull =
+        std::make_shared<errors::simpleError>("bufio: buffer full");
+
+    inline const std::shared_ptr<errors::Error> ErrInvalidUnreadByte =
+        std::make_shared<errors::simpleError>("bufio: invalid use of UnreadByte");
+
+    inline const std::shared_ptr<errors::Error> ErrTooLong =
+        std::make_shared<errors::simpleError>("bufio.Scanner: token too long");
+
+    inline const std::shared_ptr<errors::Error> ErrAdvanceTooFar =
+        std::make_shared<errors::simpleError>("bufio.Scanner: SplitFunc returns advance count beyond input");
+
+    inline const std::shared_ptr<errors::Error> ErrFinalToken =
+        std::make_shared<errors::simpleError>("final token");
+
+    // ------------------ Reader ------------------
+
+    /**
+     * @brief Buffered reader
+     * Go equivalent: bufio.Reader
+     *
+     * Reads from the underlying reader in chunks of the buffer size. A Read()
+     * into a buffer at least that large with nothing buffered goes straight
+     * to the underlying reader.
+     */
+    class Reader : public io::Reader, public io::ByteReader {
+    public:
+        /**
+         * @brief Go equivalent: bufio.NewReaderSize(rd, size)
+         */
+        explicit Reader(std::shared_ptr<io::Reader> rd, std::size_t size = defaultBufSize);
+
+        gocxx::base::Result<std::size_t> Read(uint8_t* buffer, std::size_t size) override;
+        using io::Reader::Read;
+
+        gocxx::base::Result<std::size_t> ReadByte(uint8_t& outByte) override;
+
+        /**
+         * @brief Put back the last byte read; only one byte can be unread
+         */
+        gocxx::base::Result<void> UnreadByte();
+
+        /**
+         * @brief The next @p n bytes without consuming them
+         *
+         * Returns fewer bytes with an error if the stream ends first, or with
+         * ErrBufferFull if @p n exceeds the buffer size.
+         */
+        gocxx::base::Result<std::string_view> Peek(std::size_t n);
+
+        /**
+         * @brief Skip the next @p n bytes
+         * @return bytes skipped; fewer than @p n only with an error
+         */
+        gocxx::base::Result<std::size_t> Discard(std::size_t n);
+
+        /**
+         * @brief Read up to and including the first @p delim
+         *
+         * Fails with ErrBufferFull, returning the whole buffer, if the buffer
+         * fills before @p delim is found. At end of stream, returns what is
+         * left with the stream's error.
+         */
+        gocxx::base::Result<std::string_view> ReadSlice(uint8_t delim);
+
+        struct Line {
+            std::string_view text;  ///< Without the trailing "\n" or "\r\n"
+            bool isPrefix = false;  ///< Line longer than the buffer; the rest follows
+        };
+
+        /**
+         * @brief Read one line, without its end-of-line marker
+         * Go equivalent: (*Reader).ReadLine() (line []byte, isPrefix bool, err error)
+         */
+        gocxx::base::Result<Line> ReadLine();
+
+        /**
+         * @brief Read up to and including @p delim into a new string, however long
+         */
+        gocxx::base::Result<std::string> ReadString(uint8_t delim);
+
+        /**
+         * @brief Bytes that can be read without touching the underlying reader
+         */
+        std::size_t Buffered() const { return w_ - r_; }
+
+        std::size_t Size() const { return buf_.size(); }
+
+        /**
+         * @brief Drop buffered data and state, and read from @p rd from now on
+         */
+        void Reset(std::shared_ptr<io::Reader> rd);
+
+    private:
+        void fill();
+        std::shared_ptr<errors::Error> takeErr();
+        std::string_view view(std::size_t from, std::size_t to) const {
+            return std::string_view(reinterpret_cast<const char*>(buf_.data()) + from, to - from);
+        }
+
+        std::shared_ptr<io::Reader> rd_;
+        std::vector<uint8_t> buf_;
+        std::size_t r_ = 0;   // Next byte to return
+        std::size_t w_ = 0;   // End of buffered data
+        std::shared_ptr<errors::Error> err_;
+        int lastByte_ = -1;   // For UnreadByte; -1 when nothing can be unread
+    };
+
+    // ------------------ Writer ------------------
+
+    /**
+     * @brief Buffered writer
+     * Go equivalent: bufio.Writer
+     *
+     * Writes go to the underlying writer when the buffer fills, on Flush(),
+     * or directly if they are larger than the buffer and nothing is
+     * buffered. After an error, every later call returns that error.
+     * Nothing is flushed on destruction, as in Go: call Flush().
+     */
+    class Writer : public io::Writer, public io::ByteWriter {
+    public:
+        /**
+         * @brief Go equivalent: bufio.NewWriterSize(wr, size)
+         */
+        explicit Writer(std::shared_ptr<io::Writer> wr, std::size_t size = defaultBufSize);
+
+        gocxx::base::Result<std::size_t> Write(const uint8_t* buffer, std::size_t size) override;
+        using io::Writer::Write;
+
+        gocxx::base::Result<std::size_t> WriteByte(uint8_t byte) override;
+        gocxx::base::Result<std::size_t> WriteString(std::string_view s);
+
+        /**
+         * @brief Write all buffered data to the underlying writer
+         */
+        gocxx::base::Result<void> Flush();
+
+        std::size_t Available() const { return buf_.size() - n_; }
+        std::size_t Buffered() const { return n_; }
+        std::size_t Size() const { return buf_.size(); }
+
+        /**
+         * @brief Drop buffered data and any error, and write to @p wr from now on
+         */
+        void Reset(std::shared_ptr<io::Writer> wr);
+
+    private:
+        std::shared_ptr<io::Writer> wr_;
+        std::vector<uint8_t> buf_;
+        std::size_t n_ = 0;  // Bytes buffered
+        std::shared_ptr<errors::Error> err_;
+    };
+
+    // ------------------ Scanner ------------------
+
+    /**
+     * @brief What a split function found at the start of the unread data
+     *
+     * Go returns (advance int, token []byte, err error); here a token is
+     * present only if hasToken is set, so an empty token can be told from
+     * "need more data". Return ErrFinalToken with a token to end the scan
+     * after it.
+     */
+    struct SplitResult {
+        std::size_t advance = 0;
+        std::string_view token;
+        bool hasToken = false;
+        std::shared_ptr<errors::Error> err;
+    };
+
+    /**
+     * @brief Go equivalent: bufio.SplitFunc
+     * @param data unread bytes; may be empty only when @p atEOF
+     * @param atEOF no more data will follow
+     */
+    using SplitFunc = std::function<SplitResult(std::string_view data, bool atEOF)>;
+
+    /// Lines without "\n" or "\r\n"; the last line may lack the newline
+    SplitResult ScanLines(std::string_view data, bool atEOF);
+
+    /// Words separated by ASCII whitespace (Go also splits on Unicode spaces)
+    SplitResult ScanWords(std::string_view data, bool atEOF);
+
+    /// One byte at a time
+    SplitResult ScanBytes(std::string_view data, bool atEOF);
+
+    /**
+     * @brief Reads a stream as a sequence of tokens
+     * Go equivalent: bufio.Scanner
+     *
+     * @code
+     * bufio::Scanner sc(file);
+     * while (sc.Scan()) {
+     *     handle(sc.Bytes());
+     * }
+     * if (sc.Err()) { ... }
+     * @endcode
+     */
+    class Scanner {
+    public:
+        explicit Scanner(std::shared_ptr<io::Reader> rd);
+
+        /**
+         * @brief Set the split function (ScanLines by default); only before the first Scan()
+         */
+        void Split(SplitFunc split);
+
+        /**
+         * @brief Start with @p initial bytes of buffer and grow it up to @p max
+         */
+        void Buffer(std::size_t initial, std::size_t max);
+
+        /**
+         * @brief Advance to the next token
+         * @return false at end of stream or on error; see Err()
+         */
+        bool Scan();
+
+        /// The current token, valid until the next Scan()
+        std::string_view Bytes() const { return token_; }
+
+        /// The current token as a new string
+        std::string Text() const { return std::string(token_); }
+
+        /// First error other than end of stream, or nullptr
+        std::shared_ptr<errors::Error> Err() const;
+
+    private:
+        void setErr(std::shared_ptr<errors::Error> err);
+
+        std::shared_ptr<io::Reader> rd_;
+        SplitFunc split_;
+        std::vector<uint8_t> buf_;
+        std::size_t maxTokenSize_ = MaxScanTokenSize;
+        std::size_t start_ = 0;  // First unprocessed byte
+        std::size_t end_ = 0;    // End of data in buf_
+        std::string_view token_;
+        std::shared_ptr<errors::Error> err_;
+        int empties_ = 0;        // Consecutive empty tokens without progress
+        bool scanCalled_ = false;
+        bool done_ = false;
+    };
+
+} // namespace gocxx::bufio
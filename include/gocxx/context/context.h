@@ -42,9 +42,13 @@
 #include <typeindex>
 #include <future>
 #include <thread>
+#include <optional>
 #include <gocxx/base/result.h>
 #include <gocxx/base/chan.h>
+#include <gocxx/base/select.h>
+#include <gocxx/errors/errors.h>
 #include <gocxx/time/time.h>
+#include <gocxx/time/timer_service.h>
 
 namespace gocxx {
 namespace context {
@@ -52,6 +56,22 @@ namespace context {
 // Forward declarations
 class Context;
 using ContextPtr = std::shared_ptr<Context>;
+class ContextKeyBase;
+class CancelContext;
+
+namespace detail {
+/**
+ * @brief Nearest CancelContext at or above @p ctx, looking through value layers
+ * Go equivalent: parentCancelCtx()
+ * @return nullptr if there is none, i.e. nothing will cancel a child of @p ctx
+ */
+std::shared_ptr<CancelContext> cancelAncestor(const ContextPtr& ctx);
+} // namespace detail
+
+/**
+ * @brief Typed values visible from a context, pointing into the chain that owns them (see Flatten())
+ */
+using ValueMap = std::unordered_map<const ContextKeyBase*, const std::any*>;
 
 /**
  * @brief Context interface matching Go's context.Context exactly
@@ -73,9 +93,26 @@ public:
     /**
      * @brief Returns a channel that is closed when context is canceled
      * Go equivalent: Done() <-chan struct{}
-     * @return Channel that receives cancellation signal
+     * @return Channel that receives cancellation signal; the reference stays
+     *         valid for the lifetime of the context
      */
-    virtual gocxx::base::Chan<bool> Done() const = 0;
+    virtual const gocxx::base::Chan<bool>& Done() const = 0;
+
+#if GOCXX_HAS_COROUTINES
+    /**
+     * @brief Awaitable that completes once the context is canceled (C++20)
+     * Go equivalent: <-ctx.Done()
+     *
+     * `co_await ctx->DoneAsync();` suspends the coroutine, not the thread,
+     * and resumes it on the Executor it awaited from.
+     */
+    struct DoneAwaiter : gocxx::base::detail::RecvAwaiter<bool> {
+        using RecvAwaiter::RecvAwaiter;
+        void await_resume() const noexcept {}
+    };
+
+    DoneAwaiter DoneAsync() const { return DoneAwaiter(Done().impl()); }
+#endif
     
     /**
      * @brief Returns error explaining why context was canceled
@@ -91,6 +128,43 @@ public:
      * @return Result containing value if found, error if not found
      */
     virtual gocxx::base::Result<std::any> Value(const std::any& key) const = 0;
+
+    /**
+     * @brief Find the value stored under a typed key (not in Go)
+     *
+     * Keys are matched by identity; use ContextKey<T>::Lookup() for a typed
+     * result.
+     * @return Pointer to the stored value, or nullptr if @p key is not set
+     */
+    virtual const std::any* LookupValue(const ContextKeyBase* /* key */) const { return nullptr; }
+
+    /**
+     * @brief Add every typed value visible from this context to @p values
+     *
+     * Keys already present in @p values are left alone, so nearer values win.
+     */
+    virtual void CollectValues(ValueMap& /* values */) const {}
+
+    /**
+     * @brief Check if context is canceled (convenience method, not in Go)
+     * @return true once Done() is closed
+     */
+    virtual bool IsCanceled() const { return !Err().Ok(); }
+
+    /**
+     * @brief Notify @p waiter when this context is canceled (select support, not in Go)
+     *
+     * Used by doneCase() so a select can wait on the context without copying
+     * its Done() channel.
+     *
+     * @return false if this context can never be canceled (nothing was registered)
+     */
+    virtual bool AddDoneWaiter(gocxx::base::ChanWaiter* waiter) const;
+
+    /**
+     * @brief Undo a successful AddDoneWaiter()
+     */
+    virtual void RemoveDoneWaiter(gocxx::base::ChanWaiter* waiter) const;
 };
 
 /**
@@ -101,23 +175,47 @@ using CancelFunc = std::function<void()>;
 
 /**
  * @brief Context with cancellation capability
+ *
+ * Children registered with AddChild() sit in an intrusive list guarded by
+ * this context's mutex. A child unlinks itself when it is canceled or
+ * destroyed, so a long-lived parent only holds its live children. Cancel()
+ * walks the subtree iteratively and never holds more than one context's
+ * mutex at a time.
+ *
+ * The Done() channel is created on first use, and the cancellation error is
+ * created once, so Done() and Err() do not allocate.
  */
-class CancelContext : public Context {
+class CancelContext : public Context, public std::enable_shared_from_this<CancelContext> {
 private:
     ContextPtr parent_;
     mutable std::mutex mutex_;
     std::atomic<bool> canceled_;
-    std::string err_;
-    mutable gocxx::base::Chan<bool> done_chan_;
-    std::vector<std::weak_ptr<CancelContext>> children_;
+    std::shared_ptr<gocxx::errors::Error> err_;  // Set once, before canceled_
+    mutable std::optional<gocxx::base::Chan<bool>> done_chan_;
+    mutable std::atomic<bool> has_done_chan_{false};
+
+    // Children list, guarded by mutex_
+    CancelContext* first_child_ = nullptr;
+    std::size_t num_children_ = 0;
+
+    // Links in the parent's children list, guarded by the parent's mutex_
+    std::atomic<CancelContext*> cancel_parent_{nullptr};
+    CancelContext* prev_sibling_ = nullptr;
+    CancelContext* next_sibling_ = nullptr;
+    bool linked_ = false;
     
 public:
     explicit CancelContext(ContextPtr parent = nullptr);
+    ~CancelContext() override;
     
     gocxx::base::Result<gocxx::time::Time> Deadline() const override;
-    gocxx::base::Chan<bool> Done() const override;
+    const gocxx::base::Chan<bool>& Done() const override;
     gocxx::base::Result<void> Err() const override;
     gocxx::base::Result<std::any> Value(const std::any& key) const override;
+    const std::any* LookupValue(const ContextKeyBase* key) const override;
+    void CollectValues(ValueMap& values) const override;
+    bool AddDoneWaiter(gocxx::base::ChanWaiter* waiter) const override;
+    void RemoveDoneWaiter(gocxx::base::ChanWaiter* waiter) const override;
     
     /**
      * @brief Cancel this context and all its children
@@ -127,6 +225,8 @@ public:
     
     /**
      * @brief Add a child context
+     *
+     * The child is canceled immediately if this context already is.
      * @param child Child context to add
      */
     void AddChild(std::shared_ptr<CancelContext> child);
@@ -135,16 +235,37 @@ public:
      * @brief Check if context is canceled (convenience method, not in Go)
      * @return true if context is canceled
      */
-    bool IsCanceled() const { return canceled_.load(); }
+    bool IsCanceled() const override { return canceled_.load(std::memory_order_acquire); }
+
+    /**
+     * @brief Number of children still registered (convenience method, not in Go)
+     */
+    std::size_t NumChildren() const;
+
+protected:
+    /**
+     * @brief Called once, outside any lock, after this context is canceled
+     */
+    virtual void Canceled() {}
+
+private:
+    bool cancelSelf(const std::string& reason,
+                    std::vector<std::shared_ptr<CancelContext>>& children);
+    void detachFromParent();
+    void unlinkChild(CancelContext* child);
 };
 
 /**
  * @brief Context with timeout/deadline
+ *
+ * The deadline is a timer on the shared gocxx::time::TimerService; no thread
+ * is started per context. Canceling the context removes the timer, and a
+ * deadline that has already passed cancels the context on construction.
  */
 class TimerContext : public CancelContext {
 private:
     gocxx::time::Time deadline_;
-    std::unique_ptr<std::thread> timer_thread_;
+    gocxx::time::TimerService::Handle timer_;
     
 public:
     explicit TimerContext(ContextPtr parent, gocxx::time::Time deadline);
@@ -153,26 +274,130 @@ public:
     
     gocxx::base::Result<gocxx::time::Time> Deadline() const override;
     
+protected:
+    void Canceled() override;
+
 private:
     void StartTimer();
 };
 
+/**
+ * @brief Identity of a typed context key; see ContextKey
+ */
+class ContextKeyBase {
+public:
+    explicit ContextKeyBase(std::string name) : name_(std::move(name)) {}
+
+    // A key is its address: copies would be different keys
+    ContextKeyBase(const ContextKeyBase&) = delete;
+    ContextKeyBase& operator=(const ContextKeyBase&) = delete;
+
+    /**
+     * @brief Name for debugging; not used for matching
+     */
+    const std::string& Name() const { return name_; }
+
+private:
+    std::string name_;
+};
+
+/**
+ * @brief Typed, interned context key
+ *
+ * Go's idiom of an unexported key type, in C++: declare one key object per
+ * value and look values up through it. Matching compares the key's address,
+ * so a lookup costs one pointer comparison per context in the chain (or one
+ * hash lookup on a Flatten()ed context), and neither the key nor the value is
+ * copied.
+ *
+ * @code
+ * static const ContextKey<std::string> RequestID("request_id");
+ *
+ * auto ctx = WithValue(parent, RequestID, id).value;
+ * if (const std::string* id = RequestID.Lookup(*ctx)) { ... }
+ * @endcode
+ */
+template<typename T>
+class ContextKey : public ContextKeyBase {
+public:
+    using value_type = T;
+
+    using ContextKeyBase::ContextKeyBase;
+
+    /**
+     * @brief The value stored under this key in @p ctx
+     * @return Pointer valid while @p ctx is alive, or nullptr if not set
+     */
+    const T* Lookup(const Context& ctx) const {
+        return std::any_cast<T>(ctx.LookupValue(this));
+    }
+
+    /**
+     * @brief Copy of the value stored under this key in @p ctx
+     * @return Result containing the value, or an error if not set
+     */
+    gocxx::base::Result<T> Value(const ContextPtr& ctx) const {
+        const T* value = ctx ? Lookup(*ctx) : nullptr;
+        if (!value) {
+            return gocxx::base::Result<T>(gocxx::errors::New("key not found"));
+        }
+        return gocxx::base::Result<T>(*value);
+    }
+};
+
 /**
  * @brief Context with values
  */
 class ValueContext : public Context {
 private:
+    friend std::shared_ptr<CancelContext> detail::cancelAncestor(const ContextPtr& ctx);
+
     ContextPtr parent_;
     std::any key_;
+    const ContextKeyBase* typed_key_ = nullptr;
     std::any value_;
     
 public:
     ValueContext(ContextPtr parent, const std::any& key, const std::any& value);
+    ValueContext(ContextPtr parent, const ContextKeyBase* key, std::any value);
     
     gocxx::base::Result<gocxx::time::Time> Deadline() const override;
-    gocxx::base::Chan<bool> Done() const override;
+    const gocxx::base::Chan<bool>& Done() const override;
     gocxx::base::Result<void> Err() const override;
     gocxx::base::Result<std::any> Value(const std::any& key) const override;
+    const std::any* LookupValue(const ContextKeyBase* key) const override;
+    void CollectValues(ValueMap& values) const override;
+    bool IsCanceled() const override;
+    bool AddDoneWaiter(gocxx::base::ChanWaiter* waiter) const override;
+    void RemoveDoneWaiter(gocxx::base::ChanWaiter* waiter) const override;
+};
+
+/**
+ * @brief Immutable snapshot of a context's typed values, built by Flatten()
+ *
+ * Typed lookups are one hash lookup instead of a walk up the chain; the
+ * values themselves stay in the chain and are not copied. Cancellation,
+ * deadline and legacy std::any keys are forwarded to the flattened context.
+ */
+class FlatValueContext : public Context {
+private:
+    friend std::shared_ptr<CancelContext> detail::cancelAncestor(const ContextPtr& ctx);
+
+    ContextPtr parent_;  // Owns the values that values_ points to
+    ValueMap values_;
+    
+public:
+    explicit FlatValueContext(ContextPtr parent);
+    
+    gocxx::base::Result<gocxx::time::Time> Deadline() const override;
+    const gocxx::base::Chan<bool>& Done() const override;
+    gocxx::base::Result<void> Err() const override;
+    gocxx::base::Result<std::any> Value(const std::any& key) const override;
+    const std::any* LookupValue(const ContextKeyBase* key) const override;
+    void CollectValues(ValueMap& values) const override;
+    bool IsCanceled() const override;
+    bool AddDoneWaiter(gocxx::base::ChanWaiter* waiter) const override;
+    void RemoveDoneWaiter(gocxx::base::ChanWaiter* waiter) const override;
 };
 
 /**
@@ -181,9 +406,12 @@ public:
 class BackgroundContext : public Context {
 public:
     gocxx::base::Result<gocxx::time::Time> Deadline() const override;
-    gocxx::base::Chan<bool> Done() const override;
+    const gocxx::base::Chan<bool>& Done() const override;
     gocxx::base::Result<void> Err() const override;
     gocxx::base::Result<std::any> Value(const std::any& key) const override;
+    bool IsCanceled() const override { return false; }
+    bool AddDoneWaiter(gocxx::base::ChanWaiter*) const override { return false; }
+    void RemoveDoneWaiter(gocxx::base::ChanWaiter*) const override {}
 };
 
 /**
@@ -232,6 +460,10 @@ gocxx::base::Result<std::pair<ContextPtr, CancelFunc>> WithTimeout(
 /**
  * @brief Returns a copy of parent with a deadline
  * Go equivalent: context.WithDeadline(parent Context, d time.Time) (Context, CancelFunc)
+ *
+ * As in Go, if the parent's deadline is already earlier than @p deadline the
+ * result is a plain cancelable child that inherits the parent's deadline,
+ * and no timer is created.
  * @param parent Parent context
  * @param deadline Absolute deadline
  * @return Result containing pair of (context, cancel_function)
@@ -255,10 +487,93 @@ gocxx::base::Result<ContextPtr> WithValue(
     const std::any& value
 );
 
+/**
+ * @brief Returns a copy of parent with @p value stored under a typed key
+ * Go equivalent: context.WithValue(parent, key, val) with an unexported key type
+ * @param parent Parent context
+ * @param key Key object; must outlive every context that uses it
+ * @param value Value to associate
+ * @return Result containing context with the value
+ */
+template<typename T>
+gocxx::base::Result<ContextPtr> WithValue(
+    ContextPtr parent,
+    const ContextKey<T>& key,
+    typename ContextKey<T>::value_type value) {
+    
+    if (!parent) {
+        return gocxx::base::Result<ContextPtr>(gocxx::errors::New("parent context is nil"));
+    }
+    
+    return gocxx::base::Result<ContextPtr>(
+        std::make_shared<ValueContext>(std::move(parent), &key, std::any(std::move(value))));
+}
+
+/**
+ * @brief Returns a context whose typed values are looked up in one hash map (not in Go)
+ *
+ * Walks the chain once and snapshots every typed value; use it after the
+ * middleware layers are in place when the values are read many times (e.g.
+ * per log line). Values added to the result later are looked up as usual.
+ * @param ctx Context to flatten
+ * @return Result containing the flattened context
+ */
+gocxx::base::Result<ContextPtr> Flatten(ContextPtr ctx);
+
 // Error constants - exact Go equivalents
 extern const std::string Canceled;        // "context canceled"
 extern const std::string DeadlineExceeded; // "context deadline exceeded"
 
+// Select support
+
+/**
+ * @brief Select case that fires when a context is canceled, built by doneCase()
+ */
+template<typename Fn>
+class DoneCase {
+public:
+    DoneCase(ContextPtr ctx, Fn fn) : ctx_(std::move(ctx)), fn_(std::move(fn)) {}
+
+    bool tryRun() {
+        if (!ctx_ || !ctx_->IsCanceled()) return false;
+        fn_();
+        return true;
+    }
+
+    void enlist(gocxx::base::ChanWaiter* waiter) {
+        registered_ = ctx_ && ctx_->AddDoneWaiter(waiter);
+    }
+
+    void delist(gocxx::base::ChanWaiter* waiter) {
+        if (registered_) ctx_->RemoveDoneWaiter(waiter);
+        registered_ = false;
+    }
+
+private:
+    ContextPtr ctx_;
+    Fn fn_;
+    bool registered_ = false;
+};
+
+/**
+ * @brief Create a select case that runs @p fn once @p ctx is canceled
+ *
+ * Go equivalent: `case <-ctx.Done():`. The select registers directly with
+ * the context's cancellation signal; no Done() channel copy is made.
+ *
+ * @code
+ * select(
+ *     recv(replies, [&](std::optional<Reply> r) { ... }),
+ *     doneCase(ctx, [&] { err = ctx->Err(); }),
+ *     timeoutCase(Seconds(1), [&] { timedOut = true; })
+ * );
+ * @endcode
+ */
+template<typename Fn>
+DoneCase<std::decay_t<Fn>> doneCase(ContextPtr ctx, Fn&& fn) {
+    return DoneCase<std::decay_t<Fn>>(std::move(ctx), std::forward<Fn>(fn));
+}
+
 // Utility functions for interoperability
 
 /**
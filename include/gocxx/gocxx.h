@@ -46,6 +46,9 @@
 #include <gocxx/io/io.h>
 #include <gocxx/io/io_errors.h>
 
+// bufio
+#include <gocxx/bufio/bufio.h>
+
 // errors
 #include <gocxx/errors/errors.h>
 
@@ -58,6 +61,10 @@
 // context
 #include <gocxx/context/context.h>
 
+// runtime
+#include <gocxx/runtime/scheduler.h>
+#include <gocxx/runtime/condvar.h>
+
 // encoding
 #include <gocxx/encoding/json.h>
 
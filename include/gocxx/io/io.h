@@ -100,6 +100,26 @@ namespace gocxx::io {
         virtual gocxx::base::Result<std::size_t> WriteByte(uint8_t byte) = 0;
     };
 
+    // Implemented by readers that can send their data to a writer themselves,
+    // e.g. with a kernel-side copy. Copy() hands the work to it when the source has it.
+    class WriterTo {
+    public:
+        virtual ~WriterTo() = default;
+        // Writes until there is no more data or an error occurs; EOF is not an error.
+        // Returns the number of bytes written.
+        virtual gocxx::base::Result<std::size_t> WriteTo(std::shared_ptr<Writer> w) = 0;
+    };
+
+    // Implemented by writers that can pull data from a reader themselves.
+    // Copy() hands the work to it when the destination has it.
+    class ReaderFrom {
+    public:
+        virtual ~ReaderFrom() = default;
+        // Reads from `r` until EOF or an error; EOF is not an error.
+        // Returns the number of bytes read.
+        virtual gocxx::base::Result<std::size_t> ReadFrom(std::shared_ptr<Reader> r) = 0;
+    };
+
     class PipeReader : public Reader {
     public:
         virtual gocxx::base::Result<std::size_t> Close() = 0;
@@ -112,7 +132,9 @@ namespace gocxx::io {
         virtual gocxx::base::Result<std::size_t> CloseWithError(std::shared_ptr<gocxx::errors::Error> err) = 0;
     };
 
-    // Function declarations
+    // Copy, CopyBuffer and CopyN read until EOF (or n bytes) and return the bytes
+    // written; EOF is not an error. They use src's WriterTo or, failing that,
+    // dst's ReaderFrom when available, and a buffered Read/Write loop otherwise.
     gocxx::base::Result<std::size_t> Copy(std::shared_ptr<Writer> dst, std::shared_ptr<Reader> src);
     gocxx::base::Result<std::size_t> CopyBuffer(std::shared_ptr<Writer> dst, std::shared_ptr<Reader> src, uint8_t* buf, std::size_t size);
     gocxx::base::Result<std::size_t> CopyN(std::shared_ptr<Writer> dst, std::shared_ptr<Reader> src, std::size_t n);
@@ -126,12 +148,34 @@ namespace gocxx::io {
         LimitedReader(std::shared_ptr<Reader> base, std::size_t n);
         gocxx::base::Result<std::size_t> Read(uint8_t* buffer, std::size_t size) override;
 
+        // For ReaderFrom implementations that read from the underlying reader
+        // directly: they copy at most Remaining() bytes and report them with Consumed().
+        const std::shared_ptr<Reader>& Underlying() const { return r; }
+        std::size_t Remaining() const { return remaining; }
+        void Consumed(std::size_t n) {
+            remaining -= n;
+            totalRead += n;
+        }
+
     private:
         std::shared_ptr<Reader> r;
         std::size_t remaining;
         std::size_t totalRead = 0;
     };
 
+    struct PipeOptions {
+        // Bytes buffered between the ends; a writer blocks while the buffer is full.
+        // 0 selects zero-copy mode.
+        std::size_t bufferSize = 64 * 1024;
+
+        // Unbuffered, like Go's io.Pipe: Write() blocks until readers have copied
+        // every byte straight out of the caller's buffer.
+        bool zeroCopy = false;
+    };
+
+    // In-memory pipe: data written to the writer end can be read from the reader end.
+    // Concurrent writes are serialized, so each one is read contiguously.
     std::pair<std::shared_ptr<PipeReader>, std::shared_ptr<PipeWriter>> Pipe();
+    std::pair<std::shared_ptr<PipeReader>, std::shared_ptr<PipeWriter>> Pipe(const PipeOptions& options);
 
 } // namespace gocxx::io
\ No newline at end of file
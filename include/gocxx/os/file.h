@@ -144,18 +144,35 @@ namespace gocxx::os {
     extern std::shared_ptr<gocxx::errors::Error> ErrNoDeadline;
     extern std::shared_ptr<gocxx::errors::Error> ErrDeadlineExceeded;
 
+    // One buffer of a vectored read or write, like struct iovec
+    struct IOVec {
+        uint8_t* data;
+        std::size_t size;
+    };
+
+    struct ConstIOVec {
+        const uint8_t* data;
+        std::size_t size;
+    };
+
     // File represents an open file descriptor
     class File : public gocxx::io::Reader, 
                  public gocxx::io::Writer, 
                  public gocxx::io::Closer,
                  public gocxx::io::ReaderAt,
                  public gocxx::io::WriterAt,
-                 public gocxx::io::Seeker {
+                 public gocxx::io::Seeker,
+                 public gocxx::io::WriterTo,
+                 public gocxx::io::ReaderFrom {
     private:
         int fd;
         std::string name;
         bool closed;
 
+        // Kernel-side copy from src (copy_file_range, splice or sendfile on Linux).
+        // Sets done unless the remaining bytes still need a Read/Write loop.
+        gocxx::base::Result<std::size_t> copyFrom(File& src, std::size_t limit, bool& done);
+
     public:
         explicit File(int file_descriptor, std::string filename);
         ~File();
@@ -169,14 +186,30 @@ namespace gocxx::os {
         // Closer interface
         void close() override;
 
-        // ReaderAt interface
+        // ReaderAt interface: fills the whole buffer or returns an error (io::ErrEOF
+        // at end of file). Leaves the file offset alone, so it is safe to call
+        // concurrently, as is WriteAt.
         gocxx::base::Result<std::size_t> ReadAt(uint8_t* buffer, std::size_t size, std::size_t offset) override;
 
         // WriterAt interface
         gocxx::base::Result<std::size_t> WriteAt(const uint8_t* buffer, std::size_t size, std::size_t offset) override;
 
+        // Vectored ReadAt/WriteAt (preadv/pwritev): the buffers are filled or written
+        // in order starting at offset, in as few system calls as possible.
+        // Like ReadAt, ReadvAt fills every buffer or returns an error (io::ErrEOF at end of file).
+        gocxx::base::Result<std::size_t> ReadvAt(const std::vector<IOVec>& buffers, std::size_t offset);
+        gocxx::base::Result<std::size_t> WritevAt(const std::vector<ConstIOVec>& buffers, std::size_t offset);
+
         // Seeker interface
         gocxx::base::Result<std::size_t> Seek(std::size_t offset, gocxx::io::whence whence) override;
+
+        // WriterTo interface: file to file without copying through user space
+        gocxx::base::Result<std::size_t> WriteTo(std::shared_ptr<gocxx::io::Writer> w) override;
+
+        // ReaderFrom interface: file or pipe (optionally behind an io::LimitedReader)
+        // to file without copying through user space
+        gocxx::base::Result<std::size_t> ReadFrom(std::shared_ptr<gocxx::io::Reader> r) override;
+
         // File-specific methods
         gocxx::base::Result<void> Chdir();
 
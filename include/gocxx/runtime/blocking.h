@@ -0,0 +1,64 @@
+#pragma once
+#include <chrono>
+#include <mutex>
+
+namespace gocxx::runtime {
+
+namespace detail {
+    struct Machine;
+    struct Task;
+
+    /// The scheduler thread state of the calling thread; nullptr off the scheduler or when nested.
+    Machine* EnterBlocking();
+    void ExitBlocking(Machine* machine);
+
+    /**
+     * The task running on the calling thread, or nullptr outside a task.
+     * Always nullptr without fiber support: tasks then block their thread.
+     */
+    Task* CurrentTask();
+
+    /**
+     * Suspend @p self, the calling task, until Ready(self). If @p unlock is
+     * set it is released once the task is off its stack, so a waker that
+     * takes the mutex always finds the task parked or about to park.
+     * A Ready() that arrives before Park() makes it return immediately.
+     */
+    void Park(Task* self, std::mutex* unlock);
+
+    /// Make a task suspended in Park() runnable again. Callable from any thread.
+    void Ready(Task* task);
+
+    /// Suspend the calling task for @p d. Returns false if not called from a task.
+    bool SleepTask(std::chrono::nanoseconds d);
+}
+
+/**
+ * @brief Scope in which the calling thread may block in the operating system.
+ *
+ * A task started with gocxx::Go() runs on one of the scheduler's GOMAXPROCS
+ * processors. The channel, select, sync and sleep primitives suspend the
+ * task rather than its thread (see CondVar). Other blocking calls made from
+ * a task (a blocking read, a foreign lock) hold the thread; wrap them in a
+ * region so the thread hands its processor and local run queue to another
+ * OS thread for the duration and takes a processor back when it returns.
+ * This is what Go does around system calls.
+ *
+ * Off the scheduler, and when nested, a region costs one function call.
+ */
+class BlockingRegion {
+public:
+    BlockingRegion() : machine_(detail::EnterBlocking()) {}
+
+    ~BlockingRegion() {
+        if (machine_) detail::ExitBlocking(machine_);
+    }
+
+    BlockingRegion(const BlockingRegion&) = delete;
+    BlockingRegion& operator=(const BlockingRegion&) = delete;
+
+private:
+    detail::Machine* machine_;
+};
+
+} // namespace gocxx::runtime
@@ -0,0 +1,99 @@
+#pragma once
+#include "blocking.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+
+namespace gocxx::runtime {
+
+/**
+ * @brief Condition variable that suspends tasks instead of their threads.
+ *
+ * A drop-in for std::condition_variable with std::unique_lock<std::mutex>.
+ * Called from a task started with gocxx::Go(), wait() queues the task and
+ * switches its thread to other tasks; notify_one()/notify_all() make it
+ * runnable again. Called from any other thread it blocks that thread, inside
+ * a BlockingRegion. Both kinds of waiter may share one CondVar.
+ *
+ * As with std::condition_variable, change the state waited on under the
+ * mutex, or a notification can slip in between the waiter's check and its
+ * wait.
+ */
+class CondVar {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    CondVar() = default;
+    CondVar(const CondVar&) = delete;
+    CondVar& operator=(const CondVar&) = delete;
+
+    void wait(std::unique_lock<std::mutex>& lock) {
+        if (detail::Task* self = detail::CurrentTask()) {
+            waitTask(self, lock);
+            return;
+        }
+        BlockingRegion blocking;
+        cv_.wait(lock);
+    }
+
+    template <typename Predicate>
+    void wait(std::unique_lock<std::mutex>& lock, Predicate pred) {
+        while (!pred()) wait(lock);
+    }
+
+    /**
+     * @return false if @p deadline passed before a notification
+     */
+    bool wait_until(std::unique_lock<std::mutex>& lock, Clock::time_point deadline) {
+        if (detail::Task* self = detail::CurrentTask()) {
+            return waitTaskUntil(self, lock, deadline);
+        }
+        BlockingRegion blocking;
+        return cv_.wait_until(lock, deadline) == std::cv_status::no_timeout;
+    }
+
+    /**
+     * @return pred(), evaluated one last time at the deadline
+     */
+    template <typename Predicate>
+    bool wait_until(std::unique_lock<std::mutex>& lock, Clock::time_point deadline, Predicate pred) {
+        while (!pred()) {
+            if (!wait_until(lock, deadline)) return pred();
+        }
+        return true;
+    }
+
+    void notify_one() {
+        if (taskWaiters_.load(std::memory_order_seq_cst) != 0 && notifyTasks(false)) return;
+        cv_.notify_one();
+    }
+
+    void notify_all() {
+        if (taskWaiters_.load(std::memory_order_seq_cst) != 0) notifyTasks(true);
+        cv_.notify_all();
+    }
+
+private:
+    struct Waiter {
+        detail::Task* task;
+        Waiter* prev = nullptr;
+        Waiter* next = nullptr;
+        bool linked = false;
+    };
+
+    void waitTask(detail::Task* self, std::unique_lock<std::mutex>& lock);
+    bool waitTaskUntil(detail::Task* self, std::unique_lock<std::mutex>& lock, Clock::time_point deadline);
+    bool notifyTasks(bool all);
+    void link(Waiter* w);
+    bool unlink(Waiter* w);
+
+    std::condition_variable cv_;            // Waiting threads
+    std::mutex tasksMtx_;                   // Guards the task list
+    Waiter* head_ = nullptr;                // Waiting tasks, FIFO; nodes live on their stacks
+    Waiter* tail_ = nullptr;
+    std::atomic<uint32_t> taskWaiters_{0};
+};
+
+} // namespace gocxx::runtime
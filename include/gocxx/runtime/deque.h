@@ -0,0 +1,150 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <type_traits>
+#include <vector>
+
+namespace gocxx::runtime {
+
+/**
+ * @brief Chase-Lev work-stealing deque.
+ *
+ * One owner thread pushes and pops at the bottom (LIFO, so recently spawned
+ * work stays cache-hot); any number of thieves steal from the top (FIFO).
+ * Push and Pop are wait-free apart from growing the ring, and only the last
+ * element is contended. Follows Lê, Pop, Cohen and Zappa Nardelli, "Correct
+ * and Efficient Work-Stealing for Weak Memory Models" (PPoPP 2013).
+ *
+ * The ring doubles when full. Old rings are kept until the deque is
+ * destroyed because a thief may still be reading one.
+ *
+ * @tparam T Trivially copyable element, typically a pointer
+ */
+template<typename T>
+class WorkStealingDeque {
+    static_assert(std::is_trivially_copyable_v<T>, "WorkStealingDeque holds trivially copyable values");
+
+    struct Ring {
+        explicit Ring(std::size_t capacity)
+            : mask(capacity - 1), slots(new std::atomic<T>[capacity]) {}
+
+        std::size_t capacity() const { return mask + 1; }
+        T load(int64_t i) const { return slots[static_cast<std::size_t>(i) & mask].load(std::memory_order_relaxed); }
+        void store(int64_t i, T value) { slots[static_cast<std::size_t>(i) & mask].store(value, std::memory_order_relaxed); }
+
+        std::size_t mask;
+        std::unique_ptr<std::atomic<T>[]> slots;
+    };
+
+public:
+    /**
+     * @param capacity Initial capacity, rounded up to a power of two
+     */
+    explicit WorkStealingDeque(std::size_t capacity = 256) {
+        std::size_t size = 2;
+        while (size < capacity) size <<= 1;
+        rings_.push_back(std::make_unique<Ring>(size));
+        ring_.store(rings_.back().get(), std::memory_order_relaxed);
+    }
+
+    WorkStealingDeque(const WorkStealingDeque&) = delete;
+    WorkStealingDeque& operator=(const WorkStealingDeque&) = delete;
+
+    /**
+     * @brief Add @p value at the bottom. Owner only.
+     */
+    void Push(T value) {
+        int64_t b = bottom_.load(std::memory_order_relaxed);
+        int64_t t = top_.load(std::memory_order_acquire);
+        Ring* ring = ring_.load(std::memory_order_relaxed);
+        if (b - t > static_cast<int64_t>(ring->capacity()) - 1) {
+            ring = grow(ring, t, b);
+        }
+        ring->store(b, value);
+        std::atomic_thread_fence(std::memory_order_release);
+        bottom_.store(b + 1, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Take the most recently pushed value. Owner only.
+     */
+    std::optional<T> Pop() {
+        int64_t b = bottom_.load(std::memory_order_relaxed) - 1;
+        Ring* ring = ring_.load(std::memory_order_relaxed);
+        bottom_.store(b, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t t = top_.load(std::memory_order_relaxed);
+
+        if (t > b) {
+            // Empty
+            bottom_.store(b + 1, std::memory_order_relaxed);
+            return std::nullopt;
+        }
+
+        T value = ring->load(b);
+        if (t == b) {
+            // Last element: race the thieves for it
+            bool won = top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                                    std::memory_order_relaxed);
+            bottom_.store(b + 1, std::memory_order_relaxed);
+            if (!won) return std::nullopt;
+        }
+        return value;
+    }
+
+    /**
+     * @brief Take the oldest value. Any thread.
+     *
+     * Returns nullopt if the deque is empty or another thread won the race
+     * for the top element.
+     */
+    std::optional<T> Steal() {
+        int64_t t = top_.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t b = bottom_.load(std::memory_order_acquire);
+        if (t >= b) return std::nullopt;
+
+        Ring* ring = ring_.load(std::memory_order_acquire);
+        T value = ring->load(t);
+        if (!top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                          std::memory_order_relaxed)) {
+            return std::nullopt;
+        }
+        return value;
+    }
+
+    /**
+     * @brief Approximate number of values; exact when called by the owner with no thieves.
+     */
+    std::size_t Size() const {
+        int64_t b = bottom_.load(std::memory_order_relaxed);
+        int64_t t = top_.load(std::memory_order_relaxed);
+        return b > t ? static_cast<std::size_t>(b - t) : 0;
+    }
+
+    bool Empty() const {
+        return Size() == 0;
+    }
+
+private:
+    Ring* grow(Ring* old, int64_t t, int64_t b) {
+        auto bigger = std::make_unique<Ring>(old->capacity() * 2);
+        for (int64_t i = t; i < b; ++i) {
+            bigger->store(i, old->load(i));
+        }
+        Ring* ring = bigger.get();
+        rings_.push_back(std::move(bigger));
+        ring_.store(ring, std::memory_order_release);
+        return ring;
+    }
+
+    alignas(64) std::atomic<int64_t> top_{0};
+    alignas(64) std::atomic<int64_t> bottom_{0};
+    std::atomic<Ring*> ring_{nullptr};
+    std::vector<std::unique_ptr<Ring>> rings_;  // Owner only
+};
+
+} // namespace gocxx::runtime
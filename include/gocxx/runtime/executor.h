@@ -0,0 +1,272 @@
+#pragma once
+
+/// Set when the C++20 awaitables (recvAsync, sendAsync, SleepAsync, DoneAsync) are available.
+#if defined(GOCXX_ENABLE_COROUTINES) && defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+#define GOCXX_HAS_COROUTINES 1
+#else
+#define GOCXX_HAS_COROUTINES 0
+#endif
+
+#if GOCXX_HAS_COROUTINES
+
+#if defined(_MSC_VER)
+#define GOCXX_EXECUTOR_NOINLINE __declspec(noinline)
+#else
+#define GOCXX_EXECUTOR_NOINLINE __attribute__((noinline))
+#endif
+
+#include "condvar.h"
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+namespace gocxx::runtime {
+
+namespace detail {
+    template <typename Promise>
+    struct AsyncFinal;
+}
+
+/**
+ * @brief Single-threaded run loop that resumes suspended coroutines.
+ *
+ * Awaiters hand the executor intrusive Work items (embedded in the
+ * awaiter, so posting never allocates) from whatever thread completes
+ * them: a channel operation, the timer thread, a cancel. Run() resumes
+ * them one at a time on the calling thread, like a Go scheduler with one
+ * processor.
+ *
+ * @code
+ * runtime::Async consumer(Chan<int> ch) {
+ *     while (auto v = co_await ch.recvAsync()) use(*v);
+ * }
+ *
+ * runtime::Executor exec;
+ * exec.Spawn(consumer(ch));
+ * exec.Run();  // Returns once consumer() has finished
+ * @endcode
+ *
+ * Run() may itself be called from a gocxx::Go() task: it then parks the
+ * task, not the thread, while idle.
+ */
+class Executor {
+public:
+    /**
+     * @brief A unit of work queued on an executor. Owned by the poster.
+     */
+    struct Work {
+        void (*run)(Work*) = nullptr;
+        Work* next = nullptr;
+    };
+
+    Executor() = default;
+
+    /**
+     * @brief Waits for every spawned coroutine to finish, running their work on the calling thread.
+     *
+     * A pending await (a sleep, a channel operation, DoneAsync()) posts to
+     * the executor when it completes, so the executor cannot go away first.
+     * Coroutines that Stop() left suspended are resumed here; one that is
+     * never woken keeps this waiting, as with Scheduler's destructor.
+     */
+    ~Executor() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopped_ = false;
+        }
+        Run();
+    }
+
+    Executor(const Executor&) = delete;
+    Executor& operator=(const Executor&) = delete;
+
+    /**
+     * @brief The executor whose Run() is running a work item on the calling thread, or nullptr.
+     */
+    static Executor* Current() { return currentSlot(); }
+
+    /**
+     * @brief Queue @p work to run on the Run() thread. Callable from any thread.
+     *
+     * @p work must stay valid until it has run.
+     */
+    void Post(Work* work) {
+        work->next = nullptr;
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (tail_) tail_->next = work; else head_ = work;
+        tail_ = work;
+        cv_.notify_one();
+    }
+
+    /**
+     * @brief Start @p task on this executor; it first runs inside Run().
+     */
+    template <typename Task>
+    void Spawn(Task task) {
+        auto handle = task.release();
+        auto& promise = handle.promise();
+        promise.exec_ = this;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            ++live_;
+        }
+        Post(&promise.start_);
+    }
+
+    /**
+     * @brief Run queued work until every spawned coroutine has finished or Stop() is called.
+     */
+    void Run() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (!stopped_) {
+            if (!head_) {
+                if (live_ == 0) break;
+                cv_.wait(lock);
+                continue;
+            }
+            Work* work = head_;
+            head_ = work->next;
+            if (!head_) tail_ = nullptr;
+            lock.unlock();
+            // Set per item, not for the whole of Run(): a task parked in
+            // cv_.wait() may resume on another thread, and current_ is per thread
+            Executor* outer = std::exchange(currentSlot(), this);
+            work->run(work);
+            currentSlot() = outer;  // The work item may have parked and moved threads
+            lock.lock();
+        }
+    }
+
+    /**
+     * @brief Make Run() return after the work item in progress.
+     *
+     * Suspended coroutines stay suspended until Run() is called again or
+     * the executor is destroyed.
+     */
+    void Stop() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopped_ = true;
+        cv_.notify_all();
+    }
+
+    /**
+     * @brief Spawned coroutines that have not finished.
+     */
+    std::size_t Live() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return live_;
+    }
+
+private:
+    template <typename Promise>
+    friend struct detail::AsyncFinal;
+
+    // Reading the thread-local through an opaque call keeps the compiler
+    // from reusing an address it computed before a task moved threads, as
+    // CurrentMachine() does in the scheduler
+    GOCXX_EXECUTOR_NOINLINE static Executor*& currentSlot() {
+#if defined(__GNUC__)
+        asm volatile("" ::: "memory");
+#endif
+        return current_;
+    }
+
+    void finished() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (--live_ == 0) cv_.notify_all();
+    }
+
+    mutable std::mutex mutex_;
+    CondVar cv_;
+    Work* head_ = nullptr;
+    Work* tail_ = nullptr;
+    std::size_t live_ = 0;
+    bool stopped_ = false;
+    static inline thread_local Executor* current_ = nullptr;
+};
+
+namespace detail {
+
+    /// Frees the coroutine frame at the end and tells its executor.
+    template <typename Promise>
+    struct AsyncFinal {
+        bool await_ready() const noexcept { return false; }
+        void await_suspend(std::coroutine_handle<Promise> h) const noexcept {
+            Executor* exec = h.promise().exec_;
+            h.destroy();
+            if (exec) exec->finished();
+        }
+        void await_resume() const noexcept {}
+    };
+
+    /// Resumes a coroutine from an executor's queue.
+    struct ResumeWork : Executor::Work {
+        std::coroutine_handle<> handle;
+
+        ResumeWork() {
+            run = [](Executor::Work* w) { static_cast<ResumeWork*>(w)->handle.resume(); };
+        }
+    };
+
+    /// The executor an awaiter resumes on; awaiting outside Run() is a usage error.
+    inline Executor& AwaitingExecutor(const char* op) {
+        Executor* exec = Executor::Current();
+        if (!exec) throw std::runtime_error(std::string(op) + ": co_await outside Executor::Run()");
+        return *exec;
+    }
+
+} // namespace detail
+
+/**
+ * @brief Fire-and-forget coroutine started with Executor::Spawn().
+ *
+ * Suspended until spawned; its frame is freed when it returns. An
+ * exception escaping it terminates the program, as with gocxx::Go().
+ */
+class Async {
+public:
+    struct promise_type {
+        Async get_return_object() {
+            return Async(std::coroutine_handle<promise_type>::from_promise(*this));
+        }
+        std::suspend_always initial_suspend() const noexcept { return {}; }
+        detail::AsyncFinal<promise_type> final_suspend() const noexcept { return {}; }
+        void return_void() const noexcept {}
+        void unhandled_exception() const noexcept { std::terminate(); }
+
+        Executor* exec_ = nullptr;
+        detail::ResumeWork start_;
+    };
+
+    Async(Async&& other) noexcept : handle_(std::exchange(other.handle_, nullptr)) {}
+    Async& operator=(Async&&) = delete;
+
+    /**
+     * @brief Destroys a coroutine that was never spawned.
+     */
+    ~Async() {
+        if (handle_) handle_.destroy();
+    }
+
+    /**
+     * @brief Give up ownership of the coroutine; used by Executor::Spawn().
+     */
+    std::coroutine_handle<promise_type> release() {
+        auto h = std::exchange(handle_, nullptr);
+        h.promise().start_.handle = h;
+        return h;
+    }
+
+private:
+    explicit Async(std::coroutine_handle<promise_type> h) : handle_(h) {}
+
+    std::coroutine_handle<promise_type> handle_;
+};
+
+} // namespace gocxx::runtime
+
+#endif // GOCXX_HAS_COROUTINES
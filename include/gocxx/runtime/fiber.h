@@ -0,0 +1,159 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <vector>
+
+/// Set when tasks run on their own stacks with a hand-written context switch.
+#if defined(__linux__) && (defined(__x86_64__) || defined(__aarch64__))
+#define GOCXX_HAS_FIBERS 1
+#else
+#define GOCXX_HAS_FIBERS 0
+#endif
+
+/// Set in AddressSanitizer builds, which must be told about every stack switch.
+#if defined(__SANITIZE_ADDRESS__)
+#define GOCXX_ASAN 1
+#elif defined(__has_feature)
+#if __has_feature(address_sanitizer)
+#define GOCXX_ASAN 1
+#endif
+#endif
+#ifndef GOCXX_ASAN
+#define GOCXX_ASAN 0
+#endif
+
+#if GOCXX_HAS_FIBERS && GOCXX_ASAN
+#include <sanitizer/asan_interface.h>
+#include <sanitizer/common_interface_defs.h>
+#endif
+
+namespace gocxx::runtime::detail {
+
+#if GOCXX_HAS_FIBERS
+
+/**
+ * @brief Bounds of the stack a context runs on, as AddressSanitizer wants them.
+ */
+struct StackSpan {
+    const void* bottom = nullptr;
+    std::size_t size = 0;
+};
+
+/**
+ * @brief A task stack: an mmap'd region with an inaccessible guard page below it.
+ *
+ * Pages are committed by the kernel as the task touches them, so an idle
+ * task costs only the few pages its frames occupy. Running past the end
+ * faults on the guard page instead of corrupting a neighbour.
+ *
+ * Each guarded stack takes two of the process's vm.max_map_count mappings
+ * (65530 by default). StackPool guards at most a quarter of that many
+ * stacks at once and maps the rest without a guard page.
+ */
+struct Stack {
+    void* base = nullptr;    // Start of the mapping (the guard page, if any)
+    std::size_t size = 0;    // Mapping size, guard page included
+    bool guarded = false;
+
+    void* Top() const { return static_cast<char*>(base) + size; }
+    StackSpan Span() const { return {base, size}; }
+};
+
+/**
+ * @brief Free list of stacks of one size, so spawning a task rarely calls mmap.
+ */
+class StackPool {
+public:
+    /**
+     * @param stackSize Usable bytes per stack, rounded up to whole pages
+     * @param maxCached Free stacks kept for reuse; the rest are unmapped
+     */
+    explicit StackPool(std::size_t stackSize, std::size_t maxCached = 1024);
+    ~StackPool();
+
+    StackPool(const StackPool&) = delete;
+    StackPool& operator=(const StackPool&) = delete;
+
+    /**
+     * @brief A stack from the pool, or a fresh mapping. Throws std::bad_alloc.
+     */
+    Stack Acquire();
+
+    void Release(Stack stack);
+
+private:
+    void unmap(const Stack& stack);
+    void unpoison(const Stack& stack) const;
+
+    std::mutex mutex_;
+    std::vector<Stack> free_;
+    std::size_t stackSize_;
+    std::size_t guardSize_;
+    std::size_t maxCached_;
+    static inline std::atomic<std::size_t> guarded_{0};  // Process-wide, like the mapping limit
+};
+
+using ContextEntry = void (*)(void* arg);
+
+/**
+ * @brief Lay out @p stack so the first SwitchContext() to the result calls entry(arg).
+ *
+ * @p entry must never return; it ends by switching away for good.
+ */
+void* MakeContext(const Stack& stack, ContextEntry entry, void* arg);
+
+extern "C" void gocxx_switch_context(void** from, void* to);
+
+/**
+ * @brief Save the callee-saved registers and stack pointer to @p *from and resume @p to.
+ *
+ * @p toStack is the stack @p to runs on. Returns when something switches
+ * back to @p *from, with the stack that did so in AddressSanitizer builds
+ * (an empty span otherwise); that is how a task learns its thread's stack.
+ */
+inline StackSpan SwitchContext(void** from, void* to, StackSpan toStack) {
+#if GOCXX_ASAN
+    void* fakeStack = nullptr;
+    __sanitizer_start_switch_fiber(&fakeStack, toStack.bottom, toStack.size);
+    gocxx_switch_context(from, to);
+    StackSpan back;
+    __sanitizer_finish_switch_fiber(fakeStack, &back.bottom, &back.size);
+    return back;
+#else
+    (void)toStack;
+    gocxx_switch_context(from, to);
+    return {};
+#endif
+}
+
+/**
+ * @brief SwitchContext() away from a context that is never resumed.
+ *
+ * Lets AddressSanitizer free the context's fake stack.
+ */
+inline void ExitContext(void** from, void* to, StackSpan toStack) {
+#if GOCXX_ASAN
+    __sanitizer_start_switch_fiber(nullptr, toStack.bottom, toStack.size);
+#else
+    (void)toStack;
+#endif
+    gocxx_switch_context(from, to);
+}
+
+/**
+ * @brief First call on a context made by MakeContext(); returns the stack that started it.
+ *
+ * Like the value SwitchContext() returns, empty unless AddressSanitizer is on.
+ */
+inline StackSpan EnterContext() {
+    StackSpan from;
+#if GOCXX_ASAN
+    __sanitizer_finish_switch_fiber(nullptr, &from.bottom, &from.size);
+#endif
+    return from;
+}
+
+#endif // GOCXX_HAS_FIBERS
+
+} // namespace gocxx::runtime::detail
@@ -0,0 +1,180 @@
+#pragma once
+#include "blocking.h"
+#include "fiber.h"
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace gocxx::runtime {
+
+namespace detail {
+    struct Task;
+    struct Processor;
+}
+
+/**
+ * @brief Yield the processor so other runnable tasks can run.
+ * Go equivalent: runtime.Gosched()
+ *
+ * Outside a task this yields the calling thread.
+ */
+void Gosched();
+
+/**
+ * @brief M:N task scheduler behind gocxx::Go().
+ *
+ * Tasks run on OS threads that each hold one of a fixed number of
+ * processors (GOMAXPROCS). Every processor owns a Chase-Lev run queue:
+ * a task spawned from a task goes onto its processor's queue, and tasks
+ * spawned from other threads go onto a global injection queue. A thread
+ * whose processor runs dry takes a batch from the global queue, then
+ * steals from the other processors, and only then releases the processor
+ * and sleeps.
+ *
+ * Each task runs on its own stack (see StackPool), taken from a pool when
+ * the task first runs. A task that waits on a channel, select, sync
+ * primitive or Sleep is switched out and its thread goes on with the next
+ * runnable task; whoever wakes it puts it back on a run queue, and it may
+ * resume on another thread. A parked task costs the stack pages it has
+ * touched, typically a few KiB, and no thread. Blocking system calls still
+ * hold a thread: they hand the processor to another thread for the
+ * duration (see BlockingRegion).
+ *
+ * Without fiber support (GOCXX_HAS_FIBERS is 0) tasks run to completion on
+ * the thread that picked them up, and every waiting task holds a thread.
+ */
+class Scheduler {
+public:
+    /// Usable stack bytes per task unless the constructor is given another size.
+    static constexpr std::size_t DefaultStackSize = 256 * 1024;
+
+    /**
+     * @param procs Number of processors; 0 picks DefaultProcs()
+     * @param stackSize Stack bytes per task; 0 picks DefaultStackSize. Stacks
+     *                  do not grow: overflowing one faults on its guard page.
+     */
+    explicit Scheduler(std::size_t procs = 0, std::size_t stackSize = 0);
+
+    /**
+     * @brief Waits for every spawned task to finish, then stops the threads.
+     *
+     * Tasks parked forever (on a channel nobody sends to) keep this waiting.
+     */
+    ~Scheduler();
+
+    Scheduler(const Scheduler&) = delete;
+    Scheduler& operator=(const Scheduler&) = delete;
+
+    /**
+     * @brief The process-wide scheduler used by gocxx::Go(). Started on first use.
+     */
+    static Scheduler& Global();
+
+    /**
+     * @brief $GOMAXPROCS if set to a positive number, else the number of CPUs.
+     */
+    static std::size_t DefaultProcs();
+
+    /**
+     * @brief Run @p fn on the scheduler.
+     *
+     * An exception escaping @p fn terminates the program, as with std::thread.
+     */
+    void Go(std::function<void()> fn);
+
+    /**
+     * @brief Number of processors (tasks that can run in parallel).
+     */
+    std::size_t Procs() const { return procs_.size(); }
+
+    /**
+     * @brief Tasks spawned and not yet finished.
+     */
+    std::size_t NumTasks() const { return live_.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief OS threads started so far, including ones blocked in tasks or idle.
+     */
+    std::size_t NumThreads() const;
+
+private:
+    friend detail::Machine* detail::EnterBlocking();
+    friend void detail::ExitBlocking(detail::Machine*);
+    friend void detail::Ready(detail::Task*);
+
+    void threadMain();
+    detail::Task* findWork(detail::Machine& m);
+    void run(detail::Machine& m, detail::Task* task);
+    void finish(detail::Task* task);
+    void enqueue(detail::Task* task);
+    void enqueueGlobal(detail::Task* task);
+    void wakeLocked();
+    void releaseBlocking(detail::Machine& m);
+    void reacquire(detail::Machine& m);
+
+    std::vector<std::unique_ptr<detail::Processor>> procs_;
+#if GOCXX_HAS_FIBERS
+    detail::StackPool stacks_;
+#endif
+
+    mutable std::mutex mutex_;                // Guards everything below up to the atomics
+    std::condition_variable wake_;            // Threads waiting for a processor
+    std::condition_variable allDone_;         // Destructor waiting for live_ == 0
+    std::vector<detail::Processor*> idle_;    // Processors no thread holds
+    std::deque<detail::Task*> global_;        // Injection queue
+    std::vector<std::thread> threads_;
+    std::size_t sleeping_ = 0;                // Threads blocked on wake_
+    std::size_t waking_ = 0;                  // Woken or started, not yet holding a processor
+    std::size_t notifies_ = 0;                // Wakeups sent to sleepers and not yet taken
+    bool stopping_ = false;
+
+    std::atomic<std::size_t> queued_{0};      // Runnable tasks in any run queue
+    std::atomic<std::size_t> idleCount_{0};   // idle_.size(), readable without the lock
+    std::atomic<std::size_t> live_{0};       // Spawned and not finished, parked ones included
+    std::atomic<bool> draining_{false};
+};
+
+/**
+ * @brief Number of processors of the global scheduler.
+ * Go equivalent: runtime.GOMAXPROCS(0)
+ */
+inline std::size_t GOMAXPROCS() {
+    return Scheduler::Global().Procs();
+}
+
+/**
+ * @brief Tasks spawned with gocxx::Go() that have not finished.
+ * Go equivalent: runtime.NumGoroutine()
+ */
+inline std::size_t NumGoroutine() {
+    return Scheduler::Global().NumTasks();
+}
+
+} // namespace gocxx::runtime
+
+namespace gocxx {
+
+/**
+ * @brief Run @p fn concurrently on the global scheduler.
+ * Go equivalent: go fn()
+ *
+ * @code
+ * gocxx::sync::WaitGroup wg;
+ * for (auto& req : requests) {
+ *     wg.Add(1);
+ *     gocxx::Go([&wg, &req] { handle(req); wg.Done(); });
+ * }
+ * wg.Wait();
+ * @endcode
+ */
+inline void Go(std::function<void()> fn) {
+    runtime::Scheduler::Global().Go(std::move(fn));
+}
+
+} // namespace gocxx
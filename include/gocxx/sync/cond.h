@@ -1,8 +1,10 @@
 #pragma once
+#include <atomic>
 #include <mutex>
-#include <condition_variable>
 #include <functional>
 #include "mutex.h"
+#include "waitpolicy.h"
+#include <gocxx/runtime/condvar.h>
 
 
 namespace gocxx::sync {
@@ -11,36 +13,85 @@ namespace gocxx::sync {
  * @brief A condition variable, similar to Go's sync.Cond.
  *
  * Used for signaling between threads that a condition or state has changed.
- * Internally wraps a `std::condition_variable`.
+ * Each notification bumps a generation counter; a waiter spins and yields on
+ * that counter according to its `WaitPolicy` before parking on an internal
+ * `runtime::CondVar`, which suspends a calling task rather than its thread.
+ * As with any condition variable, `Wait` may return
+ * without the caller's condition holding, so always wait in a loop.
  */
 class Cond {
-    std::condition_variable cv_;
+    std::atomic<uint64_t> generation_{0};
+    std::atomic<uint32_t> sleepers_{0};
+    std::mutex parkMtx_;
+    gocxx::runtime::CondVar cv_;
+    WaitPolicy policy_;
+    WaitStats stats_;
 
 public:
+    explicit Cond(WaitPolicy policy = WaitPolicy()) : policy_(policy) {}
+
     /**
      * @brief Blocks the calling thread until notified.
      *
-     * The thread must hold a `std::unique_lock<std::mutex>` before calling this.
+     * The thread must hold a `UniqueLock` on a `sync::Mutex` before calling this.
      * It will release the lock while waiting and re-acquire it upon wake-up.
      *
      * @param lock A unique lock that is held before calling wait.
      */
     void Wait(UniqueLock& mtx) {
-        cv_.wait(mtx);
+        const uint64_t seen = generation_.load(std::memory_order_acquire);
+        mtx.unlock();
+
+        WaitPhase phase = SpinWait(policy_, [&] {
+            return generation_.load(std::memory_order_acquire) != seen;
+        });
+        if (phase == WaitPhase::Park) {
+            std::unique_lock<std::mutex> park(parkMtx_);
+            // Pairs with the generation bump in notify(): one side sees the other
+            sleepers_.fetch_add(1, std::memory_order_seq_cst);
+            while (generation_.load(std::memory_order_seq_cst) == seen) {
+                cv_.wait(park);
+            }
+            sleepers_.fetch_sub(1, std::memory_order_relaxed);
+        }
+        stats_.Record(phase);
+
+        mtx.lock();
     }
 
     /**
      * @brief Wakes one thread that is waiting on this condition variable.
+     *
+     * Waiters still in their spin or yield phase may also return.
      */
     void NotifyOne() {
-        cv_.notify_one();
+        notify(false);
     }
 
     /**
      * @brief Wakes all threads waiting on this condition variable.
      */
     void NotifyAll() {
-        cv_.notify_all();
+        notify(true);
+    }
+
+    /**
+     * @brief Counts of how each `Wait` call was resolved.
+     */
+    WaitCounts Stats() const {
+        return stats_.Snapshot();
+    }
+
+private:
+    void notify(bool all) {
+        generation_.fetch_add(1, std::memory_order_seq_cst);
+        if (sleepers_.load(std::memory_order_seq_cst) == 0) return;
+        std::lock_guard<std::mutex> park(parkMtx_);
+        if (all) {
+            cv_.notify_all();
+        } else {
+            cv_.notify_one();
+        }
     }
 };
 
@@ -0,0 +1,41 @@
+#pragma once
+#include <cstdint>
+
+namespace gocxx::sync::detail {
+
+    /**
+     * @brief Epoch-based reclamation for lock-free readers
+     *
+     * A reader wraps every access to shared nodes in an EpochGuard. A writer
+     * that unlinks a node hands it to Retire() instead of deleting it, and
+     * it is freed once every guard that might still see it has ended. The
+     * global epoch advances when all active guards have observed the current
+     * one, and nodes retired two epochs back are freed.
+     *
+     * Guards are per thread and may nest. Code inside a guard must not park
+     * a task, since the task could resume on another thread.
+     */
+    class EpochGuard {
+    public:
+        EpochGuard();
+        ~EpochGuard();
+
+        EpochGuard(const EpochGuard&) = delete;
+        EpochGuard& operator=(const EpochGuard&) = delete;
+
+    private:
+        void* record_;
+    };
+
+    /// Call @p deleter on @p ptr once no EpochGuard can reach it
+    void EpochRetire(void* ptr, void (*deleter)(void*));
+
+    template <typename T>
+    void Retire(T* ptr) {
+        EpochRetire(ptr, [](void* p) { delete static_cast<T*>(p); });
+    }
+
+    /// Free whatever retired objects are already safe to free (for tests and shutdown)
+    void EpochCollect();
+
+}  // namespace gocxx::sync::detail
@@ -0,0 +1,100 @@
+#pragma once
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include <gocxx/base/result.h>
+#include <gocxx/context/context.h>
+#include <gocxx/errors/errors.h>
+#include "semaphore.h"
+#include "waitgroup.h"
+
+namespace gocxx::sync::errgroup {
+
+/**
+ * @brief Runs a group of tasks and collects their errors (similar to Go's `golang.org/x/sync/errgroup`).
+ *
+ * Go() starts each function as a task with gocxx::Go(). Wait() waits for
+ * all of them and returns their errors joined with errors::Join(), first
+ * failure first. Go's errgroup returns only the first error.
+ *
+ * A group built from a parent context derives a cancelable context from
+ * it, available as Context(). The context is canceled when the first
+ * function fails, so its siblings can stop early, and again when Wait()
+ * returns.
+ *
+ * SetLimit() bounds how many functions run at once. Go() then waits for a
+ * free slot, and TryGo() skips the function instead of waiting.
+ *
+ * @code
+ * errgroup::Group g(ctx);
+ * g.SetLimit(8);
+ * for (auto& url : urls) {
+ *     g.Go([&, url] { return fetch(g.Context(), url); });
+ * }
+ * if (auto r = g.Wait(); r.Failed()) { ... }
+ * @endcode
+ */
+class Group {
+public:
+    Group() = default;
+
+    /**
+     * @brief A group whose Context() is canceled by the first failure.
+     */
+    explicit Group(gocxx::context::ContextPtr parent);
+
+    /**
+     * @brief Waits for functions still running, since they refer to the group.
+     */
+    ~Group();
+
+    Group(const Group&) = delete;
+    Group& operator=(const Group&) = delete;
+
+    /**
+     * @brief The derived context, or nullptr for a group built without one.
+     */
+    const gocxx::context::ContextPtr& Context() const { return ctx_; }
+
+    /**
+     * @brief Run at most @p n functions at once; a negative @p n removes the limit.
+     * @throws std::runtime_error if functions are still running
+     */
+    void SetLimit(int n);
+
+    /**
+     * @brief Run @p fn as a new task, first waiting for a free slot if limited.
+     *
+     * A function that throws fails with an error carrying the exception's
+     * message.
+     */
+    void Go(std::function<gocxx::base::Result<void>()> fn);
+
+    /**
+     * @brief Run @p fn only if a slot is free right now.
+     * @return false if the limit was reached and @p fn was not started
+     */
+    bool TryGo(std::function<gocxx::base::Result<void>()> fn);
+
+    /**
+     * @brief Wait for every function started so far.
+     * @return all their errors joined, first failure first; success if none failed
+     */
+    gocxx::base::Result<void> Wait();
+
+private:
+    void start(std::function<gocxx::base::Result<void>()> fn);
+    void fail(std::shared_ptr<gocxx::errors::Error> err);
+
+    WaitGroup wg_;
+    std::unique_ptr<Semaphore> sem_;  // Null when unlimited
+    gocxx::context::ContextPtr ctx_;
+    gocxx::context::CancelFunc cancel_;
+    std::mutex mtx_;                  // Guards errs_
+    std::vector<std::shared_ptr<gocxx::errors::Error>> errs_;
+    std::atomic<int> running_{0};
+};
+
+}  // namespace gocxx::sync::errgroup
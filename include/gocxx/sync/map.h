@@ -0,0 +1,324 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <utility>
+#include <vector>
+#include "epoch.h"
+#include "mutex.h"
+#include "shard.h"
+
+namespace gocxx::sync {
+
+/**
+ * @brief A concurrent hash map (similar to Go's `sync.Map`).
+ *
+ * Keys are spread over several times as many shards as there are CPUs.
+ * Each shard is a chained hash table of immutable nodes. Readers never
+ * lock: Load() walks the chain under an epoch guard, and a node that a
+ * writer replaces or removes is freed only once no reader can still see
+ * it. Writers take the shard's Mutex, so writes to different shards run
+ * in parallel.
+ *
+ * A shard that gets too full grows incrementally. The writer allocates a
+ * table twice the size. From then on every write to the shard moves a few
+ * buckets across and marks each old bucket as moved. Readers that meet
+ * the mark follow it into the new table. No single write pays for the
+ * whole rehash, and readers never wait for one.
+ *
+ * Values are returned by copy, since a node may be freed as soon as the
+ * call returns. Store small values or `std::shared_ptr`s. Range() visits
+ * each key present for the whole call exactly once, but, as in Go, not
+ * a consistent snapshot.
+ */
+template <typename K, typename V, typename Hash = std::hash<K>, typename KeyEqual = std::equal_to<K>>
+class Map {
+public:
+    Map() : shards_(new Shard[shardCount()]), shardMask_(shardCount() - 1) {}
+
+    ~Map() {
+        for (std::size_t i = 0; i <= shardMask_; ++i) {
+            Shard& shard = shards_[i];
+            Table* table = shard.table.load(std::memory_order_relaxed);
+            if (Table* next = table->next.load(std::memory_order_relaxed)) destroy(next);
+            destroy(table);
+        }
+    }
+
+    Map(const Map&) = delete;
+    Map& operator=(const Map&) = delete;
+
+    /**
+     * @brief The value stored for @p key, if any.
+     */
+    std::optional<V> Load(const K& key) const {
+        std::size_t h = hashOf(key);
+        detail::EpochGuard guard;
+        if (const Node* node = find(shardFor(h), h, key)) return node->value;
+        return std::nullopt;
+    }
+
+    /**
+     * @brief Set the value for @p key.
+     */
+    void Store(const K& key, V value) {
+        std::size_t h = hashOf(key);
+        Shard& shard = shardFor(h);
+        std::lock_guard<Mutex> lock(shard.mtx);
+        Slot slot = locate(shard, h, key);
+        if (slot.node) {
+            replace(slot, std::move(value));
+            return;
+        }
+        insert(shard, slot, h, key, std::move(value));
+    }
+
+    /**
+     * @brief Return the existing value for @p key, or store and return @p value.
+     * @return the value now stored, and true if it was already there
+     */
+    std::pair<V, bool> LoadOrStore(const K& key, V value) {
+        std::size_t h = hashOf(key);
+        {
+            detail::EpochGuard guard;
+            if (const Node* node = find(shardFor(h), h, key)) return {node->value, true};
+        }
+        Shard& shard = shardFor(h);
+        std::lock_guard<Mutex> lock(shard.mtx);
+        Slot slot = locate(shard, h, key);
+        if (slot.node) return {slot.node->value, true};
+        insert(shard, slot, h, key, value);
+        return {std::move(value), false};
+    }
+
+    /**
+     * @brief Remove @p key.
+     * @return the value it had, if it was present
+     */
+    std::optional<V> LoadAndDelete(const K& key) {
+        std::size_t h = hashOf(key);
+        Shard& shard = shardFor(h);
+        std::lock_guard<Mutex> lock(shard.mtx);
+        Slot slot = locate(shard, h, key);
+        if (!slot.node) return std::nullopt;
+        std::optional<V> old(slot.node->value);
+        erase(shard, slot);
+        return old;
+    }
+
+    void Delete(const K& key) { LoadAndDelete(key); }
+
+    /**
+     * @brief Store @p desired for @p key if its current value equals @p expected.
+     * @return true if the value was swapped
+     */
+    bool CompareAndSwap(const K& key, const V& expected, V desired) {
+        std::size_t h = hashOf(key);
+        Shard& shard = shardFor(h);
+        std::lock_guard<Mutex> lock(shard.mtx);
+        Slot slot = locate(shard, h, key);
+        if (!slot.node || !(slot.node->value == expected)) return false;
+        replace(slot, std::move(desired));
+        return true;
+    }
+
+    /**
+     * @brief Call @p fn(key, value) for each entry until it returns false.
+     *
+     * Entries of one shard are copied out first, so @p fn runs without any
+     * lock or guard held and may itself use the map.
+     */
+    template <typename Fn>
+    void Range(Fn&& fn) const {
+        std::vector<std::pair<K, V>> entries;
+        for (std::size_t i = 0; i <= shardMask_; ++i) {
+            entries.clear();
+            {
+                detail::EpochGuard guard;
+                const Table* table = shards_[i].table.load(std::memory_order_acquire);
+                for (std::size_t b = 0; b <= table->mask; ++b) collect(table, b, entries);
+            }
+            for (auto& entry : entries) {
+                if (!fn(static_cast<const K&>(entry.first), static_cast<const V&>(entry.second))) return;
+            }
+        }
+    }
+
+private:
+    struct Node {
+        Node(std::size_t h, const K& k, V v, Node* n) : hash(h), key(k), value(std::move(v)), next(n) {}
+
+        const std::size_t hash;
+        const K key;
+        V value;  // Written only before the node is published
+        std::atomic<Node*> next;
+    };
+
+    struct Table {
+        explicit Table(std::size_t size) : mask(size - 1), buckets(new std::atomic<Node*>[size]()) {}
+
+        const std::size_t mask;
+        std::unique_ptr<std::atomic<Node*>[]> buckets;
+        std::atomic<Table*> next{nullptr};  // Table being grown into, if any
+    };
+
+    struct alignas(detail::shardAlign) Shard {
+        Shard() : table(new Table(initialBuckets)) {}
+
+        Mutex mtx;                   // Serializes writers
+        std::atomic<Table*> table;
+        std::size_t moved = 0;       // Buckets of table already moved to table->next
+        std::size_t count = 0;
+    };
+
+    /// Where a key lives, or would be inserted, as seen by a writer
+    struct Slot {
+        std::atomic<Node*>* link;  // Bucket head or predecessor's next
+        Node* node;                // Matching node, or null
+    };
+
+    static constexpr std::size_t initialBuckets = 8;
+
+    /// Buckets moved to the new table by each write while a shard grows
+    static constexpr std::size_t moveBatch = 4;
+
+    static std::size_t shardCount() { return detail::ShardCount() * 4; }
+
+    /// Bucket head of a bucket whose chain now lives in the next table
+    static Node* movedMark() { return reinterpret_cast<Node*>(std::uintptr_t(1)); }
+
+    std::size_t hashOf(const K& key) const {
+        // Finalize so identity hashes of small integers spread over shards and buckets
+        uint64_t h = static_cast<uint64_t>(hash_(key));
+        h ^= h >> 33;
+        h *= 0xff51afd7ed558ccdull;
+        h ^= h >> 33;
+        return static_cast<std::size_t>(h);
+    }
+
+    // Low bits pick the bucket, high bits the shard
+    Shard& shardFor(std::size_t h) const {
+        return shards_[(h >> (sizeof(std::size_t) * 8 - 16)) & shardMask_];
+    }
+
+    const Node* find(const Shard& shard, std::size_t h, const K& key) const {
+        const Table* table = shard.table.load(std::memory_order_acquire);
+        for (;;) {
+            const Node* node = table->buckets[h & table->mask].load(std::memory_order_acquire);
+            if (node == movedMark()) {
+                table = table->next.load(std::memory_order_acquire);
+                continue;
+            }
+            for (; node; node = node->next.load(std::memory_order_acquire)) {
+                if (node->hash == h && equal_(node->key, key)) return node;
+            }
+            return nullptr;
+        }
+    }
+
+    static void collect(const Table* table, std::size_t b, std::vector<std::pair<K, V>>& out) {
+        const Node* node = table->buckets[b].load(std::memory_order_acquire);
+        if (node == movedMark()) {
+            const Table* next = table->next.load(std::memory_order_acquire);
+            collect(next, b, out);
+            collect(next, b + table->mask + 1, out);
+            return;
+        }
+        for (; node; node = node->next.load(std::memory_order_acquire)) out.emplace_back(node->key, node->value);
+    }
+
+    // --- Writers, under shard.mtx ---------------------------------------
+
+    Slot locate(Shard& shard, std::size_t h, const K& key) {
+        grow(shard);
+        Table* table = shard.table.load(std::memory_order_relaxed);
+        std::atomic<Node*>* link = &table->buckets[h & table->mask];
+        if (link->load(std::memory_order_relaxed) == movedMark()) {
+            table = table->next.load(std::memory_order_relaxed);
+            link = &table->buckets[h & table->mask];
+        }
+        for (Node* node = link->load(std::memory_order_relaxed); node; node = node->next.load(std::memory_order_relaxed)) {
+            if (node->hash == h && equal_(node->key, key)) return {link, node};
+            link = &node->next;
+        }
+        return {link, nullptr};
+    }
+
+    void insert(Shard& shard, Slot slot, std::size_t h, const K& key, V value) {
+        slot.link->store(new Node(h, key, std::move(value), nullptr), std::memory_order_release);
+        Table* table = shard.table.load(std::memory_order_relaxed);
+        if (++shard.count > table->mask + 1 && !table->next.load(std::memory_order_relaxed)) {
+            shard.moved = 0;
+            table->next.store(new Table((table->mask + 1) * 2), std::memory_order_release);
+        }
+    }
+
+    /// Swap in a copy of the node with a new value; readers see the old or the new one
+    void replace(Slot slot, V value) {
+        Node* old = slot.node;
+        Node* fresh = new Node(old->hash, old->key, std::move(value), old->next.load(std::memory_order_relaxed));
+        slot.link->store(fresh, std::memory_order_release);
+        detail::Retire(old);
+    }
+
+    void erase(Shard& shard, Slot slot) {
+        slot.link->store(slot.node->next.load(std::memory_order_relaxed), std::memory_order_release);
+        detail::Retire(slot.node);
+        --shard.count;
+    }
+
+    /// Move a batch of buckets into the next table; switch to it when all have moved
+    void grow(Shard& shard) {
+        Table* table = shard.table.load(std::memory_order_relaxed);
+        Table* next = table->next.load(std::memory_order_relaxed);
+        if (!next) return;
+        std::size_t size = table->mask + 1;
+        for (std::size_t n = 0; n < moveBatch && shard.moved < size; ++n) {
+            std::size_t b = shard.moved++;
+            // Copy rather than relink, so readers still in the old chain see it intact
+            Node* node = table->buckets[b].load(std::memory_order_relaxed);
+            Node* low = nullptr;
+            Node* high = nullptr;
+            for (Node* it = node; it; it = it->next.load(std::memory_order_relaxed)) {
+                Node*& head = (it->hash & size) ? high : low;
+                head = new Node(it->hash, it->key, it->value, head);
+            }
+            next->buckets[b].store(low, std::memory_order_release);
+            next->buckets[b + size].store(high, std::memory_order_release);
+            table->buckets[b].store(movedMark(), std::memory_order_release);
+            while (node) {
+                Node* following = node->next.load(std::memory_order_relaxed);
+                detail::Retire(node);
+                node = following;
+            }
+        }
+        if (shard.moved == size) {
+            shard.table.store(next, std::memory_order_release);
+            detail::Retire(table);
+        }
+    }
+
+    static void destroy(Table* table) {
+        for (std::size_t b = 0; b <= table->mask; ++b) {
+            Node* node = table->buckets[b].load(std::memory_order_relaxed);
+            if (node == movedMark()) continue;
+            while (node) {
+                Node* following = node->next.load(std::memory_order_relaxed);
+                delete node;
+                node = following;
+            }
+        }
+        delete table;
+    }
+
+    std::unique_ptr<Shard[]> shards_;
+    std::size_t shardMask_;
+    Hash hash_;
+    KeyEqual equal_;
+};
+
+}  // namespace gocxx::sync
@@ -1,25 +1,274 @@
 #pragma once
 
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
 #include <functional>
-#include <stack>
-#include <mutex>
 #include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "shard.h"
 
 namespace gocxx::sync {
 
+/**
+ * @brief Release idle objects from every pool, like the pool cleanup of a Go GC cycle.
+ *
+ * Objects cached in a pool move to its victim cache; objects already in the
+ * victim cache, unused since the previous sweep, are destroyed on the
+ * calling thread. Pools are also swept automatically every couple of
+ * seconds, so an object idle for two intervals is freed; those sweeps run
+ * the destructors on a task, not on the timer thread.
+ */
+void SweepPools();
+
+namespace detail {
+
+    /// A pool visited by SweepPools(); see RegisterPool()
+    class SweptPool {
+    public:
+        /// Move the cached objects into the victim cache and return the old
+        /// victims, freed when the result is released (null if there were none)
+        virtual std::shared_ptr<void> sweep() = 0;
+
+    protected:
+        ~SweptPool() = default;
+    };
+
+    /// Add @p pool to the set swept by SweepPools() and start the sweep timer
+    void RegisterPool(SweptPool* pool);
+
+    /// Remove @p pool; waits for a sweep in progress to finish
+    void UnregisterPool(SweptPool* pool);
+
+    /// The automatic sweep: like SweepPools(), but frees on a gocxx::Go() task
+    void SweepPoolsInBackground();
+
+    /**
+     * @brief Bounded MPMC ring with a sequence number per cell (Vyukov's algorithm)
+     *
+     * An operation that meets a cell another thread has claimed but not yet
+     * published yields until it is, so a preempted neighbour never makes the
+     * ring look empty or full.
+     */
+    template <typename Item, std::size_t Capacity>
+    class PoolRing {
+        static_assert((Capacity & (Capacity - 1)) == 0, "capacity must be a power of two");
+
+    public:
+        PoolRing() {
+            for (std::size_t i = 0; i < Capacity; ++i) cells_[i].seq.store(i, std::memory_order_relaxed);
+        }
+
+        /// Moves from @p item only on success
+        bool push(Item& item) {
+            std::size_t pos = tail_.load(std::memory_order_relaxed);
+            for (;;) {
+                Cell& cell = cells_[pos & (Capacity - 1)];
+                std::size_t seq = cell.seq.load(std::memory_order_acquire);
+                auto diff = static_cast<std::ptrdiff_t>(seq - pos);
+                if (diff == 0) {
+                    if (tail_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                        cell.item = std::move(item);
+                        cell.seq.store(pos + 1, std::memory_order_release);
+                        return true;
+                    }
+                } else if (diff < 0) {
+                    if (pos - head_.load(std::memory_order_acquire) >= Capacity) return false;  // Full
+                    // A pop claimed the cell and was preempted before freeing it
+                    std::this_thread::yield();
+                    pos = tail_.load(std::memory_order_relaxed);
+                } else {
+                    pos = tail_.load(std::memory_order_relaxed);
+                }
+            }
+        }
+
+        bool pop(Item& out) {
+            std::size_t pos = head_.load(std::memory_order_relaxed);
+            for (;;) {
+                Cell& cell = cells_[pos & (Capacity - 1)];
+                std::size_t seq = cell.seq.load(std::memory_order_acquire);
+                auto diff = static_cast<std::ptrdiff_t>(seq - (pos + 1));
+                if (diff == 0) {
+                    if (head_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                        out = std::move(cell.item);
+                        cell.item = Item();
+                        cell.seq.store(pos + Capacity, std::memory_order_release);
+                        return true;
+                    }
+                } else if (diff < 0) {
+                    if (tail_.load(std::memory_order_acquire) == pos) return false;  // Empty
+                    // A push claimed the cell and was preempted before filling
+                    // it; wait rather than report an empty ring that is not
+                    std::this_thread::yield();
+                    pos = head_.load(std::memory_order_relaxed);
+                } else {
+                    pos = head_.load(std::memory_order_relaxed);
+                }
+            }
+        }
+
+    private:
+        struct Cell {
+            std::atomic<std::size_t> seq;
+            Item item;
+        };
+
+        alignas(shardAlign) std::atomic<std::size_t> head_{0};
+        alignas(shardAlign) std::atomic<std::size_t> tail_{0};
+        Cell cells_[Capacity];
+    };
+
+    /**
+     * @brief One-object slot taken and filled with a CAS; never blocks, fails when busy
+     */
+    template <typename Item>
+    class PoolSlot {
+    public:
+        bool take(Item& out) {
+            std::uint8_t expected = Full;
+            if (state_.load(std::memory_order_relaxed) != Full ||
+                !state_.compare_exchange_strong(expected, Busy, std::memory_order_acquire)) {
+                return false;
+            }
+            out = std::move(item_);
+            item_ = Item();
+            state_.store(Empty, std::memory_order_release);
+            return true;
+        }
+
+        /// Moves from @p item only on success
+        bool give(Item& item) {
+            std::uint8_t expected = Empty;
+            if (state_.load(std::memory_order_relaxed) != Empty ||
+                !state_.compare_exchange_strong(expected, Busy, std::memory_order_acquire)) {
+                return false;
+            }
+            item_ = std::move(item);
+            state_.store(Full, std::memory_order_release);
+            return true;
+        }
+
+    private:
+        enum : std::uint8_t { Empty, Busy, Full };
+
+        std::atomic<std::uint8_t> state_{Empty};
+        Item item_;
+    };
+
+    /**
+     * @brief Storage shared by Pool and UniquePool, modelled on Go's sync.Pool
+     *
+     * Each shard, one per CPU, has a private slot and a small lock-free ring.
+     * A thread works on its own shard, so Get() and Put() normally touch one
+     * uncontended cache line. A Get() that finds its shard empty steals from
+     * the rings of the other shards, then looks in the victim cache, and only
+     * then calls the New function. A Put() into a full shard drops the object.
+     *
+     * SweepPools() moves everything cached into the victim cache and frees
+     * what was there before, so idle objects go away after two sweeps.
+     */
+    template <typename Item>
+    class PoolCore final : public SweptPool {
+    public:
+        static constexpr std::size_t shardCapacity = 16;
+
+        explicit PoolCore(std::function<Item()> newFunc)
+            : newFunc_(std::move(newFunc)),
+              mask_(ShardCount() - 1),
+              shards_(new Shard[ShardCount()]) {
+            RegisterPool(this);
+        }
+
+        ~PoolCore() {
+            UnregisterPool(this);
+        }
+
+        PoolCore(const PoolCore&) = delete;
+        PoolCore& operator=(const PoolCore&) = delete;
+
+        Item get() {
+            std::size_t hint = ShardHint();
+            Shard& shard = shards_[hint & mask_];
+            Item item;
+            if (shard.own.take(item) || shard.shared.pop(item)) return item;
+            return getSlow(hint);
+        }
+
+        void put(Item item) {
+            if (!item) return;
+            Shard& shard = shards_[ShardHint() & mask_];
+            if (!shard.own.give(item)) shard.shared.push(item);
+            // Still set if the shard was full: dropped here
+        }
+
+        std::shared_ptr<void> sweep() override {
+            std::vector<Item> cached;
+            for (std::size_t i = 0; i <= mask_; ++i) {
+                Item item;
+                if (shards_[i].own.take(item)) cached.push_back(std::move(item));
+                while (shards_[i].shared.pop(item)) cached.push_back(std::move(item));
+            }
+            {
+                std::lock_guard<std::mutex> lock(victimMtx_);
+                victim_.swap(cached);
+                victimSize_.store(victim_.size(), std::memory_order_relaxed);
+            }
+            // cached now holds the previous victims; the caller frees them
+            if (cached.empty()) return nullptr;
+            return std::make_shared<std::vector<Item>>(std::move(cached));
+        }
+
+    private:
+        struct alignas(shardAlign) Shard {
+            PoolSlot<Item> own;
+            PoolRing<Item, shardCapacity> shared;
+        };
+
+        Item getSlow(std::size_t hint) {
+            Item item;
+            for (std::size_t i = 1; i <= mask_; ++i) {
+                if (shards_[(hint + i) & mask_].shared.pop(item)) return item;
+            }
+            if (victimSize_.load(std::memory_order_relaxed) != 0) {
+                std::lock_guard<std::mutex> lock(victimMtx_);
+                if (!victim_.empty()) {
+                    item = std::move(victim_.back());
+                    victim_.pop_back();
+                    victimSize_.store(victim_.size(), std::memory_order_relaxed);
+                    return item;
+                }
+            }
+            return newFunc_ ? newFunc_() : Item();
+        }
+
+        std::function<Item()> newFunc_;
+        std::size_t mask_;
+        std::unique_ptr<Shard[]> shards_;
+
+        std::mutex victimMtx_;
+        std::vector<Item> victim_;
+        std::atomic<std::size_t> victimSize_{0};
+    };
+
+} // namespace detail
+
 /**
  * @brief A thread-safe object pool, similar to Go's `sync.Pool`.
  *
- * Designed for efficient reuse of expensive-to-create objects.
- * It stores objects in a stack and reuses them across multiple threads.
+ * Designed for efficient reuse of expensive-to-create objects such as I/O
+ * buffers. Objects are cached per CPU, so threads on different CPUs get and
+ * put without contending; a thread whose cache is empty steals from the
+ * others. Like Go's pool it is a cache, not a free list: objects left idle
+ * are released by SweepPools(), and a Put() may drop its object.
  *
  * @tparam T The type of objects to store.
  */
 template <typename T>
 class Pool {
-    std::stack<std::shared_ptr<T>> pool_;
-    std::mutex mtx_;
-    std::function<std::shared_ptr<T>()> newFunc_;
+    detail::PoolCore<std::shared_ptr<T>> core_;
 
 public:
     /**
@@ -28,7 +277,7 @@ public:
      * @param newFunc A function that creates a new object when the pool is empty.
      */
     explicit Pool(std::function<std::shared_ptr<T>()> newFunc)
-        : newFunc_(std::move(newFunc)) {}
+        : core_(std::move(newFunc)) {}
 
     /**
      * @brief Retrieves an object from the pool.
@@ -38,13 +287,7 @@ public:
      * @return A shared pointer to the object.
      */
     std::shared_ptr<T> Get() {
-        std::lock_guard<std::mutex> lock(mtx_);
-        if (pool_.empty()) {
-            return newFunc_();
-        }
-        auto obj = pool_.top();
-        pool_.pop();
-        return obj;
+        return core_.get();
     }
 
     /**
@@ -53,10 +296,62 @@ public:
      * @param obj A shared pointer to the object to store.
      */
     void Put(std::shared_ptr<T> obj) {
-        std::lock_guard<std::mutex> lock(mtx_);
-        pool_.push(std::move(obj));
+        core_.put(std::move(obj));
     }
 };
 
+/**
+ * @brief Object pool that hands out `std::unique_ptr`s which return themselves on destruction.
+ *
+ * Same caching as Pool, without reference counting: Get() returns a Ptr
+ * whose deleter puts the object back, so releasing or resetting the Ptr is
+ * the Put(). The pool must outlive every Ptr it handed out.
+ *
+ * @code
+ * sync::UniquePool<Buffer> buffers([] { return std::make_unique<Buffer>(64 * 1024); });
+ * {
+ *     auto buf = buffers.Get();
+ *     read(*buf);
+ * }  // Back in the pool
+ * @endcode
+ *
+ * @tparam T The type of objects to store.
+ */
+template <typename T>
+class UniquePool {
+public:
+    /**
+     * @brief Deleter that returns the object to its pool (or deletes it if it has none).
+     */
+    struct Recycler {
+        UniquePool* pool = nullptr;
+
+        void operator()(T* obj) const noexcept {
+            if (pool) {
+                pool->core_.put(std::unique_ptr<T>(obj));
+            } else {
+                delete obj;
+            }
+        }
+    };
+
+    using Ptr = std::unique_ptr<T, Recycler>;
+
+    /**
+     * @param newFunc Creates a new object when the pool is empty.
+     */
+    explicit UniquePool(std::function<std::unique_ptr<T>()> newFunc)
+        : core_(std::move(newFunc)) {}
+
+    /**
+     * @brief Retrieves a cached object, or a new one from `newFunc`.
+     */
+    Ptr Get() {
+        return Ptr(core_.get().release(), Recycler{this});
+    }
+
+private:
+    detail::PoolCore<std::unique_ptr<T>> core_;
+};
 
 }  // namespace gocxx::sync
@@ -1,14 +1,117 @@
 #pragma once
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
 #include <shared_mutex>
+#include "shard.h"
+#include "waitpolicy.h"
+#include <gocxx/runtime/condvar.h>
 
 namespace gocxx::sync {
 
 /**
- * @brief Alias for a read-write mutex (similar to Go's `sync.RWMutex`).
+ * @brief A reader/writer mutex for read-mostly data (similar to Go's `sync.RWMutex`).
  *
- * Allows multiple readers or a single writer.
+ * Allows multiple readers or a single writer. Readers are counted in one
+ * cache-line sized slot per CPU, not in a shared word. RLock() is then an
+ * increment of the caller's own slot plus a read of the writer flag, and
+ * concurrent readers on different CPUs never write the same line.
+ *
+ * A writer raises the flag, then waits until the slots sum to zero. New
+ * readers that see the flag back off until Unlock(), so a stream of
+ * readers cannot starve a writer. Writers take turns on the same flag. All
+ * waiters spin and yield according to the `WaitPolicy`, then park. A reader
+ * held back by a writer, or a writer waiting for readers to drain, parks
+ * just its task when it runs under gocxx::Go().
+ *
+ * Because only the sum matters, RUnlock() may run on a different thread
+ * than RLock(), as in Go. This happens when a task migrates while holding a
+ * read lock.
+ *
+ * Costs one cache line per CPU (ShardCount() lines), so prefer it for
+ * long-lived shared tables over fine-grained per-object locks. Meets the
+ * SharedLockable requirements, so ReadLock and WriteLock below work as they
+ * did with `std::shared_mutex`.
  */
-using RWMutex = std::shared_mutex;
+class RWMutex {
+public:
+    explicit RWMutex(WaitPolicy policy = WaitPolicy())
+        : slots_(new Slot[detail::ShardCount()]), mask_(detail::ShardCount() - 1), policy_(policy) {}
+
+    RWMutex(const RWMutex&) = delete;
+    RWMutex& operator=(const RWMutex&) = delete;
+
+    void RLock() {
+        Slot& slot = mySlot();
+        slot.readers.fetch_add(1, std::memory_order_seq_cst);
+        if (!writer_.load(std::memory_order_seq_cst)) return;
+        rlockSlow(slot);
+    }
+
+    void RUnlock() {
+        mySlot().readers.fetch_sub(1, std::memory_order_seq_cst);
+        if (writerParked_.load(std::memory_order_seq_cst)) wakeParked();
+    }
+
+    /**
+     * @brief Take a read lock if no writer holds or waits for the mutex; never waits.
+     */
+    bool TryRLock() {
+        Slot& slot = mySlot();
+        slot.readers.fetch_add(1, std::memory_order_seq_cst);
+        if (!writer_.load(std::memory_order_seq_cst)) return true;
+        RUnlock();
+        return false;
+    }
+
+    void Lock();
+    void Unlock();
+
+    /**
+     * @brief Take the write lock if nobody holds the mutex; never waits.
+     */
+    bool TryLock();
+
+    // SharedLockable, for std::shared_lock / std::unique_lock
+    void lock() { Lock(); }
+    void unlock() { Unlock(); }
+    bool try_lock() { return TryLock(); }
+    void lock_shared() { RLock(); }
+    void unlock_shared() { RUnlock(); }
+    bool try_lock_shared() { return TryRLock(); }
+
+    /**
+     * @brief Counts of how each blocked RLock() or Lock() call was resolved.
+     */
+    WaitCounts Stats() const {
+        return stats_.Snapshot();
+    }
+
+private:
+    struct alignas(detail::shardAlign) Slot {
+        std::atomic<int64_t> readers{0};  // May go negative on a thread that only released
+    };
+
+    Slot& mySlot() { return slots_[detail::ShardHint() & mask_]; }
+
+    bool drained() const;
+    void rlockSlow(Slot& slot);
+    void lockWriterSlow();
+    void wakeParked();
+
+    std::unique_ptr<Slot[]> slots_;
+    std::size_t mask_;
+
+    alignas(detail::shardAlign) std::atomic<bool> writer_{false};  // Held or wanted by a writer
+    std::atomic<bool> writerParked_{false};     // The flag's owner, waiting for readers to drain
+    std::atomic<uint32_t> writersParked_{0};    // Writers waiting for the flag
+    std::atomic<uint32_t> readersParked_{0};
+    std::mutex parkMtx_;
+    gocxx::runtime::CondVar cv_;
+    WaitPolicy policy_;
+    WaitStats stats_;
+};
 
 /**
  * @brief Shared (read-only) lock for RWMutex.
@@ -0,0 +1,131 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include "waitpolicy.h"
+#include <gocxx/base/result.h>
+
+namespace gocxx::context {
+    class Context;
+    using ContextPtr = std::shared_ptr<Context>;
+}
+
+namespace gocxx::sync {
+
+/**
+ * @brief A weighted semaphore (similar to Go's `golang.org/x/sync/semaphore`).
+ *
+ * Holds `size` tokens; Acquire(n) takes n of them and Release(n) gives
+ * them back. While nobody is queued, Acquire() and Release() are a single
+ * atomic operation on the token count and take no lock.
+ *
+ * A caller that finds too few tokens spins and yields according to the
+ * `WaitPolicy`, then joins a queue. Queued callers are served strictly in
+ * arrival order. A large request at the head holds back smaller ones behind
+ * it, even if there are enough tokens for those. Without this, a steady
+ * stream of small requests could starve it. A queued acquirer that is a
+ * gocxx::Go() task parks the task and keeps its place in the queue; its
+ * thread is free to run other tasks until Release() serves it.
+ *
+ * Meets the std::counting_semaphore interface (acquire(), release(),
+ * try_acquire()), with weights as an extension.
+ */
+class Semaphore {
+public:
+    explicit Semaphore(int64_t size, WaitPolicy policy = WaitPolicy())
+        : size_(size), avail_(size), policy_(policy) {}
+
+    Semaphore(const Semaphore&) = delete;
+    Semaphore& operator=(const Semaphore&) = delete;
+
+    /**
+     * @brief Take @p n tokens, waiting as long as it takes.
+     * @throws std::runtime_error if @p n exceeds the size, as it could never succeed
+     */
+    void Acquire(int64_t n = 1) {
+        if (tryTake(n)) return;
+        if (n > size_) throw std::runtime_error("sync: semaphore acquire exceeds its size");
+        if (spin(n)) return;
+        acquireSlow(nullptr, n);
+    }
+
+    /**
+     * @brief Take @p n tokens, or give up when @p ctx is canceled.
+     *
+     * Like Go, a canceled context fails the call even if tokens are free,
+     * and a request larger than the size waits for cancellation. If the
+     * tokens arrive as the context is canceled, the call succeeds.
+     *
+     * @return ctx->Err() if nothing was taken
+     */
+    gocxx::base::Result<void> Acquire(const gocxx::context::ContextPtr& ctx, int64_t n = 1);
+
+    /**
+     * @brief Take @p n tokens if they are free and nobody is queued; never waits.
+     */
+    bool TryAcquire(int64_t n = 1) { return tryTake(n); }
+
+    /**
+     * @brief Return @p n tokens and hand them to queued callers in order.
+     * @throws std::runtime_error if more tokens would be free than the size
+     */
+    void Release(int64_t n = 1) {
+        int64_t avail = avail_.fetch_add(n, std::memory_order_seq_cst) + n;
+        if (avail > size_) {
+            avail_.fetch_sub(n, std::memory_order_relaxed);
+            throw std::runtime_error("sync: semaphore released more than held");
+        }
+        if (queued_.load(std::memory_order_seq_cst) != 0) releaseSlow();
+    }
+
+    /**
+     * @brief Counts of how each Acquire() that found too few tokens was resolved.
+     */
+    WaitCounts Stats() const {
+        return stats_.Snapshot();
+    }
+
+    // std::counting_semaphore names
+    void acquire() { Acquire(); }
+    bool try_acquire() { return TryAcquire(); }
+    void release(int64_t n = 1) { Release(n); }
+
+private:
+    struct Waiter;
+
+    bool tryTake(int64_t n) {
+        if (queued_.load(std::memory_order_seq_cst) != 0) return false;  // No barging past the queue
+        int64_t avail = avail_.load(std::memory_order_relaxed);
+        while (avail >= n) {
+            if (avail_.compare_exchange_weak(avail, avail - n, std::memory_order_acquire,
+                                             std::memory_order_relaxed)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool spin(int64_t n) {
+        WaitPhase phase = SpinWait(policy_, [&] { return tryTake(n); });
+        stats_.Record(phase);
+        return phase != WaitPhase::Park;
+    }
+
+    gocxx::base::Result<void> acquireSlow(const gocxx::context::Context* ctx, int64_t n);
+    void releaseSlow();
+    void grantLocked();
+    void unlinkLocked(Waiter* w);
+
+    const int64_t size_;
+    std::atomic<int64_t> avail_;
+    std::atomic<uint32_t> queued_{0};  // Waiters in the queue; nonzero sends callers to the slow path
+    std::mutex mtx_;                   // Guards the queue
+    Waiter* head_ = nullptr;           // FIFO; nodes live on the waiters' stacks
+    Waiter* tail_ = nullptr;
+    WaitPolicy policy_;
+    WaitStats stats_;
+};
+
+}  // namespace gocxx::sync
@@ -0,0 +1,30 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <thread>
+
+namespace gocxx::sync::detail {
+
+    /// Assumed cache line size; per-CPU shards are aligned to it
+    inline constexpr std::size_t shardAlign = 64;
+
+    /// Shards per sharded structure: the CPU count rounded up to a power of two, at most 64
+    inline std::size_t ShardCount() {
+        static const std::size_t count = [] {
+            std::size_t cpus = std::min<std::size_t>(std::max(1u, std::thread::hardware_concurrency()), 64);
+            std::size_t n = 1;
+            while (n < cpus) n <<= 1;
+            return n;
+        }();
+        return count;
+    }
+
+    /// Shard of the calling thread; threads are spread round-robin on first use
+    inline std::size_t ShardHint() {
+        static std::atomic<std::size_t> next{0};
+        thread_local const std::size_t hint = next.fetch_add(1, std::memory_order_relaxed);
+        return hint;
+    }
+
+}  // namespace gocxx::sync::detail
@@ -0,0 +1,191 @@
+#pragma once
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include <gocxx/base/chan.h>
+#include <gocxx/base/result.h>
+#include <gocxx/errors/errors.h>
+#include <gocxx/runtime/scheduler.h>
+#include "shard.h"
+#include "waitgroup.h"
+
+namespace gocxx::sync::singleflight {
+
+/**
+ * @brief Coalesces concurrent calls for the same key (similar to Go's `golang.org/x/sync/singleflight`).
+ *
+ * The first Do() for a key runs the function. Callers that arrive for the
+ * same key while it runs wait for that call and get a copy of its result.
+ * A call that finished is forgotten, so the next Do() runs the function
+ * again. Use it in front of a backing store, so that a burst of misses for
+ * one key turns into a single load.
+ *
+ * Keys are spread over several times as many shards as there are CPUs,
+ * each a small map under its own mutex. The mutex is held only to look up
+ * or remove a call, never while the function runs. A duplicate caller
+ * waits on the call's WaitGroup; when it is a task, the task parks there
+ * and its thread keeps running other work until the first caller is done.
+ *
+ * If the function throws, Do() rethrows the exception in every caller of
+ * that call. DoChan() receivers get an error with its message instead.
+ */
+template <typename K, typename V, typename Hash = std::hash<K>>
+class Group {
+public:
+    Group() : shards_(new Shard[shardCount()]), mask_(shardCount() - 1) {}
+
+    /**
+     * @brief Waits for calls started by DoChan() that are still running.
+     */
+    ~Group() { pending_.Wait(); }
+
+    Group(const Group&) = delete;
+    Group& operator=(const Group&) = delete;
+
+    /**
+     * @brief Run @p fn for @p key, or wait for the call already running for it.
+     *
+     * @p fn is a callable returning base::Result<V>.
+     * @param shared set to true if the result was given to more than one caller
+     */
+    template <typename Fn>
+    gocxx::base::Result<V> Do(const K& key, Fn&& fn, bool* shared = nullptr) {
+        Shard& shard = shardFor(key);
+        std::unique_lock<std::mutex> lock(shard.mtx);
+        auto it = shard.calls.find(key);
+        if (it != shard.calls.end()) {
+            std::shared_ptr<Call> call = it->second;
+            ++call->dups;
+            lock.unlock();
+            call->done.Wait();
+            return resultOf(*call, shared);
+        }
+        auto call = std::make_shared<Call>();
+        shard.calls.emplace(key, call);
+        lock.unlock();
+
+        run(shard, key, *call, fn);
+        return resultOf(*call, shared);
+    }
+
+    /**
+     * @brief Like Do(), but never waits: the result arrives on the returned channel.
+     *
+     * A new call runs @p fn as a task with gocxx::Go(). The channel has room
+     * for the one result, so nobody has to receive it.
+     */
+    template <typename Fn>
+    gocxx::base::Chan<gocxx::base::Result<V>> DoChan(const K& key, Fn&& fn) {
+        gocxx::base::Chan<gocxx::base::Result<V>> ch(1);
+        Shard& shard = shardFor(key);
+        std::unique_lock<std::mutex> lock(shard.mtx);
+        auto it = shard.calls.find(key);
+        if (it != shard.calls.end()) {
+            ++it->second->dups;
+            it->second->chans.push_back(ch);
+            return ch;
+        }
+        auto call = std::make_shared<Call>();
+        call->chans.push_back(ch);
+        shard.calls.emplace(key, call);
+        lock.unlock();
+
+        pending_.Add(1);
+        gocxx::Go([this, &shard, key, call, fn = std::make_shared<std::decay_t<Fn>>(std::forward<Fn>(fn))] {
+            run(shard, key, *call, *fn);
+            pending_.Done();
+        });
+        return ch;
+    }
+
+    /**
+     * @brief Stop coalescing new calls for @p key with the one running now.
+     *
+     * Callers already waiting still get its result. The next Do() for
+     * @p key runs the function again.
+     */
+    void Forget(const K& key) {
+        Shard& shard = shardFor(key);
+        std::lock_guard<std::mutex> lock(shard.mtx);
+        shard.calls.erase(key);
+    }
+
+private:
+    struct Call {
+        Call() { done.Add(1); }
+
+        WaitGroup done;                   // Released once result is set
+        gocxx::base::Result<V> result;
+        std::exception_ptr exception;
+        bool shared = false;              // Written before done is released
+        std::size_t dups = 0;             // Guarded by the shard mutex
+        std::vector<gocxx::base::Chan<gocxx::base::Result<V>>> chans;  // Guarded by the shard mutex
+    };
+
+    struct alignas(detail::shardAlign) Shard {
+        std::mutex mtx;
+        std::unordered_map<K, std::shared_ptr<Call>, Hash> calls;
+    };
+
+    static std::size_t shardCount() { return detail::ShardCount() * 4; }
+
+    Shard& shardFor(const K& key) {
+        std::size_t h = hash_(key);
+        return shards_[(h ^ (h >> 17) ^ (h >> 31)) & mask_];
+    }
+
+    template <typename Fn>
+    void run(Shard& shard, const K& key, Call& call, Fn& fn) {
+        try {
+            call.result = fn();
+        } catch (...) {
+            call.exception = std::current_exception();
+        }
+
+        std::vector<gocxx::base::Chan<gocxx::base::Result<V>>> chans;
+        {
+            std::lock_guard<std::mutex> lock(shard.mtx);
+            auto it = shard.calls.find(key);
+            if (it != shard.calls.end() && it->second.get() == &call) shard.calls.erase(it);  // Unless forgotten
+            call.shared = call.dups > 0;
+            chans.swap(call.chans);
+        }
+        call.done.Done();
+
+        if (chans.empty()) return;
+        gocxx::base::Result<V> result = call.exception ? gocxx::base::Result<V>(errorOf(call.exception)) : call.result;
+        for (auto& ch : chans) ch.trySend(result);
+    }
+
+    static gocxx::base::Result<V> resultOf(const Call& call, bool* shared) {
+        if (shared) *shared = call.shared;
+        if (call.exception) std::rethrow_exception(call.exception);
+        return call.result;
+    }
+
+    static std::shared_ptr<gocxx::errors::Error> errorOf(const std::exception_ptr& exception) {
+        try {
+            std::rethrow_exception(exception);
+        } catch (const gocxx::errors::Error& e) {
+            return gocxx::errors::New(e.error());
+        } catch (const std::exception& e) {
+            return gocxx::errors::New(e.what());
+        } catch (...) {
+            return gocxx::errors::New("singleflight: function threw");
+        }
+    }
+
+    std::unique_ptr<Shard[]> shards_;
+    std::size_t mask_;
+    Hash hash_;
+    WaitGroup pending_;  // DoChan() calls still running
+};
+
+}  // namespace gocxx::sync::singleflight
@@ -6,3 +6,6 @@
 #include "once.h"
 #include "cond.h"
 #include "pool.h"
+#include "map.h"
+#include "semaphore.h"
+#include "waitpolicy.h"
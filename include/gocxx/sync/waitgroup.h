@@ -1,7 +1,10 @@
 #pragma once
+#include <atomic>
+#include <cstdint>
 #include <mutex>
-#include <condition_variable>
 #include <stdexcept>
+#include "waitpolicy.h"
+#include <gocxx/runtime/condvar.h>
 
 namespace gocxx::sync {
 
@@ -9,28 +12,53 @@ namespace gocxx::sync {
  * @brief A synchronization primitive that waits for a group of tasks to complete.
  *
  * Inspired by Go's `sync.WaitGroup`. Use `Add()` to set the number of tasks, `Done()` when a task finishes,
- * and `Wait()` to block until all tasks are complete.
+ * and `Wait()` to block until all tasks are complete. `Wait()` spins and yields on the counter according
+ * to its `WaitPolicy` before parking.
+ *
+ * As in Go, the counter and the number of parked waiters share one 64-bit
+ * atomic, so `Add()` and `Done()` are a single `fetch_add`. Only the change
+ * to zero with waiters parked takes the mutex to wake them.
  */
 class WaitGroup {
+    std::atomic<uint64_t> state_{0};  // Counter in the high 32 bits, parked waiters in the low 32
     std::mutex mtx_;
-    std::condition_variable cv_;
-    int count_ = 0;
+    gocxx::runtime::CondVar cv_;
+    uint64_t wakeups_ = 0;            // Bumped under mtx_ each time parked waiters are released
+    WaitPolicy policy_;
+    WaitStats stats_;
+
+    static constexpr uint64_t waiterMask = 0xffffffffu;
+
+    static int32_t counter(uint64_t state) {
+        return static_cast<int32_t>(state >> 32);
+    }
 
 public:
+    explicit WaitGroup(WaitPolicy policy = WaitPolicy()) : policy_(policy) {}
+
     /**
      * @brief Adds delta to the WaitGroup counter.
      *
      * @param delta The number of tasks to add. Can be negative (but should be used carefully).
+     * @throws std::runtime_error if the counter would go negative; it is left unchanged
      */
     void Add(int delta) {
-        std::lock_guard<std::mutex> lock(mtx_);
-        count_ += delta;
-        if (count_ < 0) {
+        uint64_t step = static_cast<uint64_t>(static_cast<int64_t>(delta)) << 32;
+        uint64_t state = state_.fetch_add(step, std::memory_order_acq_rel) + step;
+        int32_t count = counter(state);
+        if (count < 0) {
+            state_.fetch_sub(step, std::memory_order_relaxed);
             throw std::runtime_error("WaitGroup counter went negative");
         }
-        if (count_ == 0) {
-            cv_.notify_all();
+        if (count > 0 || (state & waiterMask) == 0) {
+            return;
         }
+        // Reached zero with waiters parked. Waiters register under mtx_, so
+        // everyone counted in state is waiting on wakeups_ by now.
+        std::lock_guard<std::mutex> lock(mtx_);
+        state_.fetch_and(~waiterMask, std::memory_order_relaxed);
+        ++wakeups_;
+        cv_.notify_all();
     }
 
     /**
@@ -42,10 +70,36 @@ public:
 
     /**
      * @brief Blocks until the counter becomes zero.
+     *
+     * A waiter spins and yields per the `WaitPolicy`, then parks until the
+     * last Done(). A waiting gocxx::Go() task is taken off its thread,
+     * which goes on running other tasks.
      */
     void Wait() {
-        std::unique_lock<std::mutex> lock(mtx_);
-        cv_.wait(lock, [this] { return count_ == 0; });
+        WaitPhase phase = SpinWait(policy_, [this] {
+            return counter(state_.load(std::memory_order_acquire)) == 0;
+        });
+        if (phase == WaitPhase::Park) {
+            std::unique_lock<std::mutex> lock(mtx_);
+            uint64_t state = state_.load(std::memory_order_acquire);
+            while (counter(state) != 0) {
+                if (!state_.compare_exchange_weak(state, state + 1, std::memory_order_acq_rel)) {
+                    continue;
+                }
+                uint64_t seen = wakeups_;
+                cv_.wait(lock, [&] { return wakeups_ != seen; });
+                // An Add() racing with the wakeup may have raised the counter again
+                state = state_.load(std::memory_order_acquire);
+            }
+        }
+        stats_.Record(phase);
+    }
+
+    /**
+     * @brief Counts of how each `Wait` call was resolved.
+     */
+    WaitCounts Stats() const {
+        return stats_.Snapshot();
     }
 };
 
@@ -0,0 +1,133 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <gocxx/runtime/blocking.h>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#endif
+
+namespace gocxx::sync {
+
+/**
+ * @brief How a blocking wait resolved: busy spin, after yielding, or parked.
+ */
+enum class WaitPhase { Spin, Yield, Park };
+
+/**
+ * @brief Spin-then-yield-then-park configuration for blocking waits.
+ *
+ * A waiter first re-checks its condition up to `spins` times with a CPU pause
+ * in between, then up to `yields` times with a `std::this_thread::yield()` in
+ * between, and only then parks on the operating system. Short waits (e.g. a
+ * request/response ping-pong over a channel) then finish without a futex
+ * sleep/wake pair. Spinning is skipped on single-CPU machines, where it can
+ * only delay the thread it is waiting for, and yielding is skipped in tasks,
+ * where parking lets the next task on the same thread run instead.
+ *
+ * The default is the adaptive policy; use `WaitPolicy::Block()` for the plain
+ * park-immediately behaviour.
+ */
+struct WaitPolicy {
+    uint32_t spins = 128;
+    uint32_t yields = 8;
+
+    /**
+     * @brief Park immediately, without spinning or yielding.
+     */
+    static constexpr WaitPolicy Block() { return WaitPolicy{0, 0}; }
+
+    /**
+     * @brief The default bounded spin, then yield, then park policy.
+     */
+    static constexpr WaitPolicy Adaptive() { return WaitPolicy{}; }
+};
+
+/**
+ * @brief Snapshot of how many waits resolved in each phase.
+ */
+struct WaitCounts {
+    uint64_t spun = 0;
+    uint64_t yielded = 0;
+    uint64_t parked = 0;
+
+    uint64_t Total() const { return spun + yielded + parked; }
+
+    WaitCounts& operator+=(const WaitCounts& other) {
+        spun += other.spun;
+        yielded += other.yielded;
+        parked += other.parked;
+        return *this;
+    }
+};
+
+/**
+ * @brief Per-primitive counters of which phase resolved each wait.
+ *
+ * Updated with relaxed atomics; read with `Snapshot()`.
+ */
+class WaitStats {
+    std::atomic<uint64_t> spun_{0};
+    std::atomic<uint64_t> yielded_{0};
+    std::atomic<uint64_t> parked_{0};
+
+public:
+    void Record(WaitPhase phase) {
+        switch (phase) {
+            case WaitPhase::Spin:  spun_.fetch_add(1, std::memory_order_relaxed); break;
+            case WaitPhase::Yield: yielded_.fetch_add(1, std::memory_order_relaxed); break;
+            case WaitPhase::Park:  parked_.fetch_add(1, std::memory_order_relaxed); break;
+        }
+    }
+
+    WaitCounts Snapshot() const {
+        WaitCounts counts;
+        counts.spun = spun_.load(std::memory_order_relaxed);
+        counts.yielded = yielded_.load(std::memory_order_relaxed);
+        counts.parked = parked_.load(std::memory_order_relaxed);
+        return counts;
+    }
+};
+
+/**
+ * @brief Hint to the CPU that the caller is busy-waiting.
+ */
+inline void CpuRelax() {
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    _mm_pause();
+#elif defined(__i386__) || defined(__x86_64__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+    asm volatile("yield" ::: "memory");
+#else
+    std::atomic_signal_fence(std::memory_order_seq_cst);
+#endif
+}
+
+/**
+ * @brief Run the spin and yield phases of @p policy until @p ready returns true.
+ *
+ * @return `WaitPhase::Spin` or `WaitPhase::Yield` if @p ready became true in
+ *         that phase, or `WaitPhase::Park` if the caller must now block.
+ */
+template <typename Ready>
+WaitPhase SpinWait(const WaitPolicy& policy, Ready&& ready) {
+    static const bool multiCore = std::thread::hardware_concurrency() > 1;
+    if (multiCore) {
+        for (uint32_t i = 0; i < policy.spins; ++i) {
+            if (ready()) return WaitPhase::Spin;
+            CpuRelax();
+        }
+    }
+    if (policy.yields > 0 && gocxx::runtime::detail::CurrentTask()) {
+        return WaitPhase::Park;
+    }
+    for (uint32_t i = 0; i < policy.yields; ++i) {
+        if (ready()) return WaitPhase::Yield;
+        std::this_thread::yield();
+    }
+    return WaitPhase::Park;
+}
+
+}  // namespace gocxx::sync
@@ -1,28 +1,32 @@
 #pragma once
 #include "duration.h"
 #include "time.h"
-#include <thread>
-#include <atomic>
+#include "timer_service.h"
 #include <memory>
 #include <gocxx/base/chan.h>
 
 namespace gocxx::time {
 
+/**
+ * @brief Delivers the time on C() every period, like Go's time.Ticker.
+ *
+ * Scheduled on the shared TimerService as a periodic timer. As in Go, C()
+ * buffers one tick and ticks are dropped while the reader is behind.
+ */
 class Ticker {
 public:
     explicit Ticker(Duration d);
     ~Ticker();
 
+    /**
+     * @brief Turns off the ticker and closes C().
+     */
     void Stop();
     std::shared_ptr<gocxx::base::Chan<Time>> C();
 
 private:
-    void run();
-
-    Duration duration_;
-    std::thread thread_;
-    std::atomic<bool> stopped_;
     std::shared_ptr<gocxx::base::Chan<Time>> ch_;
+    TimerService::Handle entry_;
 };
 
 std::unique_ptr<Ticker> NewTicker(Duration d);
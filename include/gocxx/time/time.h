@@ -6,6 +6,7 @@
 #include <chrono>
 #include "duration.h"
 #include <thread>
+#include <gocxx/runtime/blocking.h>
 
 namespace gocxx::time {
 
@@ -54,8 +55,17 @@ private:
     int32_t nsec_;
 };
 
+/**
+ * @brief Pause for @p d.
+ *
+ * A sleeping gocxx::Go() task parks on a timer of the shared timer service
+ * and leaves its thread to other tasks; a plain thread sleeps itself.
+ */
 inline void Sleep(Duration d) {
-    std::this_thread::sleep_for(std::chrono::nanoseconds(d.Nanoseconds()));
+    const std::chrono::nanoseconds ns(d.Nanoseconds());
+    if (gocxx::runtime::detail::SleepTask(ns)) return;
+    gocxx::runtime::BlockingRegion blocking;
+    std::this_thread::sleep_for(ns);
 }
 
 } // namespace gocxx::time
\ No newline at end of file
@@ -2,35 +2,111 @@
 #include <gocxx/base/chan.h>
 #include "time.h"
 #include "duration.h"
-#include <thread>
-#include <atomic>
+#include "timer_service.h"
+#include <functional>
 #include <memory>
-#include <mutex>
-#include <condition_variable>
 
 namespace gocxx::time {
 
+/**
+ * @brief A single event, like Go's time.Timer.
+ *
+ * The current time is delivered on C() when the timer expires, or the
+ * function passed to AfterFunc() is called. Timers are scheduled on the
+ * shared TimerService; creating one does not start a thread.
+ */
 class Timer {
 public:
     explicit Timer(Duration d);
+
+    /**
+     * @brief Stops a channel timer. An AfterFunc timer stays scheduled.
+     */
     ~Timer();
 
+    /**
+     * @brief Prevents the timer from firing.
+     *
+     * A channel timer leaves no value on C() afterwards, even if it was
+     * firing concurrently. An AfterFunc call that is already running is not
+     * waited for.
+     *
+     * @return true if the call stopped the timer, false if it had already
+     *         expired or been stopped
+     */
     bool Stop();
+
+    /**
+     * @brief Changes the timer to expire after @p d, discarding any unread value on C().
+     * @return true if the timer had been active
+     */
     bool Reset(Duration d);
+
+    /**
+     * @brief Channel the expiry time is sent on; nullptr for AfterFunc timers.
+     */
     std::shared_ptr<gocxx::base::Chan<Time>> C();
 
 private:
-    Duration duration_;
-    std::chrono::steady_clock::time_point start_;
-    std::thread thread_;
-    std::atomic<bool> stopped_;
-    std::shared_ptr<gocxx::base::Chan<Time>> ch_;
-    std::mutex mutex_;
-    std::condition_variable cv_;
+    friend std::unique_ptr<Timer> AfterFunc(Duration d, std::function<void()> f);
+
+    Timer(Duration d, std::function<void()> f);
 
-    void run();
+    bool disarm();
+    void drain();
+
+    std::shared_ptr<gocxx::base::Chan<Time>> ch_;
+    TimerService::Handle entry_;
 };
 
 std::unique_ptr<Timer> NewTimer(Duration d);
 
+/**
+ * @brief Calls @p f on the timer service thread after @p d.
+ *
+ * Go equivalent: time.AfterFunc. Use the returned timer to Stop() or
+ * Reset() it; destroying it does not cancel the call. @p f runs on the
+ * shared timer thread, so it should be short.
+ */
+std::unique_ptr<Timer> AfterFunc(Duration d, std::function<void()> f);
+
+#if GOCXX_HAS_COROUTINES
+
+/**
+ * @brief Awaiter of SleepAsync(): arms a TimerService entry that posts the coroutine back.
+ */
+class SleepAwaiter : private gocxx::runtime::detail::ResumeWork {
+public:
+    explicit SleepAwaiter(Duration d) : d_(d) {}
+
+    bool await_ready() const { return d_.Nanoseconds() <= 0; }
+
+    void await_suspend(std::coroutine_handle<> h) {
+        auto* exec = &gocxx::runtime::detail::AwaitingExecutor("SleepAsync");
+        handle = h;
+        auto& timers = TimerService::Global();
+        timer_ = timers.Create([this, exec] { exec->Post(this); });
+        timers.ArmAfter(timer_, d_);
+    }
+
+    void await_resume() const noexcept {}
+
+private:
+    Duration d_;
+    TimerService::Handle timer_;
+};
+
+/**
+ * @brief Pause a coroutine for @p d without blocking its thread (C++20)
+ * Go equivalent: time.Sleep(d)
+ *
+ * `co_await time::SleepAsync(Milliseconds(10));`. To wait on a Timer
+ * instead, await its channel: `co_await timer->C()->recvAsync()`.
+ */
+inline SleepAwaiter SleepAsync(Duration d) {
+    return SleepAwaiter(d);
+}
+
+#endif // GOCXX_HAS_COROUTINES
+
 } // namespace gocxx::time
@@ -0,0 +1,110 @@
+#pragma once
+#include "duration.h"
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace gocxx::time {
+
+namespace detail {
+    struct TimerEntry;
+}
+
+/**
+ * @brief Process-wide timer scheduler shared by Timer, Ticker, AfterFunc and TimerContext.
+ *
+ * Pending timers live in a 4-ary min-heap ordered by deadline and are driven
+ * by a single thread, started on first use, that sleeps until the earliest
+ * deadline. Arming, re-arming and disarming a timer is an O(log n) heap
+ * update under one mutex, and no thread is created per timer.
+ *
+ * Callbacks run on the service thread, one at a time, so they must be short
+ * and must not block; hand longer work off to another thread or channel.
+ */
+class TimerService {
+public:
+    using Clock = std::chrono::steady_clock;
+    using Handle = std::shared_ptr<detail::TimerEntry>;
+
+    TimerService();
+
+    /**
+     * @brief Stops the service thread. Pending timers never fire.
+     */
+    ~TimerService();
+
+    TimerService(const TimerService&) = delete;
+    TimerService& operator=(const TimerService&) = delete;
+
+    /**
+     * @brief The shared instance used by the time and context packages.
+     */
+    static TimerService& Global();
+
+    /**
+     * @brief Create an unarmed timer that calls @p fn each time it fires.
+     *
+     * An exception escaping @p fn terminates the program.
+     */
+    Handle Create(std::function<void()> fn);
+
+    /**
+     * @brief Schedule @p timer to fire at @p when, replacing any pending schedule.
+     *
+     * @param period If positive, the timer re-arms itself @p period after each
+     *               firing (ticks missed while the service was busy are dropped)
+     * @return true if the timer was pending before this call
+     */
+    bool Arm(const Handle& timer, Clock::time_point when, Duration period = Duration(0));
+
+    /**
+     * @brief Schedule @p timer to fire @p d from now.
+     */
+    bool ArmAfter(const Handle& timer, Duration d, Duration period = Duration(0));
+
+    /**
+     * @brief Remove @p timer from the schedule.
+     *
+     * A callback that is already running is not interrupted.
+     *
+     * @return true if the timer was pending (the call prevented a firing)
+     */
+    bool Disarm(const Handle& timer);
+
+    /**
+     * @brief Like Disarm(), and also wait for a running callback of @p timer to return.
+     *
+     * Use before destroying state the callback refers to. Does not wait when
+     * called from the callback itself.
+     */
+    bool DisarmSync(const Handle& timer);
+
+    /**
+     * @brief Number of timers currently scheduled.
+     */
+    std::size_t Pending() const;
+
+private:
+    void run();
+    void push(const Handle& timer);
+    void remove(detail::TimerEntry* timer);
+    void siftUp(std::size_t i);
+    void siftDown(std::size_t i);
+    void place(std::size_t i, Handle timer);
+
+    mutable std::mutex mutex_;
+    std::condition_variable wake_;
+    std::condition_variable callbackDone_;
+    std::vector<Handle> heap_;
+    detail::TimerEntry* running_ = nullptr;
+    Clock::time_point sleepUntil_ = Clock::time_point::max();  // When the thread next wakes by itself
+    bool stopping_ = false;
+    std::thread thread_;
+};
+
+} // namespace gocxx::time
@@ -0,0 +1,407 @@
+#include "gocxx/bufio/bufio.h"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+namespace gocxx::bufio {
+
+    using gocxx::base::Result;
+    using gocxx::errors::Error;
+
+    namespace {
+
+        constexpr std::size_t minReadBufferSize = 16;
+        constexpr std::size_t startBufSize = 4096;  // Scanner's first buffer, unless Buffer() says otherwise
+        constexpr int maxConsecutiveEmptyReads = 100;
+
+        std::string_view viewOf(const std::vector<uint8_t>& buf, std::size_t from, std::size_t to) {
+            return std::string_view(reinterpret_cast<const char*>(buf.data()) + from, to - from);
+        }
+
+        std::string_view dropCR(std::string_view data) {
+            if (!data.empty() && data.back() == '\r') data.remove_suffix(1);
+            return data;
+        }
+
+        bool isSpace(char c) {
+            return c == ' ' || (c >= '\t' && c <= '\r');
+        }
+
+    } // namespace
+
+    // ------------------ Reader ------------------
+
+    Reader::Reader(std::shared_ptr<io::Reader> rd, std::size_t size)
+        : rd_(std::move(rd)), buf_(std::max(size, minReadBufferSize)) {}
+
+    void Reader::fill() {
+        // Slide unread data to the front to make room
+        if (r_ > 0) {
+            std::memmove(buf_.data(), buf_.data() + r_, w_ - r_);
+            w_ -= r_;
+            r_ = 0;
+        }
+        auto res = rd_->Read(buf_.data() + w_, buf_.size() - w_);
+        w_ += res.value;
+        if (!res.Ok()) {
+            err_ = res.err;
+        } else if (res.value == 0) {
+            err_ = io::ErrEOF;
+        }
+    }
+
+    std::shared_ptr<Error> Reader::takeErr() {
+        std::shared_ptr<Error> err = std::move(err_);
+        err_ = nullptr;
+        return err;
+    }
+
+    Result<std::size_t> Reader::Read(uint8_t* buffer, std::size_t size) {
+        if (size == 0) {
+            if (Buffered() > 0) return { 0, nullptr };
+            return { 0, takeErr() };
+        }
+        if (r_ == w_) {
+            if (err_) return { 0, takeErr() };
+            if (size >= buf_.size()) {
+                // Nothing buffered and a large read: skip the copy
+                auto res = rd_->Read(buffer, size);
+                if (res.Ok() && res.value == 0) return { 0, io::ErrEOF };
+                lastByte_ = res.value > 0 ? buffer[res.value - 1] : -1;
+                return res;
+            }
+            r_ = w_ = 0;
+            fill();
+            if (r_ == w_) return { 0, takeErr() };
+        }
+
+        std::size_t n = std::min(size, w_ - r_);
+        std::memcpy(buffer, buf_.data() + r_, n);
+        r_ += n;
+        lastByte_ = buf_[r_ - 1];
+        return { n };
+    }
+
+    Result<std::size_t> Reader::ReadByte(uint8_t& outByte) {
+        while (r_ == w_) {
+            if (err_) return { 0, takeErr() };
+            fill();
+        }
+        outByte = buf_[r_++];
+        lastByte_ = outByte;
+        return { 1 };
+    }
+
+    Result<void> Reader::UnreadByte() {
+        if (lastByte_ < 0 || (r_ == 0 && w_ > 0)) return Result<void>(ErrInvalidUnreadByte);
+        // r_ == 0 && w_ == 0: the last read bypassed the buffer
+        if (r_ > 0) {
+            --r_;
+        } else {
+            w_ = 1;
+        }
+        buf_[r_] = static_cast<uint8_t>(lastByte_);
+        lastByte_ = -1;
+        return {};
+    }
+
+    Result<std::string_view> Reader::Peek(std::size_t n) {
+        lastByte_ = -1;
+        while (w_ - r_ < n && w_ - r_ < buf_.size() && !err_) fill();
+
+        if (n > buf_.size()) return { view(r_, w_), ErrBufferFull };
+
+        std::shared_ptr<Error> err;
+        if (std::size_t avail = w_ - r_; avail < n) {
+            n = avail;
+            err = takeErr();
+            if (!err) err = ErrBufferFull;
+        }
+        return { view(r_, r_ + n), err };
+    }
+
+    Result<std::size_t> Reader::Discard(std::size_t n) {
+        lastByte_ = -1;
+        std::size_t remain = n;
+        while (remain > 0) {
+            std::size_t skip = Buffered();
+            if (skip == 0) {
+                if (err_) return { n - remain, takeErr() };
+                fill();
+                skip = Buffered();
+            }
+            skip = std::min(skip, remain);
+            r_ += skip;
+            remain -= skip;
+        }
+        return { n };
+    }
+
+    Result<std::string_view> Reader::ReadSlice(uint8_t delim) {
+        std::string_view line;
+        std::shared_ptr<Error> err;
+        std::size_t searched = 0;  // Bytes after r_ already known not to hold delim
+        for (;;) {
+            const uint8_t* from = buf_.data() + r_ + searched;
+            if (auto* hit = static_cast<const uint8_t*>(std::memchr(from, delim, w_ - r_ - searched))) {
+                std::size_t end = static_cast<std::size_t>(hit - buf_.data()) + 1;
+                line = view(r_, end);
+                r_ = end;
+                break;
+            }
+            if (err_) {
+                line = view(r_, w_);
+                r_ = w_;
+                err = takeErr();
+                break;
+            }
+            if (Buffered() >= buf_.size()) {
+                line = view(r_, w_);
+                r_ = w_;
+                err = ErrBufferFull;
+                break;
+            }
+            searched = w_ - r_;
+            fill();
+        }
+        if (!line.empty()) lastByte_ = static_cast<uint8_t>(line.back());
+        return { line, err };
+    }
+
+    Result<Reader::Line> Reader::ReadLine() {
+        auto res = ReadSlice('\n');
+        std::string_view line = res.value;
+        if (res.err == ErrBufferFull) {
+            // Keep a "\r" that may start a "\r\n" for the next call
+            if (!line.empty() && line.back() == '\r') {
+                --r_;
+                line.remove_suffix(1);
+            }
+            return Result<Line>(Line{ line, true });
+        }
+        if (line.empty()) return { Line{}, res.err };
+
+        // Data and no error; an error comes back on the next call
+        if (line.back() == '\n') {
+            line.remove_suffix(1);
+            line = dropCR(line);
+        }
+        return Result<Line>(Line{ line, false });
+    }
+
+    Result<std::string> Reader::ReadString(uint8_t delim) {
+        std::string out;
+        for (;;) {
+            auto res = ReadSlice(delim);
+            out.append(res.value);
+            if (res.err != ErrBufferFull) return { std::move(out), res.err };
+        }
+    }
+
+    void Reader::Reset(std::shared_ptr<io::Reader> rd) {
+        rd_ = std::move(rd);
+        r_ = w_ = 0;
+        err_ = nullptr;
+        lastByte_ = -1;
+    }
+
+    // ------------------ Writer ------------------
+
+    Writer::Writer(std::shared_ptr<io::Writer> wr, std::size_t size)
+        : wr_(std::move(wr)), buf_(size == 0 ? defaultBufSize : size) {}
+
+    Result<std::size_t> Writer::Write(const uint8_t* buffer, std::size_t size) {
+        std::size_t total = 0;
+        while (size > Available() && !err_) {
+            std::size_t n;
+            if (n_ == 0) {
+                // Large write, empty buffer: write directly to avoid the copy
+                auto res = wr_->Write(buffer, size);
+                n = res.value;
+                if (!res.Ok()) {
+                    err_ = res.err;
+                } else if (n < size) {
+                    err_ = io::ErrShortWrite;
+                }
+            } else {
+                n = Available();
+                std::memcpy(buf_.data() + n_, buffer, n);
+                n_ += n;
+                Flush();
+            }
+            total += n;
+            buffer += n;
+            size -= n;
+        }
+        if (err_) return { total, err_ };
+
+        if (size > 0) std::memcpy(buf_.data() + n_, buffer, size);  // buffer may be null
+        n_ += size;
+        return { total + size };
+    }
+
+    Result<std::size_t> Writer::WriteByte(uint8_t byte) {
+        if (err_) return { 0, err_ };
+        if (Available() == 0 && !Flush().Ok()) return { 0, err_ };
+        buf_[n_++] = byte;
+        return { 1 };
+    }
+
+    Result<std::size_t> Writer::WriteString(std::string_view s) {
+        return Write(reinterpret_cast<const uint8_t*>(s.data()), s.size());
+    }
+
+    Result<void> Writer::Flush() {
+        if (err_) return Result<void>(err_);
+        if (n_ == 0) return {};
+
+        auto res = wr_->Write(buf_.data(), n_);
+        std::size_t n = std::min(res.value, n_);
+        std::shared_ptr<Error> err = res.err;
+        if (!err && n < n_) err = io::ErrShortWrite;
+        if (err) {
+            // Keep what was not written, for a caller that inspects Buffered()
+            std::memmove(buf_.data(), buf_.data() + n, n_ - n);
+            n_ -= n;
+            err_ = err;
+            return Result<void>(err);
+        }
+        n_ = 0;
+        return {};
+    }
+
+    void Writer::Reset(std::shared_ptr<io::Writer> wr) {
+        wr_ = std::move(wr);
+        n_ = 0;
+        err_ = nullptr;
+    }
+
+    // ------------------ Split functions ------------------
+
+    SplitResult ScanLines(std::string_view data, bool atEOF) {
+        if (atEOF && data.empty()) return {};
+        if (std::size_t i = data.find('\n'); i != std::string_view::npos) {
+            return { i + 1, dropCR(data.substr(0, i)), true, nullptr };
+        }
+        if (atEOF) return { data.size(), dropCR(data), true, nullptr };
+        return {};
+    }
+
+    SplitResult ScanWords(std::string_view data, bool atEOF) {
+        std::size_t start = 0;
+        while (start < data.size() && isSpace(data[start])) ++start;
+        for (std::size_t i = start; i < data.size(); ++i) {
+            if (isSpace(data[i])) return { i + 1, data.substr(start, i - start), true, nullptr };
+        }
+        if (atEOF && data.size() > start) return { data.size(), data.substr(start), true, nullptr };
+        // Request more data, dropping the leading spaces
+        return { start, {}, false, nullptr };
+    }
+
+    SplitResult ScanBytes(std::string_view data, bool atEOF) {
+        if (atEOF && data.empty()) return {};
+        return { 1, data.substr(0, 1), true, nullptr };
+    }
+
+    // ------------------ Scanner ------------------
+
+    Scanner::Scanner(std::shared_ptr<io::Reader> rd)
+        : rd_(std::move(rd)), split_(ScanLines) {}
+
+    void Scanner::Split(SplitFunc split) {
+        if (scanCalled_) throw std::runtime_error("bufio.Scanner: Split called after Scan");
+        split_ = std::move(split);
+    }
+
+    void Scanner::Buffer(std::size_t initial, std::size_t max) {
+        if (scanCalled_) throw std::runtime_error("bufio.Scanner: Buffer called after Scan");
+        buf_.assign(initial, 0);
+        maxTokenSize_ = std::max(initial, max);
+    }
+
+    void Scanner::setErr(std::shared_ptr<Error> err) {
+        if (!err_ || err_ == io::ErrEOF) err_ = std::move(err);
+    }
+
+    std::shared_ptr<Error> Scanner::Err() const {
+        if (err_ == io::ErrEOF) return nullptr;
+        return err_;
+    }
+
+    bool Scanner::Scan() {
+        if (done_) return false;
+        scanCalled_ = true;
+
+        for (;;) {
+            // Try for a token in what is buffered; at the end, even if empty
+            if (end_ > start_ || err_) {
+                SplitResult res = split_(viewOf(buf_, start_, end_), err_ != nullptr);
+                if (res.err) {
+                    if (res.err == ErrFinalToken) {
+                        token_ = res.token;
+                        done_ = true;
+                        return res.hasToken;
+                    }
+                    setErr(res.err);
+                    done_ = true;
+                    return false;
+                }
+                if (res.advance > end_ - start_) {
+                    setErr(ErrAdvanceTooFar);
+                    done_ = true;
+                    return false;
+                }
+                start_ += res.advance;
+                if (res.hasToken) {
+                    token_ = res.token;
+                    if (!err_ || res.advance > 0) {
+                        empties_ = 0;
+                    } else if (++empties_ > maxConsecutiveEmptyReads) {
+                        throw std::runtime_error("bufio.Scanner: too many empty tokens without progressing");
+                    }
+                    return true;
+                }
+            }
+
+            if (err_) {
+                start_ = end_ = 0;
+                token_ = {};
+                done_ = true;
+                return false;
+            }
+
+            // Need more data: slide it to the front if that frees enough room
+            if (start_ > 0 && (end_ == buf_.size() || start_ > buf_.size() / 2)) {
+                std::memmove(buf_.data(), buf_.data() + start_, end_ - start_);
+                end_ -= start_;
+                start_ = 0;
+            }
+            // Buffer full of one token: grow it
+            if (end_ == buf_.size()) {
+                if (buf_.size() >= maxTokenSize_) {
+                    setErr(ErrTooLong);
+                    done_ = true;
+                    return false;
+                }
+                std::size_t newSize = buf_.empty() ? startBufSize : buf_.size() * 2;
+                std::vector<uint8_t> grown(std::min(newSize, maxTokenSize_));
+                if (end_ > start_) {  // buf_.data() is null before the first grow
+                    std::memcpy(grown.data(), buf_.data() + start_, end_ - start_);
+                }
+                buf_.swap(grown);
+                end_ -= start_;
+                start_ = 0;
+            }
+
+            auto res = rd_->Read(buf_.data() + end_, buf_.size() - end_);
+            end_ += std::min(res.value, buf_.size() - end_);
+            if (!res.Ok()) {
+                setErr(res.err);
+            } else if (res.value == 0) {
+                setErr(io::ErrEOF);
+            }
+        }
+    }
+
+} // namespace gocxx::bufio
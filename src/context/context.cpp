@@ -9,6 +9,7 @@
 #include <gocxx/errors/errors.h>
 #include <thread>
 #include <algorithm>
+#include <cstring>
 
 namespace gocxx {
 namespace context {
@@ -17,28 +18,93 @@ namespace context {
 const std::string Canceled = "context canceled";
 const std::string DeadlineExceeded = "context deadline exceeded";
 
+namespace {
+    // Deadline() is asked on every WithTimeout/WithDeadline; don't allocate for the common answer
+    const std::shared_ptr<gocxx::errors::Error>& ErrNoDeadline() {
+        static const auto err = gocxx::errors::New("no deadline");
+        return err;
+    }
+
+    const std::shared_ptr<gocxx::errors::Error>& ErrKeyNotFound() {
+        static const auto err = gocxx::errors::New("key not found");
+        return err;
+    }
+
+    // Compare legacy keys in place; any_cast<T>(&any) does not copy
+    template<typename K>
+    bool SameKey(const std::any& a, const std::any& b) {
+        const K* x = std::any_cast<K>(&a);
+        const K* y = std::any_cast<K>(&b);
+        return x && y && *x == *y;
+    }
+
+    bool KeysEqual(const std::any& a, const std::any& b) {
+        if (a.type() != b.type()) {
+            return false;
+        }
+        if (a.type() == typeid(const char*)) {
+            const char* x = *std::any_cast<const char*>(&a);
+            const char* y = *std::any_cast<const char*>(&b);
+            return x == y || (x && y && std::strcmp(x, y) == 0);
+        }
+        return SameKey<std::string>(a, b) || SameKey<int>(a, b);
+    }
+
+    // The two standard reasons share one error each
+    std::shared_ptr<gocxx::errors::Error> ErrFor(const std::string& reason) {
+        static const auto canceled = gocxx::errors::New(Canceled);
+        static const auto deadline_exceeded = gocxx::errors::New(DeadlineExceeded);
+        if (reason == Canceled) return canceled;
+        if (reason == DeadlineExceeded) return deadline_exceeded;
+        return gocxx::errors::New(reason);
+    }
+}
+
+// Context defaults
+
+bool Context::AddDoneWaiter(gocxx::base::ChanWaiter* waiter) const {
+    Done().impl()->addRecvWaiter(waiter);
+    return true;
+}
+
+void Context::RemoveDoneWaiter(gocxx::base::ChanWaiter* waiter) const {
+    Done().impl()->removeRecvWaiter(waiter);
+}
+
 // CancelContext implementation
 
 CancelContext::CancelContext(ContextPtr parent)
-    : parent_(parent), canceled_(false), done_chan_(1) {
-    // Initialize done channel as unbuffered, will be closed on cancellation
+    : parent_(parent), canceled_(false) {
+}
+
+CancelContext::~CancelContext() {
+    detachFromParent();
 }
 
 gocxx::base::Result<gocxx::time::Time> CancelContext::Deadline() const {
     if (parent_) {
         return parent_->Deadline();
     }
-    return gocxx::base::Result<gocxx::time::Time>(gocxx::errors::New("no deadline"));
+    return gocxx::base::Result<gocxx::time::Time>(ErrNoDeadline());
 }
 
-gocxx::base::Chan<bool> CancelContext::Done() const {
-    return done_chan_;
+const gocxx::base::Chan<bool>& CancelContext::Done() const {
+    if (!has_done_chan_.load(std::memory_order_acquire)) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!done_chan_) {
+            done_chan_.emplace(1);
+            if (canceled_.load(std::memory_order_relaxed)) {
+                done_chan_->close();
+            }
+            has_done_chan_.store(true, std::memory_order_release);
+        }
+    }
+    return *done_chan_;
 }
 
 gocxx::base::Result<void> CancelContext::Err() const {
-    std::lock_guard<std::mutex> lock(mutex_);
-    if (canceled_) {
-        return gocxx::base::Result<void>(gocxx::errors::New(err_));
+    if (canceled_.load(std::memory_order_acquire)) {
+        return gocxx::base::Result<void>(err_);
     }
     return gocxx::base::Result<void>();
 }
@@ -49,44 +115,132 @@ gocxx::base::Result<std::any> CancelContext::Value(const std::any& key) const {
         return parent_->Value(key);
     }
     
-    return gocxx::base::Result<std::any>(gocxx::errors::New("key not found"));
+    return gocxx::base::Result<std::any>(ErrKeyNotFound());
+}
+
+const std::any* CancelContext::LookupValue(const ContextKeyBase* key) const {
+    return parent_ ? parent_->LookupValue(key) : nullptr;
+}
+
+void CancelContext::CollectValues(ValueMap& values) const {
+    if (parent_) {
+        parent_->CollectValues(values);
+    }
+}
+
+bool CancelContext::AddDoneWaiter(gocxx::base::ChanWaiter* waiter) const {
+    Done().impl()->addRecvWaiter(waiter);
+    return true;
+}
+
+void CancelContext::RemoveDoneWaiter(gocxx::base::ChanWaiter* waiter) const {
+    Done().impl()->removeRecvWaiter(waiter);
 }
 
 void CancelContext::Cancel(const std::string& reason) {
+    // Iterative walk: deep trees must not recurse, and no two locks are held at once
+    std::vector<std::shared_ptr<CancelContext>> pending;
+    if (!cancelSelf(reason, pending)) {
+        return; // Already canceled
+    }
+    detachFromParent();
+    Canceled();
+
+    while (!pending.empty()) {
+        auto child = std::move(pending.back());
+        pending.pop_back();
+        if (child->cancelSelf(reason, pending)) {
+            child->Canceled();
+        }
+    }
+}
+
+bool CancelContext::cancelSelf(const std::string& reason,
+                               std::vector<std::shared_ptr<CancelContext>>& children) {
     std::lock_guard<std::mutex> lock(mutex_);
     
-    if (canceled_) {
-        return; // Already canceled
+    if (canceled_.load(std::memory_order_relaxed)) {
+        return false;
     }
     
-    canceled_ = true;
-    err_ = reason;
+    err_ = ErrFor(reason);
+    canceled_.store(true, std::memory_order_release);
     
-    // Close the done channel
-    done_chan_.close();
+    if (done_chan_) {
+        done_chan_->close();
+    }
     
-    // Cancel all children
-    for (auto it = children_.begin(); it != children_.end();) {
-        if (auto child = it->lock()) {
-            child->Cancel(reason);
-            ++it;
-        } else {
-            // Remove expired weak_ptr
-            it = children_.erase(it);
+    // Take the children out; they no longer need to unlink themselves
+    for (CancelContext* child = first_child_; child;) {
+        CancelContext* next = child->next_sibling_;
+        child->linked_ = false;
+        child->prev_sibling_ = child->next_sibling_ = nullptr;
+        // Fails only for a child whose destructor is already waiting on our mutex
+        if (auto alive = child->weak_from_this().lock()) {
+            children.push_back(std::move(alive));
+        }
+        child = next;
+    }
+    first_child_ = nullptr;
+    num_children_ = 0;
+    return true;
+}
+
+void CancelContext::detachFromParent() {
+    // The parent outlives us: parent_ owns it
+    CancelContext* parent = cancel_parent_.load();
+    if (parent) {
+        std::lock_guard<std::mutex> lock(parent->mutex_);
+        if (linked_) {
+            parent->unlinkChild(this);
         }
     }
 }
 
+void CancelContext::unlinkChild(CancelContext* child) {
+    if (child->prev_sibling_) {
+        child->prev_sibling_->next_sibling_ = child->next_sibling_;
+    } else {
+        first_child_ = child->next_sibling_;
+    }
+    if (child->next_sibling_) {
+        child->next_sibling_->prev_sibling_ = child->prev_sibling_;
+    }
+    child->prev_sibling_ = child->next_sibling_ = nullptr;
+    child->linked_ = false;
+    --num_children_;
+}
+
 void CancelContext::AddChild(std::shared_ptr<CancelContext> child) {
-    std::lock_guard<std::mutex> lock(mutex_);
-    
-    if (canceled_) {
-        // If already canceled, cancel the child immediately
-        child->Cancel(err_);
-        return;
+    std::shared_ptr<gocxx::errors::Error> err;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        
+        if (!canceled_.load(std::memory_order_relaxed)) {
+            if (child->IsCanceled()) {
+                return; // Nothing left to propagate
+            }
+            child->cancel_parent_.store(this);
+            child->prev_sibling_ = nullptr;
+            child->next_sibling_ = first_child_;
+            if (first_child_) {
+                first_child_->prev_sibling_ = child.get();
+            }
+            first_child_ = child.get();
+            child->linked_ = true;
+            ++num_children_;
+            return;
+        }
+        err = err_;
     }
     
-    children_.push_back(std::weak_ptr<CancelContext>(child));
+    // Already canceled: cancel the child immediately
+    child->Cancel(err->error());
+}
+
+std::size_t CancelContext::NumChildren() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return num_children_;
 }
 
 // TimerContext implementation
@@ -102,9 +256,9 @@ TimerContext::TimerContext(ContextPtr parent, gocxx::time::Duration timeout)
 }
 
 TimerContext::~TimerContext() {
-    if (timer_thread_ && timer_thread_->joinable()) {
-        Cancel("destructor called");
-        timer_thread_->join();
+    // The callback refers to this object: make sure it is neither pending nor running
+    if (timer_) {
+        gocxx::time::TimerService::Global().DisarmSync(timer_);
     }
 }
 
@@ -112,18 +266,28 @@ gocxx::base::Result<gocxx::time::Time> TimerContext::Deadline() const {
     return gocxx::base::Result<gocxx::time::Time>(deadline_);
 }
 
+void TimerContext::Canceled() {
+    // Release the heap slot now rather than when the deadline passes
+    if (timer_) {
+        gocxx::time::TimerService::Global().Disarm(timer_);
+    }
+}
+
 void TimerContext::StartTimer() {
-    timer_thread_ = std::make_unique<std::thread>([this]() {
-        auto now = gocxx::time::Time::Now();
-        if (deadline_.After(now)) {
-            auto duration = deadline_.Sub(now);
-            std::this_thread::sleep_for(duration.ToStdDuration());
-        }
-        
+    auto remaining = deadline_.Sub(gocxx::time::Time::Now());
+    if (remaining.Nanoseconds() <= 0) {
+        // Already expired: no timer needed
+        Cancel(DeadlineExceeded);
+        return;
+    }
+
+    auto& service = gocxx::time::TimerService::Global();
+    timer_ = service.Create([this]() {
         if (!IsCanceled()) {
             Cancel(DeadlineExceeded);
         }
     });
+    service.ArmAfter(timer_, remaining);
 }
 
 // ValueContext implementation
@@ -132,14 +296,18 @@ ValueContext::ValueContext(ContextPtr parent, const std::any& key, const std::an
     : parent_(parent), key_(key), value_(value) {
 }
 
+ValueContext::ValueContext(ContextPtr parent, const ContextKeyBase* key, std::any value)
+    : parent_(std::move(parent)), typed_key_(key), value_(std::move(value)) {
+}
+
 gocxx::base::Result<gocxx::time::Time> ValueContext::Deadline() const {
     if (parent_) {
         return parent_->Deadline();
     }
-    return gocxx::base::Result<gocxx::time::Time>(gocxx::errors::New("no deadline"));
+    return gocxx::base::Result<gocxx::time::Time>(ErrNoDeadline());
 }
 
-gocxx::base::Chan<bool> ValueContext::Done() const {
+const gocxx::base::Chan<bool>& ValueContext::Done() const {
     if (parent_) {
         return parent_->Done();
     }
@@ -155,32 +323,22 @@ gocxx::base::Result<void> ValueContext::Err() const {
     return gocxx::base::Result<void>();
 }
 
+bool ValueContext::IsCanceled() const {
+    return parent_ && parent_->IsCanceled();
+}
+
+bool ValueContext::AddDoneWaiter(gocxx::base::ChanWaiter* waiter) const {
+    return parent_ && parent_->AddDoneWaiter(waiter);
+}
+
+void ValueContext::RemoveDoneWaiter(gocxx::base::ChanWaiter* waiter) const {
+    if (parent_) parent_->RemoveDoneWaiter(waiter);
+}
+
 gocxx::base::Result<std::any> ValueContext::Value(const std::any& key) const {
-    // Check if this is the key we're storing
-    if (key_.type() == key.type()) {
-        try {
-            if (key_.type() == typeid(std::string)) {
-                auto our_key = std::any_cast<std::string>(key_);
-                auto search_key = std::any_cast<std::string>(key);
-                if (our_key == search_key) {
-                    return gocxx::base::Result<std::any>(value_);
-                }
-            } else if (key_.type() == typeid(int)) {
-                auto our_key = std::any_cast<int>(key_);
-                auto search_key = std::any_cast<int>(key);
-                if (our_key == search_key) {
-                    return gocxx::base::Result<std::any>(value_);
-                }
-            } else if (key_.type() == typeid(const char*)) {
-                auto our_key = std::any_cast<const char*>(key_);
-                auto search_key = std::any_cast<const char*>(key);
-                if (std::string(our_key) == std::string(search_key)) {
-                    return gocxx::base::Result<std::any>(value_);
-                }
-            }
-        } catch (const std::bad_any_cast&) {
-            // Keys don't match, continue to parent
-        }
+    // Typed entries have no std::any key and never match here
+    if (!typed_key_ && KeysEqual(key_, key)) {
+        return gocxx::base::Result<std::any>(value_);
     }
     
     // Check parent
@@ -188,16 +346,77 @@ gocxx::base::Result<std::any> ValueContext::Value(const std::any& key) const {
         return parent_->Value(key);
     }
     
-    return gocxx::base::Result<std::any>(gocxx::errors::New("key not found"));
+    return gocxx::base::Result<std::any>(ErrKeyNotFound());
+}
+
+const std::any* ValueContext::LookupValue(const ContextKeyBase* key) const {
+    if (typed_key_ == key) {
+        return &value_;
+    }
+    return parent_ ? parent_->LookupValue(key) : nullptr;
+}
+
+void ValueContext::CollectValues(ValueMap& values) const {
+    if (typed_key_) {
+        values.emplace(typed_key_, &value_);
+    }
+    if (parent_) {
+        parent_->CollectValues(values);
+    }
+}
+
+// FlatValueContext implementation
+
+FlatValueContext::FlatValueContext(ContextPtr parent)
+    : parent_(std::move(parent)) {
+    parent_->CollectValues(values_);
+}
+
+gocxx::base::Result<gocxx::time::Time> FlatValueContext::Deadline() const {
+    return parent_->Deadline();
+}
+
+const gocxx::base::Chan<bool>& FlatValueContext::Done() const {
+    return parent_->Done();
+}
+
+gocxx::base::Result<void> FlatValueContext::Err() const {
+    return parent_->Err();
+}
+
+gocxx::base::Result<std::any> FlatValueContext::Value(const std::any& key) const {
+    return parent_->Value(key);
+}
+
+const std::any* FlatValueContext::LookupValue(const ContextKeyBase* key) const {
+    // The snapshot holds every typed value of the chain: a miss is final
+    auto it = values_.find(key);
+    return it == values_.end() ? nullptr : it->second;
+}
+
+void FlatValueContext::CollectValues(ValueMap& values) const {
+    values.insert(values_.begin(), values_.end());
+}
+
+bool FlatValueContext::IsCanceled() const {
+    return parent_->IsCanceled();
+}
+
+bool FlatValueContext::AddDoneWaiter(gocxx::base::ChanWaiter* waiter) const {
+    return parent_->AddDoneWaiter(waiter);
+}
+
+void FlatValueContext::RemoveDoneWaiter(gocxx::base::ChanWaiter* waiter) const {
+    parent_->RemoveDoneWaiter(waiter);
 }
 
 // BackgroundContext implementation
 
 gocxx::base::Result<gocxx::time::Time> BackgroundContext::Deadline() const {
-    return gocxx::base::Result<gocxx::time::Time>(gocxx::errors::New("no deadline"));
+    return gocxx::base::Result<gocxx::time::Time>(ErrNoDeadline());
 }
 
-gocxx::base::Chan<bool> BackgroundContext::Done() const {
+const gocxx::base::Chan<bool>& BackgroundContext::Done() const {
     // Return a never-closing channel
     static gocxx::base::Chan<bool> never_done(1);
     return never_done;
@@ -208,9 +427,32 @@ gocxx::base::Result<void> BackgroundContext::Err() const {
 }
 
 gocxx::base::Result<std::any> BackgroundContext::Value(const std::any& key) const {
-    return gocxx::base::Result<std::any>(gocxx::errors::New("key not found"));
+    return gocxx::base::Result<std::any>(ErrKeyNotFound());
+}
+
+namespace detail {
+
+std::shared_ptr<CancelContext> cancelAncestor(const ContextPtr& ctx) {
+    const Context* node = ctx.get();
+    ContextPtr current = ctx;
+    while (current) {
+        if (auto cancel_ctx = std::dynamic_pointer_cast<CancelContext>(current)) {
+            return cancel_ctx;
+        }
+        if (auto* value_ctx = dynamic_cast<const ValueContext*>(node)) {
+            current = value_ctx->parent_;
+        } else if (auto* flat_ctx = dynamic_cast<const FlatValueContext*>(node)) {
+            current = flat_ctx->parent_;
+        } else {
+            break;
+        }
+        node = current.get();
+    }
+    return nullptr;
 }
 
+} // namespace detail
+
 // Factory functions - exact Go API
 
 ContextPtr Background() {
@@ -230,9 +472,9 @@ gocxx::base::Result<std::pair<ContextPtr, CancelFunc>> WithCancel(ContextPtr par
     
     auto cancel_ctx = std::make_shared<CancelContext>(parent);
     
-    // If parent is also a CancelContext, add this as a child
-    if (auto parent_cancel_ctx = std::dynamic_pointer_cast<CancelContext>(parent)) {
-        parent_cancel_ctx->AddChild(cancel_ctx);
+    // Link to the nearest cancelable ancestor, past any value layers
+    if (auto ancestor = detail::cancelAncestor(parent)) {
+        ancestor->AddChild(cancel_ctx);
     }
     
     CancelFunc cancel_func = [cancel_ctx]() {
@@ -248,24 +490,7 @@ gocxx::base::Result<std::pair<ContextPtr, CancelFunc>> WithTimeout(
     ContextPtr parent, 
     gocxx::time::Duration timeout) {
     
-    if (!parent) {
-        return gocxx::base::Result<std::pair<ContextPtr, CancelFunc>>(gocxx::errors::New("parent context is nil"));
-    }
-    
-    auto timer_ctx = std::make_shared<TimerContext>(parent, timeout);
-    
-    // If parent is a CancelContext, add this as a child
-    if (auto parent_cancel_ctx = std::dynamic_pointer_cast<CancelContext>(parent)) {
-        parent_cancel_ctx->AddChild(timer_ctx);
-    }
-    
-    CancelFunc cancel_func = [timer_ctx]() {
-        timer_ctx->Cancel();
-    };
-    
-    return gocxx::base::Result<std::pair<ContextPtr, CancelFunc>>(
-        std::make_pair(timer_ctx, cancel_func)
-    );
+    return WithDeadline(parent, gocxx::time::Time::Now().Add(timeout));
 }
 
 gocxx::base::Result<std::pair<ContextPtr, CancelFunc>> WithDeadline(
@@ -276,11 +501,18 @@ gocxx::base::Result<std::pair<ContextPtr, CancelFunc>> WithDeadline(
         return gocxx::base::Result<std::pair<ContextPtr, CancelFunc>>(gocxx::errors::New("parent context is nil"));
     }
     
+    // The parent's deadline comes first: it will cancel us in time, but only
+    // if we are linked to a cancelable ancestor that propagates it
+    auto ancestor = detail::cancelAncestor(parent);
+    auto parent_deadline = parent->Deadline();
+    if (ancestor && parent_deadline.Ok() && parent_deadline.value.Before(deadline)) {
+        return WithCancel(parent);
+    }
+    
     auto timer_ctx = std::make_shared<TimerContext>(parent, deadline);
     
-    // If parent is a CancelContext, add this as a child
-    if (auto parent_cancel_ctx = std::dynamic_pointer_cast<CancelContext>(parent)) {
-        parent_cancel_ctx->AddChild(timer_ctx);
+    if (ancestor) {
+        ancestor->AddChild(timer_ctx);
     }
     
     CancelFunc cancel_func = [timer_ctx]() {
@@ -305,32 +537,30 @@ gocxx::base::Result<ContextPtr> WithValue(
     return gocxx::base::Result<ContextPtr>(value_ctx);
 }
 
+gocxx::base::Result<ContextPtr> Flatten(ContextPtr ctx) {
+    if (!ctx) {
+        return gocxx::base::Result<ContextPtr>(gocxx::errors::New("context is nil"));
+    }
+    
+    return gocxx::base::Result<ContextPtr>(std::make_shared<FlatValueContext>(std::move(ctx)));
+}
+
 // Utility functions
 
 gocxx::base::Result<void> SleepWithContext(ContextPtr ctx, gocxx::time::Duration duration) {
     if (!ctx) {
-        std::this_thread::sleep_for(duration.ToStdDuration());
+        gocxx::time::Sleep(duration);
         return gocxx::base::Result<void>();
     }
-    
-    auto start = gocxx::time::Time::Now();
-    auto end = start.Add(duration);
-    
-    while (gocxx::time::Time::Now().Before(end)) {
-        auto err_result = ctx->Err();
-        if (!err_result.Ok()) {
-            return gocxx::base::Result<void>(gocxx::errors::New("context canceled during sleep"));
-        }
-        
-        // Sleep in small increments to check cancellation
-        auto remaining = end.Sub(gocxx::time::Time::Now());
-        auto sleep_duration = std::min(remaining, gocxx::time::Milliseconds(10));
-        
-        if (sleep_duration.Nanoseconds() > 0) {
-            std::this_thread::sleep_for(sleep_duration.ToStdDuration());
-        }
+
+    // One wait on the cancellation signal and the deadline; a task is
+    // suspended, not its thread
+    if (duration.Nanoseconds() > 0) {
+        gocxx::base::select(
+            doneCase(ctx, [] {}),
+            gocxx::base::timeoutCase(duration, [] {}));
     }
-    
+
     auto final_err = ctx->Err();
     if (!final_err.Ok()) {
         return gocxx::base::Result<void>(gocxx::errors::New("context canceled during sleep"));
@@ -343,19 +573,13 @@ gocxx::base::Result<bool> WaitForContext(ContextPtr ctx, gocxx::time::Duration t
     if (!ctx) {
         return gocxx::base::Result<bool>(gocxx::errors::New("context is nil"));
     }
-    
-    auto start = gocxx::time::Time::Now();
-    auto end = start.Add(timeout);
-    
-    while (gocxx::time::Time::Now().Before(end)) {
-        auto err_result = ctx->Err();
-        if (!err_result.Ok()) {
-            return gocxx::base::Result<bool>(true); // Context was canceled
-        }
-        
-        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+    if (timeout.Nanoseconds() > 0) {
+        gocxx::base::select(
+            doneCase(ctx, [] {}),
+            gocxx::base::timeoutCase(timeout, [] {}));
     }
-    
+
     auto final_err = ctx->Err();
     return gocxx::base::Result<bool>(!final_err.Ok());
 }
@@ -1,9 +1,13 @@
 #include "gocxx/io/io.h"
 #include "gocxx/io/io_errors.h"
 
+#include <gocxx/runtime/condvar.h>
+
+#include <algorithm>
+#include <cstring>
 #include <memory>
 #include <mutex>
-#include <deque>
+#include <optional>
 
 namespace gocxx::io {
 
@@ -11,69 +15,58 @@ namespace gocxx::io {
     using gocxx::errors::Error;
     using gocxx::base::Result;
 
-    Result<std::size_t> Copy(std::shared_ptr<Writer> dest, std::shared_ptr<Reader> source) {
-        constexpr std::size_t bufferSize = 8192;
-        std::unique_ptr<uint8_t[]> buffer(new uint8_t[bufferSize]);
-        std::size_t totalBytes = 0;
-
-        while (true) {
-            auto res = source->Read(buffer.get(), bufferSize);
-            if (!res.Ok()) {
-                if (errors::Is(res.err, ErrEOF)) break;
-                return Result<std::size_t>{ totalBytes, res.err };
+    namespace {
+
+        Result<std::size_t> copyLoop(Writer& dst, Reader& src, uint8_t* buf, std::size_t size) {
+            std::size_t total = 0;
+            while (true) {
+                auto rres = src.Read(buf, size);
+                if (rres.value > 0) {
+                    auto wres = dst.Write(buf, rres.value);
+                    total += wres.value;
+                    if (!wres.Ok()) return { total, wres.err };
+                    if (wres.value < rres.value) return { total, ErrShortWrite };
+                }
+                if (!rres.Ok()) {
+                    if (errors::Is(rres.err, ErrEOF)) break;
+                    return { total, rres.err };
+                }
+                if (rres.value == 0) break;  // 0 = EOF
             }
+            return { total, nullptr };
+        }
 
-            if (res.value > 0) {
-                auto wres = dest->Write(buffer.get(), res.value);
-                if (!wres.Ok()) return { totalBytes, wres.err };
-                totalBytes += wres.value;
-            }
+        // Lets either end do the copy itself, e.g. os::File with a kernel-side copy
+        std::optional<Result<std::size_t>> copyDirect(const std::shared_ptr<Writer>& dst, const std::shared_ptr<Reader>& src) {
+            if (auto* wt = dynamic_cast<WriterTo*>(src.get())) return wt->WriteTo(dst);
+            if (auto* rf = dynamic_cast<ReaderFrom*>(dst.get())) return rf->ReadFrom(src);
+            return std::nullopt;
         }
 
-        return {totalBytes,nullptr};
+    } // namespace
+
+    Result<std::size_t> Copy(std::shared_ptr<Writer> dest, std::shared_ptr<Reader> source) {
+        if (auto res = copyDirect(dest, source)) return *res;
+
+        constexpr std::size_t bufferSize = 8192;
+        std::unique_ptr<uint8_t[]> buffer(new uint8_t[bufferSize]);
+        return copyLoop(*dest, *source, buffer.get(), bufferSize);
     }
 
     Result<std::size_t> CopyBuffer(std::shared_ptr<Writer> dst, std::shared_ptr<Reader> src, uint8_t* buf, std::size_t size) {
         if (!buf || size == 0) {
             return { 0, ErrUnknownIO };
         }
-
-        std::size_t total = 0;
-        while (true) {
-            auto rres = src->Read(buf, size);
-            if (rres.value > 0) {
-                auto wres = dst->Write(buf, rres.value);
-                if (!wres.Ok()) return { total, wres.err };
-                total += wres.value;
-            }
-            if (!rres.Ok()) return { total, rres.err };
-        }
-		return { total, nullptr };
+        if (auto res = copyDirect(dst, src)) return *res;
+        return copyLoop(*dst, *src, buf, size);
     }
 
     Result<std::size_t> CopyN(std::shared_ptr<Writer> dst, std::shared_ptr<Reader> src, std::size_t n) {
-        std::vector<uint8_t> buf(4096);
-        std::size_t total = 0;
-
-        while (total < n) {
-            std::size_t toRead = std::min(buf.size(), n - total);
-            auto rres = src->Read(buf.data(), toRead);
-
-            if (rres.value > 0) {
-                auto wres = dst->Write(buf.data(), rres.value);
-                if (!wres.Ok()) return { total, wres.err };
-                total += wres.value;
-            }
-
-            if (!rres.Ok()) {
-                if (errors::Is(rres.err, ErrEOF)) {
-                    return { total, errors::Cause(ErrUnexpectedEOF,rres.err)};
-                }
-                return { total, rres.err };
-            }
+        auto res = Copy(dst, std::make_shared<LimitedReader>(src, n));
+        if (res.Ok() && res.value < n) {
+            return { res.value, errors::Cause(ErrUnexpectedEOF, ErrEOF) };
         }
-
-        return total;
+        return res;
     }
 
     Result<std::size_t> ReadAll(std::shared_ptr<Reader> r, std::vector<uint8_t>& out) {
@@ -218,60 +211,142 @@ namespace gocxx::io {
 
         // --- SharedPipe ---
 
+        /**
+         * Both ends of a Pipe(). Buffered, writes are copied into a fixed ring
+         * and a full ring blocks the writer. In zero-copy mode the writer
+         * posts its own buffer and readers copy straight out of it. Writes
+         * are serialized, as in Go, so each one reaches readers contiguously.
+         * A side is woken only when the other finds it waiting: a reader
+         * when the ring stops being empty, a writer when it stops being full.
+         */
         class SharedPipe {
         public:
-            std::mutex mtx;
-            std::condition_variable cv;
-
-            std::deque<uint8_t> buffer;
-            bool closed = false;
-            std::shared_ptr<errors::Error> closeError = nullptr;
+            explicit SharedPipe(const PipeOptions& options)
+                : capacity(options.zeroCopy ? 0 : options.bufferSize),
+                  ring(capacity ? new uint8_t[capacity] : nullptr) {}
 
             gocxx::base::Result<std::size_t> Write(const uint8_t* data, std::size_t size) {
-                if (!data) return { 0, errors::New("Pipe Write: null buffer") };
+                if (!data && size) return { 0, errors::New("Pipe Write: null buffer") };
 
-                std::unique_lock lock(mtx);
+                std::unique_lock<std::mutex> lock(mtx);
+                ++writersQueued;
+                turn.wait(lock, [this] { return !writing || closed; });
+                --writersQueued;
                 if (closed) {
                     return { 0, errors::New("Pipe Write: closed") };
                 }
+                writing = true;
 
-                buffer.insert(buffer.end(), data, data + size);
-                cv.notify_all();
+                std::size_t done = capacity ? fill(lock, data, size) : post(lock, data, size);
+
+                writing = false;
+                if (writersQueued) turn.notify_one();
+                if (done < size) return { done, errors::New("Pipe Write: closed") };
                 return { size };
             }
 
             gocxx::base::Result<std::size_t> Read(uint8_t* out, std::size_t size) {
                 if (!out) return { 0, errors::New("Pipe Read: null buffer") };
 
-                std::unique_lock lock(mtx);
-                while (buffer.empty() && !closed) {
-                    cv.wait(lock);
-                }
+                std::unique_lock<std::mutex> lock(mtx);
+                ++readersWaiting;
+                readable.wait(lock, [this] { return count || pendingLen || closed; });
+                --readersWaiting;
 
                 std::size_t n = 0;
-                while (!buffer.empty() && n < size) {
-                    out[n++] = buffer.front();
-                    buffer.pop_front();
+                if (count) {
+                    n = std::min(size, count);
+                    std::size_t first = std::min(n, capacity - head);
+                    std::memcpy(out, ring.get() + head, first);
+                    std::memcpy(out + first, ring.get(), n - first);
+                    bool wasFull = count == capacity;
+                    count -= n;
+                    head = count ? (head + n) % capacity : 0;
+                    if (wasFull && writerBlocked) writable.notify_one();
+                    if (count && readersWaiting) readable.notify_one();
+                } else if (pendingLen) {
+                    n = std::min(size, pendingLen);
+                    std::memcpy(out, pending, n);
+                    pending += n;
+                    pendingLen -= n;
+                    if (!pendingLen) {
+                        writable.notify_one();
+                    } else if (readersWaiting) {
+                        readable.notify_one();
+                    }
                 }
 
-                if (n > 0) return { n };
-
-                if (closed) {
-                    return { 0, closeError ? closeError : ErrEOF };
-                }
-
-                return { 0, errors::New("Pipe Read: unknown error state") };
+                if (n > 0 || size == 0) return { n };
+                return { 0, closeError ? closeError : ErrEOF };
             }
 
             gocxx::base::Result<std::size_t> Close(const std::shared_ptr<errors::Error>& err) {
-                std::unique_lock lock(mtx);
+                std::lock_guard<std::mutex> lock(mtx);
                 if (!closed) {
                     closed = true;
                     closeError = err;
-                    cv.notify_all();
+                    readable.notify_all();
+                    writable.notify_all();
+                    turn.notify_all();
                 }
                 return { 0 };
             }
+
+        private:
+            // Copy into the ring, waiting for space while it is full
+            std::size_t fill(std::unique_lock<std::mutex>& lock, const uint8_t* data, std::size_t size) {
+                std::size_t done = 0;
+                while (done < size && !closed) {
+                    if (count == capacity) {
+                        writerBlocked = true;
+                        writable.wait(lock);
+                        writerBlocked = false;
+                        continue;
+                    }
+                    std::size_t n = std::min(size - done, capacity - count);
+                    std::size_t tail = (head + count) % capacity;
+                    std::size_t first = std::min(n, capacity - tail);
+                    std::memcpy(ring.get() + tail, data + done, first);
+                    std::memcpy(ring.get(), data + done + first, n - first);
+                    bool wasEmpty = count == 0;
+                    count += n;
+                    done += n;
+                    if (wasEmpty && readersWaiting) readable.notify_one();
+                }
+                return done;
+            }
+
+            // Lend the caller's buffer to readers until they have copied all of it
+            std::size_t post(std::unique_lock<std::mutex>& lock, const uint8_t* data, std::size_t size) {
+                pending = data;
+                pendingLen = size;
+                if (size && readersWaiting) readable.notify_one();
+                writable.wait(lock, [this] { return !pendingLen || closed; });
+                std::size_t done = size - pendingLen;
+                pending = nullptr;
+                pendingLen = 0;
+                return done;
+            }
+
+            const std::size_t capacity;       // 0 in zero-copy mode
+            std::unique_ptr<uint8_t[]> ring;
+            std::size_t head = 0;             // Oldest unread byte
+            std::size_t count = 0;            // Unread bytes in the ring
+
+            const uint8_t* pending = nullptr;  // Zero-copy: the active writer's unread bytes
+            std::size_t pendingLen = 0;
+
+            std::mutex mtx;
+            gocxx::runtime::CondVar readable;  // Readers wait for data
+            gocxx::runtime::CondVar writable;  // The active writer waits for space or for readers
+            gocxx::runtime::CondVar turn;      // Other writers wait for the active one
+            uint32_t readersWaiting = 0;
+            uint32_t writersQueued = 0;
+            bool writerBlocked = false;
+            bool writing = false;
+
+            bool closed = false;
+            std::shared_ptr<errors::Error> closeError = nullptr;
         };
 
         // --- PipeReaderImpl ---
@@ -321,7 +396,11 @@ namespace gocxx::io {
         // --- Pipe creation ---
 
         std::pair<std::shared_ptr<PipeReader>, std::shared_ptr<PipeWriter>> Pipe() {
-            auto pipe = std::make_shared<SharedPipe>();
+            return Pipe(PipeOptions());
+        }
+
+        std::pair<std::shared_ptr<PipeReader>, std::shared_ptr<PipeWriter>> Pipe(const PipeOptions& options) {
+            auto pipe = std::make_shared<SharedPipe>(options);
             return {
                 std::make_shared<PipeReaderImpl>(pipe),
                 std::make_shared<PipeWriterImpl>(pipe)
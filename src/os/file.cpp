@@ -1,6 +1,9 @@
 #include "gocxx/os/file.h"
+#include "gocxx/io/io_errors.h"
 #include <errno.h>
 #include <cstring>
+#include <algorithm>
+#include <limits>
 #include <random>
 
 #ifdef _WIN32
@@ -38,7 +41,12 @@
 #include <sys/stat.h>
 #include <dirent.h>
 #include <fcntl.h>
+#include <climits>
+#include <sys/uio.h>
 #include <cstring>
+#ifdef __linux__
+#include <sys/sendfile.h>
+#endif
 extern char** environ;
 #define PATH_SEPARATOR '/'
 #define O_CREATE O_CREAT
@@ -164,6 +172,56 @@ namespace gocxx::os {
         }
     }
 
+#ifndef _WIN32
+    namespace {
+
+        /**
+         * Calls call(iov, count, offset) until every buffer has been transferred,
+         * resuming after partial transfers. Returns the bytes moved; sets err to
+         * errno on failure, or eof if a call moves nothing.
+         */
+        template<typename Vec, typename Call>
+        std::size_t transferAt(const std::vector<Vec>& buffers, std::size_t offset, Call call, int& err, bool& eof) {
+            std::vector<struct iovec> iov;
+            iov.reserve(buffers.size());
+            for (const auto& b : buffers) {
+                if (b.size > 0) iov.push_back({const_cast<uint8_t*>(b.data), b.size});
+            }
+
+            std::size_t total = 0;
+            std::size_t first = 0;
+            while (first < iov.size()) {
+                int count = static_cast<int>(std::min<std::size_t>(iov.size() - first, IOV_MAX));
+                ssize_t n = call(iov.data() + first, count, static_cast<off_t>(offset + total));
+                if (n < 0) {
+                    if (errno == EINTR) continue;
+                    err = errno;
+                    break;
+                }
+                if (n == 0) {
+                    eof = true;
+                    break;
+                }
+                total += static_cast<std::size_t>(n);
+
+                auto left = static_cast<std::size_t>(n);
+                while (first < iov.size() && left >= iov[first].iov_len) {
+                    left -= iov[first].iov_len;
+                    ++first;
+                }
+                if (left > 0) {
+                    iov[first].iov_base = static_cast<uint8_t*>(iov[first].iov_base) + left;
+                    iov[first].iov_len -= left;
+                }
+            }
+            return total;
+        }
+
+    } // namespace
+#endif
+
+    // The POSIX paths use pread/pwrite, which leave the file offset alone:
+    // one system call per transfer, and safe to call from several threads.
     gocxx::base::Result<std::size_t> File::ReadAt(uint8_t* buffer, std::size_t size, std::size_t offset) {
         if (closed) {
             return {0, ErrClosed};
@@ -171,15 +229,27 @@ namespace gocxx::os {
 
 #ifdef _WIN32
         auto seekRes = _lseek(fd, static_cast<long>(offset), SEEK_SET);
-#else
-        auto seekRes = lseek(fd, static_cast<off_t>(offset), SEEK_SET);
-#endif
         if (seekRes < 0) {
             auto err = std::make_shared<PathError>("readAt-lseek", name, errnoToError(errno));
             return {0, err};
         }
 
         return Read(buffer, size);
+#else
+        std::size_t total = 0;
+        while (total < size) {
+            ssize_t n = ::pread(fd, buffer + total, size - total, static_cast<off_t>(offset + total));
+            if (n < 0) {
+                if (errno == EINTR) continue;
+                return {total, std::make_shared<PathError>("read", name, errnoToError(errno))};
+            }
+            if (n == 0) {
+                return {total, gocxx::io::ErrEOF};
+            }
+            total += static_cast<std::size_t>(n);
+        }
+        return {total, nullptr};
+#endif
     }
 
     gocxx::base::Result<std::size_t> File::WriteAt(const uint8_t* buffer, std::size_t size, std::size_t offset) {
@@ -189,15 +259,87 @@ namespace gocxx::os {
         
 #ifdef _WIN32
         auto seekRes = _lseek(fd, static_cast<long>(offset), SEEK_SET);
-#else
-        auto seekRes = lseek(fd, static_cast<off_t>(offset), SEEK_SET);
-#endif
         if (seekRes < 0) {
             auto err = std::make_shared<PathError>("writeAt-lseek", name, errnoToError(errno));
             return {0, err};
         }
         
         return Write(buffer, size);
+#else
+        std::size_t total = 0;
+        while (total < size) {
+            ssize_t n = ::pwrite(fd, buffer + total, size - total, static_cast<off_t>(offset + total));
+            if (n < 0) {
+                if (errno == EINTR) continue;
+                return {total, std::make_shared<PathError>("write", name, errnoToError(errno))};
+            }
+            if (n == 0) {
+                return {total, gocxx::io::ErrShortWrite};
+            }
+            total += static_cast<std::size_t>(n);
+        }
+        return {total, nullptr};
+#endif
+    }
+
+    gocxx::base::Result<std::size_t> File::ReadvAt(const std::vector<IOVec>& buffers, std::size_t offset) {
+        if (closed) {
+            return {0, ErrClosed};
+        }
+
+#ifdef _WIN32
+        std::size_t total = 0;
+        for (const auto& b : buffers) {
+            auto res = ReadAt(b.data, b.size, offset + total);
+            total += res.value;
+            if (!res.Ok() || res.value < b.size) return {total, res.err ? res.err : gocxx::io::ErrEOF};
+        }
+        return {total, nullptr};
+#else
+        int err = 0;
+        bool eof = false;
+        std::size_t total = transferAt(buffers, offset, [this](const struct iovec* iov, int count, off_t off) {
+#if defined(__linux__) || defined(__FreeBSD__)
+            return ::preadv(fd, iov, count, off);
+#else
+            (void)count;
+            return ::pread(fd, iov->iov_base, iov->iov_len, off);
+#endif
+        }, err, eof);
+        if (err) return {total, std::make_shared<PathError>("read", name, errnoToError(err))};
+        if (eof) return {total, gocxx::io::ErrEOF};
+        return {total, nullptr};
+#endif
+    }
+
+    gocxx::base::Result<std::size_t> File::WritevAt(const std::vector<ConstIOVec>& buffers, std::size_t offset) {
+        if (closed) {
+            return {0, ErrClosed};
+        }
+
+#ifdef _WIN32
+        std::size_t total = 0;
+        for (const auto& b : buffers) {
+            auto res = WriteAt(b.data, b.size, offset + total);
+            total += res.value;
+            if (!res.Ok()) return {total, res.err};
+        }
+        return {total, nullptr};
+#else
+        int err = 0;
+        bool eof = false;
+        std::size_t total = transferAt(buffers, offset, [this](const struct iovec* iov, int count, off_t off) {
+#if defined(__linux__) || defined(__FreeBSD__)
+            return ::pwritev(fd, iov, count, off);
+#else
+            (void)count;
+            return ::pwrite(fd, iov->iov_base, iov->iov_len, off);
+#endif
+        }, err, eof);
+        if (err) return {total, std::make_shared<PathError>("write", name, errnoToError(err))};
+        if (eof) return {total, gocxx::io::ErrShortWrite};
+        return {total, nullptr};
+#endif
     }
 
     gocxx::base::Result<std::size_t> File::Seek(std::size_t offset, gocxx::io::whence whence) {
@@ -228,6 +370,140 @@ namespace gocxx::os {
         return {static_cast<std::size_t>(result), nullptr};
     }
 
+    namespace {
+
+        // Hide File's WriterTo/ReaderFrom so io::Copy falls back to its Read/Write loop
+        struct plainReader : gocxx::io::Reader {
+            explicit plainReader(File& f) : f(f) {}
+            gocxx::base::Result<std::size_t> Read(uint8_t* buffer, std::size_t size) override {
+                return f.Read(buffer, size);
+            }
+            File& f;
+        };
+
+        struct plainWriter : gocxx::io::Writer {
+            explicit plainWriter(File& f) : f(f) {}
+            gocxx::base::Result<std::size_t> Write(const uint8_t* buffer, std::size_t size) override {
+                return f.Write(buffer, size);
+            }
+            File& f;
+        };
+
+#ifdef __linux__
+        constexpr std::size_t maxKernelCopy = 1 << 30;
+
+        // errno values meaning "this call cannot copy between these descriptors"
+        bool unsupported(int err) {
+            return err == EXDEV || err == EINVAL || err == ENOSYS || err == EOPNOTSUPP ||
+                   err == EBADF || err == EPERM || err == EAGAIN;
+        }
+
+        /**
+         * Calls step(chunk) until EOF, limit bytes or an error, adding to total.
+         * Returns false if the call stopped applying (unsupported, or nothing to
+         * copy on the first try, as some file systems report) so the caller can
+         * go on another way. On any other error, sets err to errno.
+         */
+        template<typename Step>
+        bool kernelCopy(Step step, std::size_t limit, std::size_t& total, int& err) {
+            while (total < limit) {
+                ssize_t n = step(std::min(limit - total, maxKernelCopy));
+                if (n < 0) {
+                    if (errno == EINTR) continue;
+                    if (unsupported(errno)) return false;
+                    err = errno;
+                    return true;
+                }
+                if (n == 0) return total > 0;
+                total += static_cast<std::size_t>(n);
+            }
+            return true;
+        }
+#endif
+
+    } // namespace
+
+    gocxx::base::Result<std::size_t> File::copyFrom(File& src, std::size_t limit, bool& done) {
+        done = false;
+        std::size_t total = 0;
+#ifdef __linux__
+        struct stat srcStat, dstStat;
+        if (::fstat(src.fd, &srcStat) < 0 || ::fstat(fd, &dstStat) < 0) {
+            return {0, nullptr};
+        }
+
+        int err = 0;
+        auto finish = [&](const char* op) -> gocxx::base::Result<std::size_t> {
+            done = true;
+            if (err) return {total, std::make_shared<PathError>(op, name, errnoToError(err))};
+            return {total, nullptr};
+        };
+
+        if (S_ISREG(srcStat.st_mode) && S_ISREG(dstStat.st_mode)) {
+            // Same file system: the kernel may share extents or offload the copy entirely
+            if (kernelCopy([&](std::size_t n) { return ::copy_file_range(src.fd, nullptr, fd, nullptr, n, 0); },
+                           limit, total, err)) {
+                return finish("copy_file_range");
+            }
+        }
+        if (S_ISFIFO(srcStat.st_mode)) {
+            if (kernelCopy([&](std::size_t n) { return ::splice(src.fd, nullptr, fd, nullptr, n, SPLICE_F_MOVE | SPLICE_F_MORE); },
+                           limit, total, err)) {
+                return finish("splice");
+            }
+        } else if (S_ISREG(srcStat.st_mode)) {
+            // Across file systems, or kernels without copy_file_range
+            if (kernelCopy([&](std::size_t n) { return ::sendfile(fd, src.fd, nullptr, n); },
+                           limit, total, err)) {
+                return finish("sendfile");
+            }
+        }
+#else
+        (void)src;
+        (void)limit;
+#endif
+        return {total, nullptr};
+    }
+
+    gocxx::base::Result<std::size_t> File::WriteTo(std::shared_ptr<gocxx::io::Writer> w) {
+        if (closed) {
+            return {0, ErrClosed};
+        }
+
+        std::size_t total = 0;
+        if (auto* dst = dynamic_cast<File*>(w.get()); dst && !dst->closed) {
+            bool done = false;
+            auto res = dst->copyFrom(*this, std::numeric_limits<std::size_t>::max(), done);
+            if (done) return res;
+            total = res.value;
+        }
+
+        auto rest = gocxx::io::Copy(w, std::make_shared<plainReader>(*this));
+        return {total + rest.value, rest.err};
+    }
+
+    gocxx::base::Result<std::size_t> File::ReadFrom(std::shared_ptr<gocxx::io::Reader> r) {
+        if (closed) {
+            return {0, ErrClosed};
+        }
+
+        auto* limited = dynamic_cast<gocxx::io::LimitedReader*>(r.get());
+        gocxx::io::Reader* src = limited ? limited->Underlying().get() : r.get();
+        std::size_t limit = limited ? limited->Remaining() : std::numeric_limits<std::size_t>::max();
+
+        std::size_t total = 0;
+        if (auto* file = dynamic_cast<File*>(src); file && !file->closed && limit > 0) {
+            bool done = false;
+            auto res = copyFrom(*file, limit, done);
+            if (limited) limited->Consumed(res.value);
+            if (done) return res;
+            total = res.value;
+        }
+
+        auto rest = gocxx::io::Copy(std::make_shared<plainWriter>(*this), r);
+        return {total + rest.value, rest.err};
+    }
+
     gocxx::base::Result<void> File::Chdir() {
         if (closed) {
             return {ErrClosed};
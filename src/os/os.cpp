@@ -4,6 +4,8 @@
 #include <algorithm>
 #include <sstream>
 #include <random>
+#include <cerrno>
+#include <fcntl.h>
 
 #ifdef _WIN32
 #include <windows.h>
@@ -519,6 +521,23 @@ namespace gocxx::os {
         return gocxx::base::Result<std::shared_ptr<Process>>(gocxx::errors::New("StartProcess not fully implemented"));
     }
 
+    // ========== PIPES ==========
+
+    gocxx::base::Result<std::pair<std::shared_ptr<File>, std::shared_ptr<File>>> Pipe() {
+        using PipePair = std::pair<std::shared_ptr<File>, std::shared_ptr<File>>;
+        int fds[2];
+#ifdef _WIN32
+        if (_pipe(fds, 64 * 1024, _O_BINARY) != 0) {
+#else
+        if (::pipe(fds) != 0) {
+#endif
+            return gocxx::base::Result<PipePair>(
+                std::make_shared<SyscallError>("pipe", gocxx::errors::New(std::strerror(errno))));
+        }
+        return gocxx::base::Result<PipePair>(PipePair(
+            std::make_shared<File>(fds[0], "|0"), std::make_shared<File>(fds[1], "|1")));
+    }
+
     // ========== UTILITY FUNCTIONS ==========
 
     bool IsDir(const std::string& path) {
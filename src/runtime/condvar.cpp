@@ -0,0 +1,98 @@
+#include "gocxx/runtime/condvar.h"
+#include "gocxx/time/timer_service.h"
+
+namespace gocxx::runtime {
+
+void CondVar::link(Waiter* w) {
+    w->prev = tail_;
+    w->next = nullptr;
+    if (tail_) tail_->next = w; else head_ = w;
+    tail_ = w;
+    w->linked = true;
+    taskWaiters_.fetch_add(1, std::memory_order_seq_cst);
+}
+
+bool CondVar::unlink(Waiter* w) {
+    if (!w->linked) return false;
+    if (w->prev) w->prev->next = w->next; else head_ = w->next;
+    if (w->next) w->next->prev = w->prev; else tail_ = w->prev;
+    w->linked = false;
+    taskWaiters_.fetch_sub(1, std::memory_order_relaxed);
+    return true;
+}
+
+void CondVar::waitTask(detail::Task* self, std::unique_lock<std::mutex>& lock) {
+    Waiter waiter{self};
+    {
+        std::lock_guard<std::mutex> guard(tasksMtx_);
+        link(&waiter);
+    }
+    // Park() drops the caller's mutex once the task is switched out
+    std::mutex* mtx = lock.release();
+    detail::Park(self, mtx);
+    {
+        std::lock_guard<std::mutex> guard(tasksMtx_);
+        unlink(&waiter);  // Normally done by the notifier already
+    }
+    lock = std::unique_lock<std::mutex>(*mtx);
+}
+
+bool CondVar::waitTaskUntil(detail::Task* self, std::unique_lock<std::mutex>& lock,
+                            Clock::time_point deadline) {
+    if (Clock::now() >= deadline) return false;
+
+    Waiter waiter{self};
+    bool timedOut = false;
+    {
+        std::lock_guard<std::mutex> guard(tasksMtx_);
+        link(&waiter);
+    }
+    auto& timers = time::TimerService::Global();
+    auto timer = timers.Create([this, &waiter, &timedOut] {
+        {
+            std::lock_guard<std::mutex> guard(tasksMtx_);
+            if (!unlink(&waiter)) return;  // Notified first
+            timedOut = true;
+        }
+        detail::Ready(waiter.task);
+    });
+    timers.Arm(timer, deadline);
+
+    std::mutex* mtx = lock.release();
+    detail::Park(self, mtx);
+    // The callback refers to this frame: make sure it is not running
+    timers.DisarmSync(timer);
+    {
+        std::lock_guard<std::mutex> guard(tasksMtx_);
+        unlink(&waiter);
+    }
+    lock = std::unique_lock<std::mutex>(*mtx);
+    return !timedOut;
+}
+
+bool CondVar::notifyTasks(bool all) {
+    Waiter* woken = nullptr;
+    {
+        std::lock_guard<std::mutex> guard(tasksMtx_);
+        if (!head_) return false;
+        if (all) {
+            woken = head_;
+            for (Waiter* w = head_; w; w = w->next) w->linked = false;
+            head_ = tail_ = nullptr;
+            taskWaiters_.store(0, std::memory_order_relaxed);
+        } else {
+            woken = head_;
+            unlink(woken);
+            woken->next = nullptr;
+        }
+    }
+    // A woken task may return and free its node at once: read next first
+    while (woken) {
+        Waiter* next = woken->next;
+        detail::Ready(woken->task);
+        woken = next;
+    }
+    return true;
+}
+
+} // namespace gocxx::runtime
@@ -0,0 +1,242 @@
+#include "gocxx/runtime/fiber.h"
+
+#if GOCXX_HAS_FIBERS
+
+#include <cstdint>
+#include <cstdio>
+#include <new>
+#include <sys/mman.h>
+#include <unistd.h>
+
+// Context switch. Saves the callee-saved registers of the platform ABI on
+// the current stack, stores the stack pointer to *from, loads `to` and
+// restores the registers saved there. A new context starts in the
+// trampoline, which calls entry(arg) from the saved register slots.
+
+#if defined(__x86_64__)
+
+// System V: rbx, rbp, r12-r15, plus the MXCSR and x87 control words.
+// Frame, from the saved stack pointer up:
+//   [mxcsr:4 fpucw:4] r15 r14 r13 r12 rbx rbp <return address>
+asm(R"(
+    .text
+    .globl gocxx_switch_context
+    .hidden gocxx_switch_context
+    .type gocxx_switch_context, @function
+    .p2align 4
+gocxx_switch_context:
+    pushq %rbp
+    pushq %rbx
+    pushq %r12
+    pushq %r13
+    pushq %r14
+    pushq %r15
+    subq $8, %rsp
+    stmxcsr (%rsp)
+    fnstcw 4(%rsp)
+    movq %rsp, (%rdi)
+    movq %rsi, %rsp
+    ldmxcsr (%rsp)
+    fldcw 4(%rsp)
+    addq $8, %rsp
+    popq %r15
+    popq %r14
+    popq %r13
+    popq %r12
+    popq %rbx
+    popq %rbp
+    ret
+    .size gocxx_switch_context, .-gocxx_switch_context
+
+    .globl gocxx_context_trampoline
+    .hidden gocxx_context_trampoline
+    .type gocxx_context_trampoline, @function
+    .p2align 4
+gocxx_context_trampoline:
+    movq %rbx, %rdi
+    callq *%r12
+    ud2
+    .size gocxx_context_trampoline, .-gocxx_context_trampoline
+)");
+
+#elif defined(__aarch64__)
+
+// AAPCS64: x19-x28, fp (x29), lr (x30) and the low halves of v8-v15.
+// Frame of 176 bytes: x19..x30 at 0..88, d8..d15 at 96..152.
+asm(R"(
+    .text
+    .globl gocxx_switch_context
+    .hidden gocxx_switch_context
+    .type gocxx_switch_context, %function
+    .p2align 4
+gocxx_switch_context:
+    sub sp, sp, #176
+    stp x19, x20, [sp, #0]
+    stp x21, x22, [sp, #16]
+    stp x23, x24, [sp, #32]
+    stp x25, x26, [sp, #48]
+    stp x27, x28, [sp, #64]
+    stp x29, x30, [sp, #80]
+    stp d8, d9, [sp, #96]
+    stp d10, d11, [sp, #112]
+    stp d12, d13, [sp, #128]
+    stp d14, d15, [sp, #144]
+    mov x2, sp
+    str x2, [x0]
+    mov sp, x1
+    ldp x19, x20, [sp, #0]
+    ldp x21, x22, [sp, #16]
+    ldp x23, x24, [sp, #32]
+    ldp x25, x26, [sp, #48]
+    ldp x27, x28, [sp, #64]
+    ldp x29, x30, [sp, #80]
+    ldp d8, d9, [sp, #96]
+    ldp d10, d11, [sp, #112]
+    ldp d12, d13, [sp, #128]
+    ldp d14, d15, [sp, #144]
+    add sp, sp, #176
+    ret
+    .size gocxx_switch_context, .-gocxx_switch_context
+
+    .globl gocxx_context_trampoline
+    .hidden gocxx_context_trampoline
+    .type gocxx_context_trampoline, %function
+    .p2align 4
+gocxx_context_trampoline:
+    mov x0, x19
+    blr x20
+    brk #0
+    .size gocxx_context_trampoline, .-gocxx_context_trampoline
+)");
+
+#endif
+
+extern "C" void gocxx_context_trampoline();
+
+namespace gocxx::runtime::detail {
+
+namespace {
+
+    std::size_t PageSize() {
+        static const std::size_t size = static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+        return size;
+    }
+
+    std::size_t RoundUp(std::size_t n, std::size_t to) {
+        return (n + to - 1) / to * to;
+    }
+
+    // Guarded stacks allowed at once: a quarter of vm.max_map_count, two
+    // mappings each, leaves half the limit to malloc and everything else
+    std::size_t GuardBudget() {
+        static const std::size_t budget = [] {
+            std::size_t maxMaps = 65530;
+            if (FILE* f = std::fopen("/proc/sys/vm/max_map_count", "r")) {
+                unsigned long n = 0;
+                if (std::fscanf(f, "%lu", &n) == 1 && n > 0) maxMaps = n;
+                std::fclose(f);
+            }
+            return maxMaps / 4;
+        }();
+        return budget;
+    }
+
+} // namespace
+
+StackPool::StackPool(std::size_t stackSize, std::size_t maxCached)
+    : stackSize_(RoundUp(stackSize, PageSize())), guardSize_(PageSize()), maxCached_(maxCached) {}
+
+StackPool::~StackPool() {
+    for (const Stack& stack : free_) {
+        unmap(stack);
+    }
+}
+
+Stack StackPool::Acquire() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!free_.empty()) {
+            Stack stack = free_.back();
+            free_.pop_back();
+            unpoison(stack);
+            return stack;
+        }
+    }
+
+    Stack stack;
+    stack.size = stackSize_ + guardSize_;
+    stack.base = mmap(nullptr, stack.size, PROT_READ | PROT_WRITE,
+                      MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE | MAP_STACK, -1, 0);
+    if (stack.base == MAP_FAILED) {
+        throw std::bad_alloc();
+    }
+    // A guard page splits the mapping in two, and the kernel caps mappings
+    // per process. Unguarded stacks mapped next to each other merge into one.
+    if (guarded_.fetch_add(1, std::memory_order_relaxed) < GuardBudget()) {
+        if (mprotect(stack.base, guardSize_, PROT_NONE) == 0) {
+            stack.guarded = true;
+            return stack;
+        }
+    }
+    guarded_.fetch_sub(1, std::memory_order_relaxed);
+    return stack;
+}
+
+void StackPool::Release(Stack stack) {
+    unpoison(stack);  // Shadow of the finished task's frames
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (free_.size() < maxCached_) {
+            free_.push_back(stack);
+            return;
+        }
+    }
+    unmap(stack);
+}
+
+void StackPool::unmap(const Stack& stack) {
+    munmap(stack.base, stack.size);
+    if (stack.guarded) guarded_.fetch_sub(1, std::memory_order_relaxed);
+}
+
+void StackPool::unpoison(const Stack& stack) const {
+#if GOCXX_ASAN
+    // A recycled stack keeps the redzones its last task left in the shadow
+    std::size_t guard = stack.guarded ? guardSize_ : 0;
+    __asan_unpoison_memory_region(static_cast<char*>(stack.base) + guard, stack.size - guard);
+#else
+    (void)stack;
+#endif
+}
+
+void* MakeContext(const Stack& stack, ContextEntry entry, void* arg) {
+    // 16-byte aligned top, as both ABIs require at a call
+    auto top = reinterpret_cast<std::uintptr_t>(stack.Top()) & ~std::uintptr_t(15);
+    auto* slots = reinterpret_cast<std::uintptr_t*>(top);
+
+#if defined(__x86_64__)
+    // After `ret` into the trampoline the stack pointer is top - 16, so the
+    // trampoline's call leaves the entry function with the usual alignment
+    std::uintptr_t* frame = slots - 10;
+    frame[0] = 0x037F'0000'1F80ull;     // fpucw:mxcsr defaults
+    frame[1] = 0;                        // r15
+    frame[2] = 0;                        // r14
+    frame[3] = 0;                        // r13
+    frame[4] = reinterpret_cast<std::uintptr_t>(entry);  // r12
+    frame[5] = reinterpret_cast<std::uintptr_t>(arg);    // rbx
+    frame[6] = 0;                        // rbp
+    frame[7] = reinterpret_cast<std::uintptr_t>(&gocxx_context_trampoline);
+    return frame;
+#elif defined(__aarch64__)
+    std::uintptr_t* frame = slots - 22;  // 176 bytes
+    for (int i = 0; i < 22; ++i) frame[i] = 0;
+    frame[0] = reinterpret_cast<std::uintptr_t>(arg);    // x19
+    frame[1] = reinterpret_cast<std::uintptr_t>(entry);  // x20
+    frame[11] = reinterpret_cast<std::uintptr_t>(&gocxx_context_trampoline);  // x30
+    return frame;
+#endif
+}
+
+} // namespace gocxx::runtime::detail
+
+#endif // GOCXX_HAS_FIBERS
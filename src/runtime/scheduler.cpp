@@ -0,0 +1,484 @@
+#include "gocxx/runtime/scheduler.h"
+#include "gocxx/runtime/deque.h"
+#include "gocxx/time/timer_service.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <utility>
+
+#if defined(__GNUC__)
+#define GOCXX_NOINLINE __attribute__((noinline))
+#elif defined(_MSC_VER)
+#define GOCXX_NOINLINE __declspec(noinline)
+#else
+#define GOCXX_NOINLINE
+#endif
+
+namespace gocxx::runtime {
+
+namespace detail {
+
+    enum class TaskState : uint8_t {
+        Runnable,     // In a run queue
+        Running,
+        Parking,      // Switching out of Park()
+        Parked,
+        WakePending,  // Readied while Running or Parking: Park() must not sleep
+        Yielding,     // Switching out of Gosched()
+        Done,
+    };
+
+    struct Task {
+        Task(std::function<void()> f, Scheduler* s) : fn(std::move(f)), sched(s) {}
+        std::function<void()> fn;
+        Scheduler* sched;
+        std::atomic<TaskState> state{TaskState::Runnable};
+        std::mutex* unlockOnPark = nullptr;  // Released by the thread once the task is off its stack
+#if GOCXX_HAS_FIBERS
+        Stack stack;
+        void* sp = nullptr;                  // Saved context while not running
+#endif
+    };
+
+    struct Processor {
+        explicit Processor(std::size_t i) : id(i) {}
+        std::size_t id;
+        WorkStealingDeque<Task*> runq;
+    };
+
+    /// One scheduler thread. Holds a processor while running tasks.
+    struct Machine {
+        explicit Machine(Scheduler* s) : sched(s) {}
+        Scheduler* sched;
+        Processor* proc = nullptr;
+        Processor* lastProc = nullptr;  // Preferred when taking a processor back
+        Task* current = nullptr;
+        void* sp = nullptr;             // The thread's own context while a task runs
+#if GOCXX_HAS_FIBERS
+        StackSpan stack;                // The thread's own stack, learnt from tasks (ASan builds)
+#endif
+        uint32_t rng = 0x9e3779b9u;
+    };
+
+    namespace {
+        thread_local Machine* currentMachine = nullptr;
+    }
+
+    // A task may resume on another thread after Park(). Reading the
+    // thread-local through an opaque call keeps the compiler from reusing
+    // an address it computed on the old thread.
+    GOCXX_NOINLINE Machine* CurrentMachine() {
+#if defined(__GNUC__)
+        asm volatile("" ::: "memory");
+#endif
+        return currentMachine;
+    }
+
+    Machine* EnterBlocking() {
+        Machine* m = CurrentMachine();
+        if (!m || !m->proc) return nullptr;  // Off the scheduler, nested, or already without a processor
+        m->sched->releaseBlocking(*m);
+        return m;
+    }
+
+    void ExitBlocking(Machine* m) {
+        // A task that parked inside the region may have moved to a thread
+        // that holds a processor already
+        if (m != CurrentMachine() || m->proc) return;
+        m->sched->reacquire(*m);
+    }
+
+    Task* CurrentTask() {
+        Machine* m = CurrentMachine();
+        return m ? m->current : nullptr;
+    }
+
+#if GOCXX_HAS_FIBERS
+
+    namespace {
+        // Switch from the running task @p self back to its thread's context.
+        // Returns once the task is resumed, possibly on another thread.
+        void SwitchToMachine(Task* self) {
+            Machine* m = CurrentMachine();
+            StackSpan back = SwitchContext(&self->sp, m->sp, m->stack);
+#if GOCXX_ASAN
+            CurrentMachine()->stack = back;
+#else
+            (void)back;
+#endif
+        }
+    }
+
+    void Park(Task* self, std::mutex* unlock) {
+        self->unlockOnPark = unlock;
+        TaskState expected = TaskState::Running;
+        if (!self->state.compare_exchange_strong(expected, TaskState::Parking,
+                                                 std::memory_order_seq_cst)) {
+            // Readied already: carry on
+            self->unlockOnPark = nullptr;
+            self->state.store(TaskState::Running, std::memory_order_relaxed);
+            if (unlock) unlock->unlock();
+            return;
+        }
+        SwitchToMachine(self);
+    }
+
+    void Ready(Task* task) {
+        TaskState s = task->state.load(std::memory_order_seq_cst);
+        while (true) {
+            switch (s) {
+                case TaskState::Parked:
+                    if (task->state.compare_exchange_weak(s, TaskState::Runnable,
+                                                          std::memory_order_seq_cst)) {
+                        task->sched->enqueue(task);
+                        return;
+                    }
+                    break;
+                case TaskState::Running:
+                case TaskState::Parking:
+                    if (task->state.compare_exchange_weak(s, TaskState::WakePending,
+                                                          std::memory_order_seq_cst)) {
+                        return;
+                    }
+                    break;
+                default:
+                    return;  // Awake already
+            }
+        }
+    }
+
+    bool SleepTask(std::chrono::nanoseconds d) {
+        Task* self = CurrentTask();
+        if (!self) return false;
+        if (d.count() <= 0) return true;
+        auto& timers = time::TimerService::Global();
+        auto timer = timers.Create([self] { Ready(self); });
+        timers.ArmAfter(timer, time::Duration(d.count()));
+        Park(self, nullptr);
+        return true;
+    }
+
+#else
+
+    void Park(Task*, std::mutex* unlock) {
+        if (unlock) unlock->unlock();
+    }
+
+    void Ready(Task*) {}
+
+    bool SleepTask(std::chrono::nanoseconds) {
+        return false;
+    }
+
+#endif // GOCXX_HAS_FIBERS
+
+} // namespace detail
+
+using detail::Machine;
+using detail::Processor;
+using detail::Task;
+using detail::TaskState;
+
+namespace {
+    // Go's default limit on OS threads
+    constexpr std::size_t kMaxThreads = 10000;
+    // Most tasks a thread moves from the global queue to its own at once
+    constexpr std::size_t kGlobalBatch = 32;
+
+#if GOCXX_HAS_FIBERS
+    // First code on a task's stack
+    void taskMain(void* arg) {
+        detail::StackSpan from = detail::EnterContext();
+#if GOCXX_ASAN
+        detail::CurrentMachine()->stack = from;
+#else
+        (void)from;
+#endif
+        auto* task = static_cast<Task*>(arg);
+        [&]() noexcept { task->fn(); }();
+        task->fn = nullptr;
+        task->state.store(TaskState::Done, std::memory_order_release);
+        Machine* m = detail::CurrentMachine();
+        detail::ExitContext(&task->sp, m->sp, m->stack);
+        std::abort();  // Never resumed
+    }
+#endif
+}
+
+void Gosched() {
+#if GOCXX_HAS_FIBERS
+    if (Task* self = detail::CurrentTask()) {
+        self->state.store(TaskState::Yielding, std::memory_order_relaxed);
+        detail::SwitchToMachine(self);
+        return;
+    }
+#endif
+    std::this_thread::yield();
+}
+
+Scheduler::Scheduler(std::size_t procs, std::size_t stackSize)
+#if GOCXX_HAS_FIBERS
+    : stacks_(stackSize ? stackSize : DefaultStackSize)
+#endif
+{
+#if !GOCXX_HAS_FIBERS
+    (void)stackSize;
+#endif
+    if (procs == 0) procs = DefaultProcs();
+    procs_.reserve(procs);
+    for (std::size_t i = 0; i < procs; ++i) {
+        procs_.push_back(std::make_unique<Processor>(i));
+    }
+    // Reverse so the first thread takes processor 0
+    for (std::size_t i = procs; i-- > 0;) {
+        idle_.push_back(procs_[i].get());
+    }
+    idleCount_.store(procs, std::memory_order_relaxed);
+}
+
+Scheduler::~Scheduler() {
+    std::vector<std::thread> threads;
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        draining_.store(true, std::memory_order_seq_cst);
+        allDone_.wait(lock, [this] { return live_.load(std::memory_order_seq_cst) == 0; });
+        stopping_ = true;
+        threads.swap(threads_);
+    }
+    wake_.notify_all();
+    for (auto& t : threads) t.join();
+}
+
+Scheduler& Scheduler::Global() {
+    // Never destroyed: tasks may still be running at exit
+    static Scheduler* scheduler = new Scheduler();
+    return *scheduler;
+}
+
+std::size_t Scheduler::DefaultProcs() {
+    if (const char* env = std::getenv("GOMAXPROCS")) {
+        long n = std::strtol(env, nullptr, 10);
+        if (n > 0) return static_cast<std::size_t>(n);
+    }
+    std::size_t cpus = std::thread::hardware_concurrency();
+    return cpus > 0 ? cpus : 1;
+}
+
+std::size_t Scheduler::NumThreads() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return threads_.size();
+}
+
+void Scheduler::Go(std::function<void()> fn) {
+    auto* task = new Task(std::move(fn), this);
+    live_.fetch_add(1, std::memory_order_relaxed);
+    enqueue(task);
+}
+
+void Scheduler::enqueue(Task* task) {
+    Machine* m = detail::CurrentMachine();
+    if (!m || m->sched != this || !m->proc) {
+        enqueueGlobal(task);
+        return;
+    }
+    m->proc->runq.Push(task);
+    queued_.fetch_add(1, std::memory_order_seq_cst);
+
+    // Pairs with the idle check in threadMain(): either we see the idle
+    // processor or the thread releasing it sees the queued task
+    if (idleCount_.load(std::memory_order_seq_cst) > 0) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        wakeLocked();
+    }
+}
+
+void Scheduler::enqueueGlobal(Task* task) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    global_.push_back(task);
+    queued_.fetch_add(1, std::memory_order_seq_cst);
+    wakeLocked();
+}
+
+void Scheduler::wakeLocked() {
+    if (stopping_ || idle_.size() <= waking_) return;
+    if (queued_.load(std::memory_order_seq_cst) == 0) return;
+    if (sleeping_ > notifies_) {
+        ++waking_;
+        ++notifies_;
+        wake_.notify_one();
+    } else if (threads_.size() < kMaxThreads) {
+        ++waking_;
+        threads_.emplace_back(&Scheduler::threadMain, this);
+    }
+}
+
+void Scheduler::threadMain() {
+    Machine m(this);
+    m.rng ^= static_cast<uint32_t>(std::hash<std::thread::id>()(std::this_thread::get_id()));
+    detail::currentMachine = &m;
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    bool promised = true;  // wakeLocked() counted this thread in waking_
+    while (true) {
+        if (promised) {
+            --waking_;
+            promised = false;
+        }
+        if (stopping_) break;
+
+        // Take a processor once there is work for it
+        if (idle_.empty() || queued_.load(std::memory_order_seq_cst) == 0) {
+            ++sleeping_;
+            wake_.wait(lock, [this] { return stopping_ || notifies_ > 0; });
+            --sleeping_;
+            if (stopping_) break;
+            --notifies_;
+            promised = true;
+            continue;
+        }
+
+        auto it = std::find(idle_.begin(), idle_.end(), m.lastProc);
+        if (it == idle_.end()) it = idle_.end() - 1;
+        m.proc = *it;
+        idle_.erase(it);
+        idleCount_.store(idle_.size(), std::memory_order_seq_cst);
+        // More work than this thread can take: bring in another
+        wakeLocked();
+        lock.unlock();
+
+        while (m.proc) {
+            Task* task = findWork(m);
+            if (!task) break;
+            run(m, task);  // May leave us without a processor (BlockingRegion)
+        }
+
+        lock.lock();
+        if (m.proc) {
+            m.lastProc = m.proc;
+            idle_.push_back(m.proc);
+            m.proc = nullptr;
+            idleCount_.store(idle_.size(), std::memory_order_seq_cst);
+        }
+        // Loop: re-check the queues before sleeping
+    }
+    detail::currentMachine = nullptr;
+}
+
+Task* Scheduler::findWork(Machine& m) {
+    if (auto task = m.proc->runq.Pop()) {
+        queued_.fetch_sub(1, std::memory_order_relaxed);
+        return *task;
+    }
+
+    if (queued_.load(std::memory_order_seq_cst) == 0) return nullptr;
+
+    // Global queue: take a fair share into the local queue
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!global_.empty()) {
+            Task* task = global_.front();
+            global_.pop_front();
+            std::size_t share = std::min(kGlobalBatch, global_.size() / procs_.size());
+            for (std::size_t i = 0; i < share; ++i) {
+                m.proc->runq.Push(global_.front());
+                global_.pop_front();
+            }
+            queued_.fetch_sub(1, std::memory_order_relaxed);
+            return task;
+        }
+    }
+
+    // Steal, starting at a random victim; idle processors may still hold work
+    const std::size_t n = procs_.size();
+    m.rng ^= m.rng << 13;
+    m.rng ^= m.rng >> 17;
+    m.rng ^= m.rng << 5;
+    std::size_t start = m.rng % n;
+    for (std::size_t i = 0; i < n; ++i) {
+        Processor* victim = procs_[(start + i) % n].get();
+        if (victim == m.proc) continue;
+        if (auto task = victim->runq.Steal()) {
+            queued_.fetch_sub(1, std::memory_order_relaxed);
+            return *task;
+        }
+    }
+    return nullptr;
+}
+
+void Scheduler::run(Machine& m, Task* task) {
+#if GOCXX_HAS_FIBERS
+    if (!task->sp) {
+        task->stack = stacks_.Acquire();
+        task->sp = detail::MakeContext(task->stack, &taskMain, task);
+    }
+    m.current = task;
+    task->state.store(TaskState::Running, std::memory_order_relaxed);
+    detail::SwitchContext(&m.sp, task->sp, task->stack.Span());
+    m.current = nullptr;
+
+    // Back on this thread's own stack: the task finished, parked or yielded
+    switch (task->state.load(std::memory_order_acquire)) {
+        case TaskState::Done:
+            stacks_.Release(task->stack);
+            finish(task);
+            return;
+        case TaskState::Yielding:
+            task->state.store(TaskState::Runnable, std::memory_order_relaxed);
+            enqueueGlobal(task);
+            return;
+        default: {
+            if (std::mutex* mtx = std::exchange(task->unlockOnPark, nullptr)) {
+                mtx->unlock();
+            }
+            TaskState expected = TaskState::Parking;
+            if (task->state.compare_exchange_strong(expected, TaskState::Parked,
+                                                    std::memory_order_seq_cst)) {
+                return;  // Ready() requeues it
+            }
+            // Readied while switching out
+            task->state.store(TaskState::Runnable, std::memory_order_relaxed);
+            enqueue(task);
+            return;
+        }
+    }
+#else
+    (void)m;
+    [&]() noexcept { task->fn(); }();
+    finish(task);
+#endif
+}
+
+void Scheduler::finish(Task* task) {
+    delete task;
+    if (live_.fetch_sub(1, std::memory_order_seq_cst) == 1 &&
+        draining_.load(std::memory_order_seq_cst)) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        allDone_.notify_all();
+    }
+}
+
+void Scheduler::releaseBlocking(Machine& m) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    m.lastProc = m.proc;
+    idle_.push_back(m.proc);
+    m.proc = nullptr;
+    idleCount_.store(idle_.size(), std::memory_order_seq_cst);
+    // Someone must run what is queued, including this processor's own queue
+    wakeLocked();
+}
+
+void Scheduler::reacquire(Machine& m) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (idle_.size() <= waking_) {
+        // All processors are busy or promised to woken threads: finish the
+        // task without one and give the thread up afterwards
+        return;
+    }
+    auto it = std::find(idle_.begin(), idle_.end(), m.lastProc);
+    if (it == idle_.end()) it = idle_.end() - 1;
+    m.proc = *it;
+    idle_.erase(it);
+    idleCount_.store(idle_.size(), std::memory_order_seq_cst);
+}
+
+} // namespace gocxx::runtime
@@ -0,0 +1,144 @@
+#include "gocxx/sync/epoch.h"
+
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+namespace gocxx::sync::detail {
+
+namespace {
+
+    struct Retired {
+        void* ptr;
+        void (*deleter)(void*);
+        uint64_t epoch;
+    };
+
+    /// One per thread that has used a guard; reused after the thread exits
+    struct Record {
+        std::atomic<uint64_t> epoch{0};  // Epoch observed by the active guard, 0 when outside
+        std::atomic<bool> inUse{false};
+        Record* next = nullptr;
+        uint32_t nesting = 0;
+        std::vector<Retired> retired;
+    };
+
+    /// Retired objects are collected once a thread holds this many
+    constexpr std::size_t collectThreshold = 64;
+
+    std::atomic<uint64_t> globalEpoch{1};
+    std::atomic<Record*> records{nullptr};
+
+    // Left behind by exited threads
+    std::mutex orphanMtx;
+    std::vector<Retired> orphans;
+    std::atomic<bool> haveOrphans{false};
+
+    Record* acquireRecord() {
+        for (Record* r = records.load(std::memory_order_acquire); r; r = r->next) {
+            bool expected = false;
+            if (!r->inUse.load(std::memory_order_relaxed) &&
+                r->inUse.compare_exchange_strong(expected, true, std::memory_order_acquire)) {
+                return r;
+            }
+        }
+        auto* r = new Record();  // Never freed: the list is walked without locks
+        r->inUse.store(true, std::memory_order_relaxed);
+        Record* head = records.load(std::memory_order_relaxed);
+        do {
+            r->next = head;
+        } while (!records.compare_exchange_weak(head, r, std::memory_order_release, std::memory_order_relaxed));
+        return r;
+    }
+
+    /// Advance the global epoch if every active guard has seen the current one
+    uint64_t tryAdvance() {
+        uint64_t epoch = globalEpoch.load(std::memory_order_seq_cst);
+        for (Record* r = records.load(std::memory_order_acquire); r; r = r->next) {
+            uint64_t seen = r->epoch.load(std::memory_order_seq_cst);
+            if (seen != 0 && seen != epoch) return epoch;
+        }
+        globalEpoch.compare_exchange_strong(epoch, epoch + 1, std::memory_order_seq_cst);
+        return globalEpoch.load(std::memory_order_seq_cst);
+    }
+
+    /// Free entries of @p list retired at least two epochs before @p epoch
+    void freeSafe(std::vector<Retired>& list, uint64_t epoch) {
+        std::size_t kept = 0;
+        for (Retired& item : list) {
+            if (item.epoch + 2 <= epoch) {
+                item.deleter(item.ptr);
+            } else {
+                list[kept++] = item;
+            }
+        }
+        list.resize(kept);
+    }
+
+    void collect(Record* r) {
+        uint64_t epoch = tryAdvance();
+        freeSafe(r->retired, epoch);
+        if (haveOrphans.load(std::memory_order_relaxed)) {
+            std::lock_guard<std::mutex> lock(orphanMtx);
+            freeSafe(orphans, epoch);
+            haveOrphans.store(!orphans.empty(), std::memory_order_relaxed);
+        }
+    }
+
+    struct ThreadRecord {
+        Record* record = nullptr;
+
+        Record* get() {
+            if (!record) record = acquireRecord();
+            return record;
+        }
+
+        ~ThreadRecord() {
+            if (!record) return;
+            if (!record->retired.empty()) {
+                std::lock_guard<std::mutex> lock(orphanMtx);
+                orphans.insert(orphans.end(), record->retired.begin(), record->retired.end());
+                haveOrphans.store(true, std::memory_order_relaxed);
+                record->retired.clear();
+            }
+            record->inUse.store(false, std::memory_order_release);
+        }
+    };
+
+    thread_local ThreadRecord threadRecord;
+
+} // namespace
+
+EpochGuard::EpochGuard() {
+    Record* r = threadRecord.get();
+    record_ = r;
+    if (r->nesting++ != 0) return;
+    // Announce, then make sure the epoch did not move meanwhile; otherwise a
+    // collector could have scanned before the announcement was visible
+    uint64_t epoch = globalEpoch.load(std::memory_order_seq_cst);
+    for (;;) {
+        r->epoch.store(epoch, std::memory_order_seq_cst);
+        uint64_t now = globalEpoch.load(std::memory_order_seq_cst);
+        if (now == epoch) break;
+        epoch = now;
+    }
+}
+
+EpochGuard::~EpochGuard() {
+    auto* r = static_cast<Record*>(record_);
+    if (--r->nesting == 0) r->epoch.store(0, std::memory_order_release);
+}
+
+void EpochRetire(void* ptr, void (*deleter)(void*)) {
+    Record* r = threadRecord.get();
+    r->retired.push_back({ptr, deleter, globalEpoch.load(std::memory_order_seq_cst)});
+    if (r->retired.size() >= collectThreshold) collect(r);
+}
+
+void EpochCollect() {
+    Record* r = threadRecord.get();
+    // Two advances make everything retired so far safe when no guard is active
+    for (int i = 0; i < 3; ++i) collect(r);
+}
+
+} // namespace gocxx::sync::detail
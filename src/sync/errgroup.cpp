@@ -0,0 +1,77 @@
+#include "gocxx/sync/errgroup.h"
+
+#include <gocxx/runtime/scheduler.h>
+
+#include <exception>
+#include <stdexcept>
+
+namespace gocxx::sync::errgroup {
+
+Group::Group(gocxx::context::ContextPtr parent) {
+    auto derived = gocxx::context::WithCancel(std::move(parent));
+    if (derived.Failed()) throw std::runtime_error("errgroup: " + derived.err->error());
+    ctx_ = std::move(derived.value.first);
+    cancel_ = std::move(derived.value.second);
+}
+
+Group::~Group() {
+    wg_.Wait();
+}
+
+void Group::SetLimit(int n) {
+    if (running_.load(std::memory_order_acquire) != 0) {
+        throw std::runtime_error("errgroup: modify limit while functions are running");
+    }
+    sem_ = n < 0 ? nullptr : std::make_unique<Semaphore>(n);
+}
+
+void Group::Go(std::function<gocxx::base::Result<void>()> fn) {
+    if (sem_) sem_->Acquire();
+    start(std::move(fn));
+}
+
+bool Group::TryGo(std::function<gocxx::base::Result<void>()> fn) {
+    if (sem_ && !sem_->TryAcquire()) return false;
+    start(std::move(fn));
+    return true;
+}
+
+gocxx::base::Result<void> Group::Wait() {
+    wg_.Wait();
+    if (cancel_) cancel_();
+    std::lock_guard<std::mutex> lock(mtx_);
+    return gocxx::base::Result<void>(gocxx::errors::Join(errs_));
+}
+
+void Group::start(std::function<gocxx::base::Result<void>()> fn) {
+    running_.fetch_add(1, std::memory_order_relaxed);
+    wg_.Add(1);
+    gocxx::Go([this, fn = std::move(fn)] {
+        std::shared_ptr<gocxx::errors::Error> err;
+        try {
+            err = fn().err;
+        } catch (const gocxx::errors::Error& e) {
+            err = gocxx::errors::New(e.error());
+        } catch (const std::exception& e) {
+            err = gocxx::errors::New(e.what() ? e.what() : "errgroup: function threw");
+        } catch (...) {
+            err = gocxx::errors::New("errgroup: function threw");
+        }
+        if (err) fail(std::move(err));
+        if (sem_) sem_->Release();
+        running_.fetch_sub(1, std::memory_order_release);
+        wg_.Done();
+    });
+}
+
+void Group::fail(std::shared_ptr<gocxx::errors::Error> err) {
+    bool first;
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        first = errs_.empty();
+        errs_.push_back(std::move(err));
+    }
+    if (first && cancel_) cancel_();
+}
+
+} // namespace gocxx::sync::errgroup
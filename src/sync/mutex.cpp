@@ -0,0 +1,366 @@
+#include "gocxx/sync/mutex.h"
+#include "gocxx/sync/waitpolicy.h"
+#include <gocxx/runtime/blocking.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <functional>
+#include <stdexcept>
+#include <thread>
+
+#if defined(__linux__)
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#else
+#include <condition_variable>
+#endif
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define GOCXX_RETURN_ADDRESS() _ReturnAddress()
+#else
+#define GOCXX_RETURN_ADDRESS() __builtin_return_address(0)
+#endif
+
+#if defined(__has_include)
+#if __has_include(<dlfcn.h>) && __has_include(<cxxabi.h>)
+#include <cxxabi.h>
+#include <dlfcn.h>
+#include <cstdlib>
+#define GOCXX_HAS_DLADDR 1
+#endif
+#endif
+
+namespace gocxx::sync {
+
+namespace {
+
+    using Clock = std::chrono::steady_clock;
+
+    /// A waiter that waited longer than this puts the mutex into starvation mode
+    constexpr int64_t starvationThresholdNs = 1'000'000;
+
+    /// Spin rounds before sleeping, each a burst of CPU pauses, as in Go
+    constexpr int activeSpin = 4;
+    constexpr int activeSpinPauses = 30;
+
+    bool canSpin(int iter) {
+        static const bool multiCore = std::thread::hardware_concurrency() > 1;
+        return multiCore && iter < activeSpin;
+    }
+
+    int64_t nowNs() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now().time_since_epoch()).count();
+    }
+
+    /// A task parked in Mutex::semAcquire() until a token arrives on its word
+    struct TaskWaiter {
+        const void* addr;
+        runtime::detail::Task* task;
+        TaskWaiter* next = nullptr;
+    };
+
+    /// Parked tasks share a few FIFO lists, picked by futex word address
+    struct TaskRoot {
+        std::mutex mtx;
+        TaskWaiter* head = nullptr;
+        TaskWaiter* tail = nullptr;
+        std::atomic<uint32_t> waiters{0};   // Tasks queued or about to queue
+        std::atomic<uint32_t> sleepers{0};  // Threads in or about to enter FUTEX_WAIT on a word here
+    };
+
+    TaskRoot& taskRootFor(const void* addr) {
+        static TaskRoot roots[64];
+        return roots[(reinterpret_cast<std::uintptr_t>(addr) >> 4) % 64];
+    }
+
+    bool takeToken(std::atomic<uint32_t>& sema) {
+        uint32_t tokens = sema.load(std::memory_order_relaxed);
+        while (tokens > 0) {
+            if (sema.compare_exchange_weak(tokens, tokens - 1, std::memory_order_acquire,
+                                           std::memory_order_relaxed)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /// Park the calling task until it takes a token from @p sema
+    void taskAcquire(runtime::detail::Task* self, std::atomic<uint32_t>& sema) {
+        TaskRoot& root = taskRootFor(&sema);
+        while (!takeToken(sema)) {
+            std::unique_lock<std::mutex> lock(root.mtx);
+            root.waiters.fetch_add(1, std::memory_order_seq_cst);
+            if (sema.load(std::memory_order_seq_cst) > 0) {  // A release that missed our count
+                root.waiters.fetch_sub(1, std::memory_order_relaxed);
+                continue;
+            }
+            TaskWaiter w{&sema, self};
+            if (root.tail) root.tail->next = &w; else root.head = &w;
+            root.tail = &w;
+            lock.release();
+            runtime::detail::Park(self, &root.mtx);  // The waker unlinks w and drops the count
+        }
+    }
+
+    /// Wake the longest-parked task waiting on @p sema, if any
+    void taskRelease(std::atomic<uint32_t>& sema) {
+        TaskRoot& root = taskRootFor(&sema);
+        if (root.waiters.load(std::memory_order_seq_cst) == 0) return;
+        std::lock_guard<std::mutex> lock(root.mtx);
+        TaskWaiter* prev = nullptr;
+        for (TaskWaiter* w = root.head; w; prev = w, w = w->next) {
+            if (w->addr != &sema) continue;
+            (prev ? prev->next : root.head) = w->next;
+            if (root.tail == w) root.tail = prev;
+            root.waiters.fetch_sub(1, std::memory_order_relaxed);
+            runtime::detail::Ready(w->task);  // w lives on the task's stack: not touched after this
+            return;
+        }
+    }
+
+#if !defined(__linux__)
+    /// Sleeping waiters share a few condition variables, picked by futex word address
+    struct Bucket {
+        std::mutex mtx;
+        std::condition_variable cv;
+    };
+
+    Bucket& bucketFor(const void* addr) {
+        static Bucket buckets[64];
+        return buckets[(reinterpret_cast<std::uintptr_t>(addr) >> 4) % 64];
+    }
+#endif
+
+    // --- Contention profile ---------------------------------------------
+
+    /// Open-addressed table of call sites; lock-free so recording never takes a lock
+    constexpr std::size_t profileSlots = 1024;
+
+    struct ProfileSlot {
+        std::atomic<const void*> site{nullptr};
+        std::atomic<uint64_t> count{0};
+        std::atomic<uint64_t> waitNanos{0};
+    };
+
+    ProfileSlot profile[profileSlots];
+    ProfileSlot profileOverflow;  // Sites that found the table full
+    std::atomic<int> profileRate{0};
+
+    bool sampled(int rate) {
+        if (rate == 1) return true;
+        thread_local uint32_t seed = static_cast<uint32_t>(
+            std::hash<std::thread::id>()(std::this_thread::get_id())) | 1u;
+        seed ^= seed << 13;
+        seed ^= seed >> 17;
+        seed ^= seed << 5;
+        return seed % static_cast<uint32_t>(rate) == 0;
+    }
+
+    void record(const void* site, int64_t waitNs) {
+        std::size_t h = (reinterpret_cast<std::uintptr_t>(site) >> 2) * 0x9E3779B97F4A7C15ull;
+        for (std::size_t probe = 0; probe < 16; ++probe) {
+            ProfileSlot& slot = profile[(h + probe) % profileSlots];
+            const void* current = slot.site.load(std::memory_order_acquire);
+            if (current == nullptr &&
+                slot.site.compare_exchange_strong(current, site, std::memory_order_acq_rel)) {
+                current = site;
+            }
+            if (current == site) {
+                slot.count.fetch_add(1, std::memory_order_relaxed);
+                slot.waitNanos.fetch_add(static_cast<uint64_t>(waitNs), std::memory_order_relaxed);
+                return;
+            }
+        }
+        profileOverflow.count.fetch_add(1, std::memory_order_relaxed);
+        profileOverflow.waitNanos.fetch_add(static_cast<uint64_t>(waitNs), std::memory_order_relaxed);
+    }
+
+} // namespace
+
+void Mutex::lockSlow() {
+    const void* site = GOCXX_RETURN_ADDRESS();  // In the caller of lock(), which is forced inline
+    int64_t waitStart = 0;
+    bool isStarving = false;
+    bool awoke = false;
+    int iter = 0;
+    uint32_t old = state_.load(std::memory_order_relaxed);
+    for (;;) {
+        // Spin only while the holder runs; in starvation mode the lock goes to a sleeper anyway
+        if ((old & (locked | starving)) == locked && canSpin(iter)) {
+            // Tell Unlock() not to wake anyone while we are spinning for it
+            if (!awoke && (old & woken) == 0 && (old >> waiterShift) != 0 &&
+                state_.compare_exchange_weak(old, old | woken, std::memory_order_relaxed)) {
+                awoke = true;
+            }
+            for (int i = 0; i < activeSpinPauses; ++i) CpuRelax();
+            ++iter;
+            old = state_.load(std::memory_order_relaxed);
+            continue;
+        }
+        uint32_t next = old;
+        if ((old & starving) == 0) next |= locked;  // Starving mutexes are handed off, not grabbed
+        if (old & (locked | starving)) next += 1u << waiterShift;
+        if (isStarving && (old & locked)) next |= starving;
+        if (awoke) next &= ~woken;
+        if (!state_.compare_exchange_weak(old, next, std::memory_order_acquire, std::memory_order_relaxed)) {
+            continue;
+        }
+        if ((old & (locked | starving)) == 0) break;  // Locked it
+
+        if (waitStart == 0) waitStart = nowNs();
+        semAcquire();
+        int64_t waited = nowNs() - waitStart;
+        isStarving = isStarving || waited > starvationThresholdNs;
+        old = state_.load(std::memory_order_relaxed);
+        if (old & starving) {
+            // Handed off: we own the lock. Leave starvation mode if we are
+            // the last waiter or did not wait long ourselves.
+            uint32_t delta = locked - (1u << waiterShift);
+            if (!isStarving || (old >> waiterShift) == 1) delta -= starving;
+            state_.fetch_add(delta, std::memory_order_acquire);
+            break;
+        }
+        awoke = true;
+        iter = 0;
+    }
+
+    if (waitStart != 0) {
+        int rate = profileRate.load(std::memory_order_relaxed);
+        if (rate > 0 && sampled(rate)) record(site, nowNs() - waitStart);
+    }
+}
+
+void Mutex::unlockSlow(uint32_t state) {
+    if (((state + locked) & locked) == 0) {
+        state_.fetch_add(locked, std::memory_order_relaxed);
+        throw std::runtime_error("sync: unlock of unlocked mutex");
+    }
+    if (state & starving) {
+        semRelease();  // Hand off to a sleeper; newcomers cannot take it meanwhile
+        return;
+    }
+    uint32_t old = state;
+    for (;;) {
+        // Nobody to wake, or someone already locked, woke or is being handed the lock
+        if ((old >> waiterShift) == 0 || (old & (locked | woken | starving)) != 0) return;
+        uint32_t next = (old - (1u << waiterShift)) | woken;
+        if (state_.compare_exchange_weak(old, next, std::memory_order_release, std::memory_order_relaxed)) {
+            semRelease();
+            return;
+        }
+    }
+}
+
+#if defined(__linux__)
+
+void Mutex::semAcquire() {
+    if (runtime::detail::Task* self = runtime::detail::CurrentTask()) {
+        taskAcquire(self, sema_);
+        return;
+    }
+    runtime::BlockingRegion blocking;
+    std::atomic<uint32_t>& sleepers = taskRootFor(&sema_).sleepers;
+    // Counted before checking for a token, as semRelease() adds one before
+    // reading the count, so one of the two always sees the other
+    sleepers.fetch_add(1, std::memory_order_seq_cst);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    while (!takeToken(sema_)) {
+        syscall(SYS_futex, reinterpret_cast<uint32_t*>(&sema_), FUTEX_WAIT_PRIVATE, 0u, nullptr, nullptr, 0);
+    }
+    sleepers.fetch_sub(1, std::memory_order_relaxed);
+}
+
+void Mutex::semRelease() {
+    sema_.fetch_add(1, std::memory_order_seq_cst);
+    taskRelease(sema_);
+    // Skip the syscall when only parked tasks wait (or nobody, on this root)
+    if (taskRootFor(&sema_).sleepers.load(std::memory_order_seq_cst) == 0) return;
+    syscall(SYS_futex, reinterpret_cast<uint32_t*>(&sema_), FUTEX_WAKE_PRIVATE, 1, nullptr, nullptr, 0);
+}
+
+#else
+
+void Mutex::semAcquire() {
+    if (runtime::detail::Task* self = runtime::detail::CurrentTask()) {
+        taskAcquire(self, sema_);
+        return;
+    }
+    runtime::BlockingRegion blocking;
+    Bucket& b = bucketFor(&sema_);
+    std::unique_lock<std::mutex> lock(b.mtx);
+    b.cv.wait(lock, [this] { return takeToken(sema_); });  // Parked tasks take tokens without b.mtx
+}
+
+void Mutex::semRelease() {
+    {
+        Bucket& b = bucketFor(&sema_);
+        std::lock_guard<std::mutex> lock(b.mtx);
+        sema_.fetch_add(1, std::memory_order_seq_cst);
+        b.cv.notify_all();  // Shared by other mutexes: wake all, each re-checks its own word
+    }
+    taskRelease(sema_);
+}
+
+#endif
+
+std::string MutexContention::Symbol() const {
+    char buf[64];
+#if defined(GOCXX_HAS_DLADDR)
+    Dl_info info;
+    if (site && dladdr(site, &info)) {
+        if (info.dli_sname) {
+            int status = 0;
+            char* demangled = abi::__cxa_demangle(info.dli_sname, nullptr, nullptr, &status);
+            std::string name = status == 0 && demangled ? demangled : info.dli_sname;
+            std::free(demangled);
+            std::snprintf(buf, sizeof(buf), "+0x%zx",
+                          static_cast<std::size_t>(static_cast<const char*>(site) -
+                                                   static_cast<const char*>(info.dli_saddr)));
+            return name + buf;
+        }
+        if (info.dli_fname) {
+            std::snprintf(buf, sizeof(buf), "+0x%zx",
+                          static_cast<std::size_t>(static_cast<const char*>(site) -
+                                                   static_cast<const char*>(info.dli_fbase)));
+            return std::string(info.dli_fname) + buf;
+        }
+    }
+#endif
+    std::snprintf(buf, sizeof(buf), "%p", site);
+    return buf;
+}
+
+int SetMutexProfileFraction(int rate) {
+    return profileRate.exchange(std::max(rate, 0), std::memory_order_relaxed);
+}
+
+std::vector<MutexContention> MutexProfile() {
+    std::vector<MutexContention> out;
+    for (const ProfileSlot& slot : profile) {
+        const void* site = slot.site.load(std::memory_order_acquire);
+        uint64_t count = slot.count.load(std::memory_order_relaxed);
+        if (!site || count == 0) continue;
+        out.push_back({site, count, slot.waitNanos.load(std::memory_order_relaxed)});
+    }
+    if (uint64_t count = profileOverflow.count.load(std::memory_order_relaxed)) {
+        out.push_back({nullptr, count, profileOverflow.waitNanos.load(std::memory_order_relaxed)});
+    }
+    std::sort(out.begin(), out.end(), [](const MutexContention& a, const MutexContention& b) {
+        return a.waitNanos > b.waitNanos;
+    });
+    return out;
+}
+
+void ResetMutexProfile() {
+    for (ProfileSlot& slot : profile) {
+        slot.count.store(0, std::memory_order_relaxed);
+        slot.waitNanos.store(0, std::memory_order_relaxed);
+    }
+    profileOverflow.count.store(0, std::memory_order_relaxed);
+    profileOverflow.waitNanos.store(0, std::memory_order_relaxed);
+}
+
+} // namespace gocxx::sync
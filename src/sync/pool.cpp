@@ -0,0 +1,80 @@
+#include "gocxx/sync/pool.h"
+#include "gocxx/time/timer_service.h"
+#include <gocxx/runtime/scheduler.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+namespace gocxx::sync {
+
+namespace {
+
+    /// How often the timer thread calls SweepPoolsInBackground()
+    constexpr int64_t sweepIntervalMs = 2000;
+
+    struct Registry {
+        std::mutex mtx;
+        std::vector<detail::SweptPool*> pools;
+        gocxx::time::TimerService::Handle timer;
+    };
+
+    Registry& registry() {
+        // Never destroyed: pools may be static objects themselves
+        static Registry* r = new Registry();
+        return *r;
+    }
+
+    /// Sweep every pool; the dropped victims are returned, not freed, so no
+    /// destructor runs under the registry lock (it may own a Pool itself)
+    std::vector<std::shared_ptr<void>> rotatePools() {
+        Registry& r = registry();
+        std::vector<std::shared_ptr<void>> garbage;
+        std::lock_guard<std::mutex> lock(r.mtx);
+        for (detail::SweptPool* pool : r.pools) {
+            if (auto old = pool->sweep()) garbage.push_back(std::move(old));
+        }
+        return garbage;
+    }
+
+} // namespace
+
+void SweepPools() {
+    rotatePools();  // The old victims are freed here, outside the registry lock
+}
+
+namespace detail {
+
+    void RegisterPool(SweptPool* pool) {
+        Registry& r = registry();
+        std::lock_guard<std::mutex> lock(r.mtx);
+        r.pools.push_back(pool);
+        if (!r.timer) {
+            auto& timers = gocxx::time::TimerService::Global();
+            auto interval = gocxx::time::Milliseconds(sweepIntervalMs);
+            r.timer = timers.Create(&SweepPoolsInBackground);
+            timers.ArmAfter(r.timer, interval, interval);
+        }
+    }
+
+    void UnregisterPool(SweptPool* pool) {
+        Registry& r = registry();
+        std::lock_guard<std::mutex> lock(r.mtx);
+        auto it = std::find(r.pools.begin(), r.pools.end(), pool);
+        if (it != r.pools.end()) {
+            *it = r.pools.back();
+            r.pools.pop_back();
+        }
+    }
+
+    void SweepPoolsInBackground() {
+        auto garbage = rotatePools();
+        if (garbage.empty()) return;
+        // Destructors can be slow; keep them off the timer service thread
+        gocxx::Go([garbage = std::move(garbage)]() mutable { garbage.clear(); });
+    }
+
+} // namespace detail
+
+} // namespace gocxx::sync
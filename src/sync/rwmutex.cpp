@@ -0,0 +1,86 @@
+#include "gocxx/sync/rwmutex.h"
+
+namespace gocxx::sync {
+
+bool RWMutex::drained() const {
+    // Readers that back off only ever add transiently, so a sum read while
+    // the writer flag is up may overcount but never undercounts
+    int64_t sum = 0;
+    for (std::size_t i = 0; i <= mask_; ++i) sum += slots_[i].readers.load(std::memory_order_seq_cst);
+    return sum == 0;
+}
+
+void RWMutex::rlockSlow(Slot& slot) {
+    for (;;) {
+        // Step aside so the writer can drain, and wait until it is gone
+        slot.readers.fetch_sub(1, std::memory_order_seq_cst);
+        if (writerParked_.load(std::memory_order_seq_cst)) wakeParked();
+
+        WaitPhase phase = SpinWait(policy_, [this] { return !writer_.load(std::memory_order_acquire); });
+        if (phase == WaitPhase::Park) {
+            std::unique_lock<std::mutex> lock(parkMtx_);
+            readersParked_.fetch_add(1, std::memory_order_seq_cst);
+            while (writer_.load(std::memory_order_seq_cst)) cv_.wait(lock);
+            readersParked_.fetch_sub(1, std::memory_order_relaxed);
+        }
+        stats_.Record(phase);
+
+        slot.readers.fetch_add(1, std::memory_order_seq_cst);
+        if (!writer_.load(std::memory_order_seq_cst)) return;
+    }
+}
+
+void RWMutex::wakeParked() {
+    std::lock_guard<std::mutex> lock(parkMtx_);
+    cv_.notify_all();
+}
+
+void RWMutex::lockWriterSlow() {
+    for (;;) {
+        WaitPhase phase = SpinWait(policy_, [this] { return !writer_.load(std::memory_order_acquire); });
+        if (phase == WaitPhase::Park) {
+            std::unique_lock<std::mutex> lock(parkMtx_);
+            writersParked_.fetch_add(1, std::memory_order_seq_cst);
+            while (writer_.load(std::memory_order_seq_cst)) cv_.wait(lock);
+            writersParked_.fetch_sub(1, std::memory_order_relaxed);
+        }
+        stats_.Record(phase);
+
+        bool expected = false;
+        if (writer_.compare_exchange_strong(expected, true, std::memory_order_seq_cst)) return;
+    }
+}
+
+void RWMutex::Lock() {
+    // Owning the flag excludes other writers and turns new readers away
+    bool expected = false;
+    if (!writer_.compare_exchange_strong(expected, true, std::memory_order_seq_cst)) lockWriterSlow();
+    if (drained()) return;
+
+    WaitPhase phase = SpinWait(policy_, [this] { return drained(); });
+    if (phase == WaitPhase::Park) {
+        std::unique_lock<std::mutex> lock(parkMtx_);
+        writerParked_.store(true, std::memory_order_seq_cst);
+        while (!drained()) cv_.wait(lock);
+        writerParked_.store(false, std::memory_order_relaxed);
+    }
+    stats_.Record(phase);
+}
+
+void RWMutex::Unlock() {
+    writer_.store(false, std::memory_order_seq_cst);
+    if (readersParked_.load(std::memory_order_seq_cst) != 0 ||
+        writersParked_.load(std::memory_order_seq_cst) != 0) {
+        wakeParked();
+    }
+}
+
+bool RWMutex::TryLock() {
+    bool expected = false;
+    if (!writer_.compare_exchange_strong(expected, true, std::memory_order_seq_cst)) return false;
+    if (drained()) return true;
+    Unlock();  // Readers that backed off meanwhile are woken
+    return false;
+}
+
+} // namespace gocxx::sync
@@ -0,0 +1,113 @@
+#include "gocxx/sync/semaphore.h"
+
+#include <gocxx/context/context.h>
+#include <gocxx/runtime/condvar.h>
+
+namespace gocxx::sync {
+
+struct Semaphore::Waiter {
+    explicit Waiter(int64_t n) : n(n) {}
+
+    const int64_t n;
+    gocxx::runtime::CondVar cv;
+    Waiter* prev = nullptr;
+    Waiter* next = nullptr;
+    bool linked = false;
+    bool granted = false;   // Tokens taken on its behalf
+    bool canceled = false;  // Context canceled
+};
+
+namespace {
+
+    /// Wakes a waiter when its context is canceled; runs under the context's channel lock
+    struct CancelWaker final : gocxx::base::ChanWaiter {
+        CancelWaker(std::mutex& mtx, bool& canceled, gocxx::runtime::CondVar& cv)
+            : mtx(mtx), canceled(canceled), cv(cv) {}
+
+        void notify() noexcept override {
+            std::lock_guard<std::mutex> lock(mtx);
+            canceled = true;
+            cv.notify_one();
+        }
+
+        std::mutex& mtx;
+        bool& canceled;
+        gocxx::runtime::CondVar& cv;
+    };
+
+} // namespace
+
+gocxx::base::Result<void> Semaphore::Acquire(const gocxx::context::ContextPtr& ctx, int64_t n) {
+    if (!ctx) {
+        Acquire(n);
+        return {};
+    }
+    if (ctx->IsCanceled()) return ctx->Err();
+    if (tryTake(n)) return {};
+    if (n <= size_ && spin(n)) return {};
+    return acquireSlow(ctx.get(), n);
+}
+
+gocxx::base::Result<void> Semaphore::acquireSlow(const gocxx::context::Context* ctx, int64_t n) {
+    Waiter w(n);
+    CancelWaker waker(mtx_, w.canceled, w.cv);
+    // Registered outside mtx_: the context calls notify() under its own lock
+    bool registered = ctx && ctx->AddDoneWaiter(&waker);
+
+    std::unique_lock<std::mutex> lock(mtx_);
+    if (registered && ctx->IsCanceled()) w.canceled = true;
+    if (!w.canceled && n <= size_) {
+        // Queue before looking at the tokens; a Release() that adds tokens
+        // after this sees the queue and calls grantLocked() itself
+        w.prev = tail_;
+        (tail_ ? tail_->next : head_) = &w;
+        tail_ = &w;
+        w.linked = true;
+        queued_.fetch_add(1, std::memory_order_seq_cst);
+        if (head_ == &w) grantLocked();
+    }
+    while (!w.granted && !w.canceled) w.cv.wait(lock);
+
+    if (!w.granted && w.linked) {
+        // Leaving the head may let the callers behind us through
+        bool front = head_ == &w;
+        unlinkLocked(&w);
+        if (front) grantLocked();
+    }
+    lock.unlock();
+    if (registered) ctx->RemoveDoneWaiter(&waker);
+
+    if (w.granted) return {};
+    return ctx->Err();
+}
+
+void Semaphore::releaseSlow() {
+    std::lock_guard<std::mutex> lock(mtx_);
+    grantLocked();
+}
+
+void Semaphore::grantLocked() {
+    while (head_) {
+        Waiter* w = head_;
+        int64_t avail = avail_.load(std::memory_order_relaxed);
+        bool taken = false;
+        while (avail >= w->n && !taken) {
+            taken = avail_.compare_exchange_weak(avail, avail - w->n, std::memory_order_acquire,
+                                                 std::memory_order_relaxed);
+        }
+        if (!taken) return;  // Strict FIFO: nobody passes the head
+        unlinkLocked(w);
+        w->granted = true;
+        w->cv.notify_one();
+    }
+}
+
+void Semaphore::unlinkLocked(Waiter* w) {
+    (w->prev ? w->prev->next : head_) = w->next;
+    (w->next ? w->next->prev : tail_) = w->prev;
+    w->prev = w->next = nullptr;
+    w->linked = false;
+    queued_.fetch_sub(1, std::memory_order_seq_cst);
+}
+
+} // namespace gocxx::sync
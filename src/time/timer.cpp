@@ -1,71 +1,60 @@
 #include "gocxx/time/timer.h"
-#include <chrono>
-#include <thread>
 
 namespace gocxx::time {
 
 Timer::Timer(Duration d)
-    : duration_(d), stopped_(false) {
-    ch_ = gocxx::base::Chan<Time>::Make(1);
-    start_ = std::chrono::steady_clock::now();
-    thread_ = std::thread(&Timer::run, this);
+    : ch_(gocxx::base::Chan<Time>::Make(1)) {
+    std::weak_ptr<gocxx::base::Chan<Time>> weak = ch_;
+    entry_ = TimerService::Global().Create([weak]() {
+        if (auto ch = weak.lock()) {
+            ch->trySend(Time::Now());  // Never block the timer thread
+        }
+    });
+    TimerService::Global().ArmAfter(entry_, d);
+}
+
+Timer::Timer(Duration d, std::function<void()> f)
+    : entry_(TimerService::Global().Create(std::move(f))) {
+    TimerService::Global().ArmAfter(entry_, d);
 }
 
 Timer::~Timer() {
-    Stop();
-    if (thread_.joinable()) thread_.join();
+    if (ch_) Stop();
 }
 
 bool Timer::Stop() {
-    bool was_stopped = stopped_.exchange(true);
-    if (!was_stopped) {
-        cv_.notify_all(); // Wake up the waiting thread
-    }
-    return !was_stopped; // returns true if it was running
+    bool wasActive = disarm();
+    drain();
+    return wasActive;
 }
 
 bool Timer::Reset(Duration d) {
-    // Stop and wait for the old thread to finish
-    Stop();
-    if (thread_.joinable()) thread_.join();
-    
-    // Reset state for new timer
-    stopped_ = false;
-    duration_ = d;
-    ch_ = gocxx::base::Chan<Time>::Make(1);
-    start_ = std::chrono::steady_clock::now();
-    
-    // Start new thread
-    thread_ = std::thread(&Timer::run, this);
-    return true;
+    bool wasActive = disarm();
+    drain();
+    TimerService::Global().ArmAfter(entry_, d);
+    return wasActive;
 }
 
 std::shared_ptr<gocxx::base::Chan<Time>> Timer::C() {
     return ch_;
 }
 
-void Timer::run() {
-    std::unique_lock<std::mutex> lock(mutex_);
-    auto deadline = start_ + std::chrono::nanoseconds(duration_.Nanoseconds());
-    
-    // Wait until the deadline or until stopped
-    if (cv_.wait_until(lock, deadline, [this] { return stopped_.load(); })) {
-        // We were stopped before the timer expired
-        return;
-    }
+bool Timer::disarm() {
+    // A send already taken by the timer thread must land before drain(), not after
+    if (ch_) return TimerService::Global().DisarmSync(entry_);
+    return TimerService::Global().Disarm(entry_);  // Stop() does not wait for an AfterFunc call
+}
 
-    // Timer expired normally, send the time
-    if (!stopped_) {
-        try {
-            ch_->send(Time::Now()); // send current time
-        } catch (const std::exception&) {
-            // Channel might be closed, ignore
-        }
-    }
+void Timer::drain() {
+    if (ch_ && ch_->canRecv()) ch_->tryRecv();
 }
 
 std::unique_ptr<Timer> NewTimer(Duration d) {
     return std::make_unique<Timer>(d);
 }
 
+std::unique_ptr<Timer> AfterFunc(Duration d, std::function<void()> f) {
+    return std::unique_ptr<Timer>(new Timer(d, std::move(f)));
+}
+
 } // namespace gocxx::time
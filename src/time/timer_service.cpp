@@ -0,0 +1,183 @@
+#include "gocxx/time/timer_service.h"
+
+namespace gocxx::time {
+
+namespace detail {
+
+    struct TimerEntry {
+        static constexpr std::size_t notPending = static_cast<std::size_t>(-1);
+
+        explicit TimerEntry(std::function<void()> f) : fn(std::move(f)) {}
+
+        std::function<void()> fn;
+        TimerService::Clock::time_point when{};
+        TimerService::Clock::duration period{0};
+        std::size_t index = notPending;  // Position in the heap; guarded by the service mutex
+    };
+
+} // namespace detail
+
+using detail::TimerEntry;
+
+namespace {
+    constexpr std::size_t kArity = 4;
+}
+
+TimerService::TimerService() = default;
+
+TimerService::~TimerService() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    wake_.notify_all();
+    if (thread_.joinable()) thread_.join();
+}
+
+TimerService& TimerService::Global() {
+    // Never destroyed: timers may be touched from static destructors
+    static TimerService* service = new TimerService();
+    return *service;
+}
+
+TimerService::Handle TimerService::Create(std::function<void()> fn) {
+    return std::make_shared<TimerEntry>(std::move(fn));
+}
+
+bool TimerService::Arm(const Handle& timer, Clock::time_point when, Duration period) {
+    bool notify;
+    bool wasPending;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        wasPending = timer->index != TimerEntry::notPending;
+        if (wasPending) remove(timer.get());
+        timer->when = when;
+        timer->period = period.Nanoseconds() > 0 ? period.ToStdDuration() : Clock::duration(0);
+        if (!thread_.joinable() && !stopping_) {
+            thread_ = std::thread(&TimerService::run, this);
+        }
+        push(timer);
+        // Wake the thread only if it would otherwise sleep past this deadline
+        notify = timer->index == 0 && when < sleepUntil_;
+    }
+    if (notify) wake_.notify_one();
+    return wasPending;
+}
+
+bool TimerService::ArmAfter(const Handle& timer, Duration d, Duration period) {
+    return Arm(timer, Clock::now() + d.ToStdDuration(), period);
+}
+
+bool TimerService::Disarm(const Handle& timer) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (timer->index == TimerEntry::notPending) return false;
+    remove(timer.get());
+    return true;
+}
+
+bool TimerService::DisarmSync(const Handle& timer) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    bool wasPending = timer->index != TimerEntry::notPending;
+    if (wasPending) remove(timer.get());
+    if (std::this_thread::get_id() != thread_.get_id()) {
+        callbackDone_.wait(lock, [&] { return running_ != timer.get(); });
+    }
+    return wasPending;
+}
+
+std::size_t TimerService::Pending() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return heap_.size();
+}
+
+void TimerService::run() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (!stopping_) {
+        if (heap_.empty()) {
+            sleepUntil_ = Clock::time_point::max();
+            wake_.wait(lock);
+            continue;
+        }
+        auto now = Clock::now();
+        if (heap_.front()->when > now) {
+            sleepUntil_ = heap_.front()->when;
+            wake_.wait_until(lock, sleepUntil_);
+            continue;
+        }
+        sleepUntil_ = now;
+
+        Handle timer = heap_.front();
+        remove(timer.get());
+        if (timer->period.count() > 0) {
+            timer->when += timer->period;
+            if (timer->when <= now) timer->when = now + timer->period;
+            push(timer);
+        }
+
+        running_ = timer.get();
+        lock.unlock();
+        // An exception escaping a callback terminates, as with gocxx::Go()
+        [&]() noexcept { timer->fn(); }();
+        lock.lock();
+        running_ = nullptr;
+        callbackDone_.notify_all();
+    }
+}
+
+// Heap helpers; the caller holds mutex_.
+
+void TimerService::place(std::size_t i, Handle timer) {
+    timer->index = i;
+    heap_[i] = std::move(timer);
+}
+
+void TimerService::push(const Handle& timer) {
+    heap_.push_back(timer);
+    timer->index = heap_.size() - 1;
+    siftUp(heap_.size() - 1);
+}
+
+void TimerService::remove(TimerEntry* timer) {
+    std::size_t i = timer->index;
+    timer->index = TimerEntry::notPending;
+    Handle last = std::move(heap_.back());
+    heap_.pop_back();
+    if (i == heap_.size()) return;  // Removed the last element
+    place(i, std::move(last));
+    if (i > 0 && heap_[i]->when < heap_[(i - 1) / kArity]->when) {
+        siftUp(i);
+    } else {
+        siftDown(i);
+    }
+}
+
+void TimerService::siftUp(std::size_t i) {
+    Handle timer = std::move(heap_[i]);
+    while (i > 0) {
+        std::size_t parent = (i - 1) / kArity;
+        if (!(timer->when < heap_[parent]->when)) break;
+        place(i, std::move(heap_[parent]));
+        i = parent;
+    }
+    place(i, std::move(timer));
+}
+
+void TimerService::siftDown(std::size_t i) {
+    Handle timer = std::move(heap_[i]);
+    const std::size_t n = heap_.size();
+    while (true) {
+        std::size_t first = i * kArity + 1;
+        if (first >= n) break;
+        std::size_t best = first;
+        std::size_t end = first + kArity < n ? first + kArity : n;
+        for (std::size_t c = first + 1; c < end; ++c) {
+            if (heap_[c]->when < heap_[best]->when) best = c;
+        }
+        if (!(heap_[best]->when < timer->when)) break;
+        place(i, std::move(heap_[best]));
+        i = best;
+    }
+    place(i, std::move(timer));
+}
+
+} // namespace gocxx::time
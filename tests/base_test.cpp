@@ -7,6 +7,7 @@
 #include <thread>
 #include <chrono>
 
+#include <list>
 #include <vector>
 #include <atomic>
 #include <future>
@@ -397,6 +398,297 @@ TEST_F(ChanTest, ConcurrentCloseAndOperations) {
    EXPECT_TRUE(exception_caught);
 }
 
+TEST_F(ChanTest, RingTrySendRespectsExactCapacity) {
+    Chan<int> ch(3);  // Not a power of two
+
+    EXPECT_TRUE(ch.trySend(1).Ok());
+    EXPECT_TRUE(ch.trySend(2).Ok());
+    EXPECT_TRUE(ch.trySend(3).Ok());
+    EXPECT_FALSE(ch.trySend(4).Ok());
+    EXPECT_FALSE(ch.canSend());
+
+    for (int lap = 0; lap < 10; ++lap) {
+        auto r = ch.tryRecv();
+        ASSERT_TRUE(r.Ok());
+        EXPECT_TRUE(ch.trySend(lap + 4).Ok());
+        EXPECT_FALSE(ch.trySend(-1).Ok());
+    }
+}
+
+TEST_F(ChanTest, RingCloseWakesParkedReceivers) {
+    Chan<int> ch(4);
+    std::atomic<int> woke{0};
+    std::vector<std::thread> receivers;
+
+    for (int i = 0; i < 3; ++i) {
+        receivers.emplace_back([&]() {
+            if (!ch.recv().has_value()) woke++;
+        });
+    }
+
+    std::this_thread::sleep_for(50ms);
+    ch.close();
+    for (auto& t : receivers) t.join();
+
+    EXPECT_EQ(woke.load(), 3);
+}
+
+TEST_F(ChanTest, SpscPreservesOrderAcrossWraparound) {
+    ChanOptions opts;
+    opts.spsc = true;
+    Chan<int> ch(5, opts);
+    constexpr int num_items = 20000;
+    bool in_order = true;
+
+    std::thread producer([&]() {
+        for (int i = 0; i < num_items; ++i) ch << i;
+        ch.close();
+    });
+
+    int expected = 0;
+    while (auto v = ch.recv()) {
+        if (*v != expected++) in_order = false;
+    }
+    producer.join();
+
+    EXPECT_TRUE(in_order);
+    EXPECT_EQ(expected, num_items);
+}
+
+TEST_F(ChanTest, SpscSingleSlotTryOperations) {
+    ChanOptions opts;
+    opts.spsc = true;
+    Chan<std::unique_ptr<int>> ch(1, opts);
+
+    EXPECT_TRUE(ch.trySend(std::make_unique<int>(7)).Ok());
+    EXPECT_FALSE(ch.canSend());
+    EXPECT_FALSE(ch.trySend(std::make_unique<int>(8)).Ok());
+
+    auto r = ch.tryRecv();
+    ASSERT_TRUE(r.Ok());
+    EXPECT_EQ(*r.value, 7);
+    EXPECT_FALSE(ch.tryRecv().Ok());
+
+    ch.close();
+    EXPECT_FALSE(ch.recv().has_value());
+    EXPECT_THROW(ch.send(std::make_unique<int>(9)), std::runtime_error);
+}
+
+TEST_F(ChanTest, SpscWorksWithSelect) {
+    ChanOptions opts;
+    opts.spsc = true;
+    Chan<int> ch(2, opts);
+    std::atomic<int> got{0};
+
+    std::thread sender([&]() {
+        std::this_thread::sleep_for(50ms);
+        ch << 5;
+    });
+
+    select(
+        recv<int>(ch, [&](std::optional<int> v) {
+            if (v) got = *v;
+        })
+    );
+
+    sender.join();
+    EXPECT_EQ(got.load(), 5);
+}
+
+TEST_F(ChanTest, RingManyProducersConsumersDeliverEverything) {
+    Chan<int> ch(8);
+    constexpr int num_producers = 8;
+    constexpr int num_consumers = 8;
+    constexpr int items_per_producer = 5000;
+
+    std::atomic<long long> sum{0};
+    std::atomic<int> count{0};
+    std::vector<std::thread> producers, consumers;
+
+    for (int p = 0; p < num_producers; ++p) {
+        producers.emplace_back([&]() {
+            for (int i = 1; i <= items_per_producer; ++i) ch << i;
+        });
+    }
+    for (int c = 0; c < num_consumers; ++c) {
+        consumers.emplace_back([&]() {
+            while (auto v = ch.recv()) {
+                sum += *v;
+                count++;
+            }
+        });
+    }
+
+    for (auto& t : producers) t.join();
+    ch.close();
+    for (auto& t : consumers) t.join();
+
+    EXPECT_EQ(count.load(), num_producers * items_per_producer);
+    EXPECT_EQ(sum.load(), 1LL * num_producers * items_per_producer * (items_per_producer + 1) / 2);
+}
+
+TEST_F(ChanTest, RingCloseRacingSendersNeverDeliversAfterEnd) {
+    for (int round = 0; round < 1000; ++round) {
+        Chan<int> ch(16);
+        constexpr int num_senders = 4;
+        std::atomic<int> sent{0};
+        std::atomic<bool> go{false};
+        std::vector<std::thread> senders;
+
+        for (int s = 0; s < num_senders; ++s) {
+            senders.emplace_back([&, s]() {
+                while (!go) std::this_thread::yield();
+                try {
+                    for (int i = 0;; ++i) {
+                        if ((i + s) % 3 == 0) {
+                            int batch[3] = {i, i, i};
+                            sent += static_cast<int>(ch.trySendBatch(batch, 3));
+                        } else if ((i + s) % 3 == 1) {
+                            ch.send(i);  // Throws once closed
+                            sent++;
+                        } else if (ch.trySend(i).Ok()) {
+                            sent++;
+                        } else if (ch.isClosed()) {
+                            return;
+                        }
+                    }
+                } catch (const std::runtime_error&) {
+                    // Closed
+                }
+            });
+        }
+
+        int received = 0;
+        std::thread closer([&]() {
+            while (!go) std::this_thread::yield();
+            std::this_thread::sleep_for(std::chrono::microseconds(round % 50));
+            ch.close();
+        });
+        go = true;
+        while (ch.recv()) received++;
+
+        // The end was reported: nothing may arrive afterwards
+        EXPECT_FALSE(ch.recv().has_value());
+        EXPECT_TRUE(ch.tryRecv().Failed());
+        for (auto& t : senders) t.join();
+        closer.join();
+        EXPECT_TRUE(ch.tryRecv().Failed());
+        ASSERT_EQ(received, sent.load()) << "round " << round;
+    }
+}
+
+TEST_F(ChanTest, BatchSendRecvPreservesOrder) {
+    for (std::size_t cap : {1u, 4u, 64u}) {
+        for (bool spsc : {false, true}) {
+            ChanOptions opts;
+            opts.spsc = spsc;
+            Chan<int> ch(cap, opts);
+            std::vector<int> input(1000);
+            for (int i = 0; i < 1000; ++i) input[i] = i;
+
+            std::thread producer([&]() {
+                ch.sendBatch(input);
+                ch.close();
+            });
+
+            std::vector<int> out;
+            while (ch.recvBatch(out, 37) > 0) {}
+            producer.join();
+
+            ASSERT_EQ(out.size(), 1000u) << "cap=" << cap << " spsc=" << spsc;
+            for (int i = 0; i < 1000; ++i) EXPECT_EQ(out[i], i);
+        }
+    }
+}
+
+TEST_F(ChanTest, TryBatchStopsAtCapacity) {
+    Chan<std::unique_ptr<int>> ch(4);
+    std::vector<std::unique_ptr<int>> values;
+    for (int i = 0; i < 6; ++i) values.push_back(std::make_unique<int>(i));
+
+    EXPECT_EQ(ch.trySendBatch(values), 4u);
+    EXPECT_EQ(values[3], nullptr);
+    ASSERT_NE(values[4], nullptr);
+
+    std::vector<std::unique_ptr<int>> out;
+    EXPECT_EQ(ch.tryRecvBatch(out, 3), 3u);
+    EXPECT_EQ(ch.tryRecvBatch(out, 3), 1u);
+    EXPECT_EQ(ch.tryRecvBatch(out, 3), 0u);
+    ASSERT_EQ(out.size(), 4u);
+    EXPECT_EQ(*out[3], 3);
+
+    ch.close();
+    EXPECT_EQ(ch.trySendBatch(values.data() + 4, 2), 0u);
+    EXPECT_EQ(ch.recvBatch(out, 8), 0u);
+}
+
+TEST_F(ChanTest, WaitPolicyIsConfigurablePerChannel) {
+    ChanOptions opts;
+    opts.wait = gocxx::sync::WaitPolicy::Block();
+    Chan<int> ch(0, opts);
+
+    std::thread sender([&]() {
+        std::this_thread::sleep_for(50ms);
+        ch << 1;
+    });
+    EXPECT_EQ(ch.recv().value_or(0), 1);
+    sender.join();
+
+    auto counts = ch.waitStats();
+    EXPECT_EQ(counts.spun + counts.yielded, 0u);
+    EXPECT_GE(counts.parked, 1u);
+}
+
+TEST_F(ChanTest, BatchRangesMoveFromEveryValue) {
+    Chan<std::unique_ptr<int>> ch(8);
+
+    std::vector<std::unique_ptr<int>> vec;
+    for (int i = 0; i < 3; ++i) vec.push_back(std::make_unique<int>(i));
+    ch.sendBatch(vec.begin(), vec.end());  // Sent in place
+    for (const auto& p : vec) EXPECT_EQ(p, nullptr);
+
+    std::list<std::unique_ptr<int>> list;
+    for (int i = 3; i < 6; ++i) list.push_back(std::make_unique<int>(i));
+    ch.sendBatch(list.begin(), list.end());  // Staged, but still moved
+    for (const auto& p : list) EXPECT_EQ(p, nullptr);
+
+    std::vector<std::unique_ptr<int>> out;
+    EXPECT_EQ(ch.recvBatch(out, 8), 6u);
+    for (int i = 0; i < 6; ++i) EXPECT_EQ(*out[i], i);
+}
+
+TEST_F(ChanTest, BatchManyProducersConsumers) {
+    Chan<int> ch(32);
+    constexpr int num_producers = 4;
+    constexpr int batches = 200;
+    constexpr int batch_size = 16;
+
+    std::atomic<long long> sum{0};
+    std::vector<std::thread> producers, consumers;
+    for (int p = 0; p < num_producers; ++p) {
+        producers.emplace_back([&]() {
+            std::vector<int> batch(batch_size, 1);
+            for (int b = 0; b < batches; ++b) {
+                ch.sendBatch(batch.begin(), batch.end());
+            }
+        });
+    }
+    for (int c = 0; c < 4; ++c) {
+        consumers.emplace_back([&]() {
+            std::vector<int> out;
+            while (ch.recvBatch(out, 64) > 0) {}
+            long long local = 0;
+            for (int v : out) local += v;
+            sum += local;
+        });
+    }
+
+    for (auto& t : producers) t.join();
+    ch.close();
+    for (auto& t : consumers) t.join();
+    EXPECT_EQ(sum.load(), 1LL * num_producers * batches * batch_size);
+}
+
 
 
 TEST(SelectTest, ReceivesFromFirstReadyChannel) {
@@ -513,6 +805,165 @@ TEST(SelectTest, CloseChannelSelectsRecvWithNullopt) {
     EXPECT_TRUE(gotClosed);
 }
 
+TEST(SelectTest, BlockedSendWakesWhenBufferDrains) {
+    Chan<int> ch(1);
+    ch << 1;
+    std::atomic<bool> sent = false;
+
+    std::thread t([&] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        ch.recv();
+    });
+
+    select(
+        send(ch, 2, [&](bool ok) { sent = ok; })
+    );
+
+    t.join();
+    EXPECT_TRUE(sent);
+    EXPECT_EQ(ch.recv().value_or(0), 2);
+}
+
+TEST(SelectTest, SendsMoveOnlyValues) {
+    Chan<std::unique_ptr<int>> ch(2);
+    bool sent = false;
+
+    select(
+        send(ch, std::make_unique<int>(7), [&](bool ok) { sent = ok; })
+    );
+
+    ASSERT_TRUE(sent);
+    auto v = ch.recv();
+    ASSERT_TRUE(v && *v);
+    EXPECT_EQ(**v, 7);
+}
+
+TEST(SelectTest, ManyConcurrentSelectsReceiveEverything) {
+    Chan<int> a, b(4);
+    constexpr int per_channel = 2000;
+    std::atomic<int> received{0};
+
+    std::vector<std::thread> receivers;
+    for (int r = 0; r < 4; ++r) {
+        receivers.emplace_back([&] {
+            bool open = true;
+            while (open) {
+                select(
+                    recv(a, [&](std::optional<int> v) { if (v) received++; else open = false; }),
+                    recv(b, [&](std::optional<int> v) { if (v) received++; else open = false; })
+                );
+            }
+        });
+    }
+
+    std::thread sa([&] { for (int i = 0; i < per_channel; ++i) a << i; });
+    std::thread sb([&] { for (int i = 0; i < per_channel; ++i) b << i; });
+    sa.join();
+    sb.join();
+    while (received.load() < 2 * per_channel) std::this_thread::yield();
+    a.close();
+    b.close();
+    for (auto& t : receivers) t.join();
+
+    EXPECT_EQ(received.load(), 2 * per_channel);
+}
+
+TEST(SelectTest, TimeoutCaseFiresWhenNothingReady) {
+    Chan<int> ch;
+    bool timedOut = false;
+    auto start = std::chrono::steady_clock::now();
+
+    select(
+        recv(ch, [](std::optional<int>) { FAIL() << "Should not receive"; }),
+        timeoutCase(gocxx::time::Milliseconds(50), [&] { timedOut = true; })
+    );
+
+    EXPECT_TRUE(timedOut);
+    EXPECT_GE(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(45));
+}
+
+TEST(SelectTest, ReadyCaseWinsOverTimeout) {
+    Chan<int> ch;
+    std::atomic<int> got{0};
+    std::thread t([&] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        ch << 3;
+    });
+
+    select(
+        recv(ch, [&](std::optional<int> v) { got = v.value_or(-1); }),
+        timeoutCase(gocxx::time::Milliseconds(5000), [&] { got = -2; })
+    );
+
+    t.join();
+    EXPECT_EQ(got.load(), 3);
+}
+
+TEST(SelectTest, LegacySelectHonoursTimeoutCase) {
+    Chan<int> ch;
+    bool timedOut = false;
+
+    Select sel;
+    sel.addCase(std::make_unique<RecvCase<int>>(ch, [](std::optional<int>) {}));
+    sel.addCase(std::make_unique<TimeoutCase>(gocxx::time::Milliseconds(30), [&] { timedOut = true; }));
+    sel.run();
+
+    EXPECT_TRUE(timedOut);
+}
+
+TEST(SelectSetTest, FansInFromThousandsOfChannels) {
+    constexpr int num_channels = 1000;
+    std::vector<Chan<int>> chans;
+    SelectSet<int> set;
+    for (int i = 0; i < num_channels; ++i) {
+        chans.emplace_back(1);
+        EXPECT_EQ(set.add(chans.back()), static_cast<std::size_t>(i));
+    }
+
+    std::thread producer([&] {
+        for (int round = 0; round < 3; ++round) {
+            for (int i = num_channels - 1; i >= 0; --i) chans[i] << i;
+        }
+    });
+
+    long long sum = 0;
+    for (int n = 0; n < 3 * num_channels; ++n) {
+        auto selected = set.recv();
+        ASSERT_TRUE(selected.value.has_value());
+        EXPECT_EQ(*selected.value, static_cast<int>(selected.index));
+        sum += *selected.value;
+    }
+    producer.join();
+
+    EXPECT_EQ(sum, 3LL * num_channels * (num_channels - 1) / 2);
+    EXPECT_FALSE(set.tryRecv().has_value());
+}
+
+TEST(SelectSetTest, ReportsClosedChannelsAndSupportsRemove) {
+    Chan<int> a(2), b(2);
+    SelectSet<int> set;
+    auto ia = set.add(a);
+    auto ib = set.add(b);
+
+    b.close();
+    auto closed = set.recv();
+    EXPECT_EQ(closed.index, ib);
+    EXPECT_FALSE(closed.value.has_value());
+    set.remove(ib);
+    EXPECT_EQ(set.size(), 1u);
+
+    a << 5;
+    auto got = set.tryRecv();
+    ASSERT_TRUE(got.has_value());
+    EXPECT_EQ(got->index, ia);
+    EXPECT_EQ(got->value.value_or(0), 5);
+
+    Chan<int> c(1);
+    c << 9;
+    EXPECT_EQ(set.add(c), ib);  // Freed index is reused
+    EXPECT_EQ(set.recv().value.value_or(0), 9);
+}
+
 // Basic Error Tests
 TEST(ErrorTest, New) {
     auto err = New("something went wrong");
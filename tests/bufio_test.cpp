@@ -0,0 +1,155 @@
+#include <gtest/gtest.h>
+#include <gocxx/bufio/bufio.h>
+#include <gocxx/io/io.h>
+#include <gocxx/io/io_errors.h>
+#include <gocxx/errors/errors.h>
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace gocxx::bufio;
+using gocxx::base::Result;
+using gocxx::errors::Is;
+using gocxx::io::ErrEOF;
+
+namespace {
+
+    /// Hands out at most `chunk` bytes per Read, to exercise refills
+    class ChunkReader : public gocxx::io::Reader {
+    public:
+        ChunkReader(std::string data, std::size_t chunk) : data_(std::move(data)), chunk_(chunk) {}
+
+        Result<std::size_t> Read(uint8_t* buffer, std::size_t size) override {
+            if (offset_ >= data_.size()) return { 0, ErrEOF };
+            std::size_t n = std::min({ size, chunk_, data_.size() - offset_ });
+            std::memcpy(buffer, data_.data() + offset_, n);
+            offset_ += n;
+            return n;
+        }
+
+    private:
+        std::string data_;
+        std::size_t chunk_;
+        std::size_t offset_ = 0;
+    };
+
+    class CountingWriter : public gocxx::io::Writer {
+    public:
+        Result<std::size_t> Write(const uint8_t* buffer, std::size_t size) override {
+            ++writes;
+            out.append(reinterpret_cast<const char*>(buffer), size);
+            return size;
+        }
+
+        std::string out;
+        int writes = 0;
+    };
+
+} // namespace
+
+TEST(BufioTest, ReaderPeekReadByteAndUnread) {
+    Reader r(std::make_shared<ChunkReader>("gocxx bufio", 3), 16);
+
+    auto peek = r.Peek(5);
+    ASSERT_TRUE(peek.Ok());
+    EXPECT_EQ(peek.value, "gocxx");
+
+    uint8_t b = 0;
+    ASSERT_TRUE(r.ReadByte(b).Ok());
+    EXPECT_EQ(b, 'g');
+    ASSERT_TRUE(r.UnreadByte().Ok());
+    EXPECT_FALSE(r.UnreadByte().Ok());
+
+    ASSERT_TRUE(r.Discard(6).Ok());
+    auto rest = r.Peek(10);
+    EXPECT_EQ(rest.value, "bufio");
+    EXPECT_TRUE(Is(rest.err, ErrEOF));
+
+    auto tooBig = r.Peek(17);
+    EXPECT_TRUE(Is(tooBig.err, ErrBufferFull));
+}
+
+TEST(BufioTest, ReaderReadSliceAndReadLine) {
+    Reader r(std::make_shared<ChunkReader>("one\r\ntwo\nthree-is-longer-than-the-buffer\nend", 5), 16);
+
+    auto slice = r.ReadSlice('\n');
+    ASSERT_TRUE(slice.Ok());
+    EXPECT_EQ(slice.value, "one\r\n");
+
+    auto line = r.ReadLine();
+    ASSERT_TRUE(line.Ok());
+    EXPECT_EQ(line.value.text, "two");
+    EXPECT_FALSE(line.value.isPrefix);
+
+    std::string longLine;
+    do {
+        line = r.ReadLine();
+        ASSERT_TRUE(line.Ok());
+        longLine.append(line.value.text);
+    } while (line.value.isPrefix);
+    EXPECT_EQ(longLine, "three-is-longer-than-the-buffer");
+
+    line = r.ReadLine();
+    ASSERT_TRUE(line.Ok());
+    EXPECT_EQ(line.value.text, "end");
+    EXPECT_TRUE(Is(r.ReadLine().err, ErrEOF));
+}
+
+TEST(BufioTest, WriterBuffersUntilFullOrFlush) {
+    auto sink = std::make_shared<CountingWriter>();
+    Writer w(sink, 8);
+
+    ASSERT_TRUE(w.WriteString("abc").Ok());
+    ASSERT_TRUE(w.WriteByte('d').Ok());
+    EXPECT_EQ(sink->writes, 0);
+    EXPECT_EQ(w.Buffered(), 4u);
+
+    ASSERT_TRUE(w.WriteString("efghij").Ok());  // Fills and flushes the buffer once
+    EXPECT_EQ(sink->writes, 1);
+    EXPECT_EQ(sink->out, "abcdefgh");
+
+    ASSERT_TRUE(w.Flush().Ok());
+    EXPECT_EQ(sink->out, "abcdefghij");
+
+    ASSERT_TRUE(w.WriteString("a write larger than the buffer").Ok());  // Bypasses it
+    EXPECT_EQ(sink->writes, 3);
+    EXPECT_EQ(w.Buffered(), 0u);
+}
+
+TEST(BufioTest, ScannerLinesWordsAndCustomSplit) {
+    Scanner lines(std::make_shared<ChunkReader>("alpha\r\nbeta\n\ngamma", 4));
+    std::vector<std::string> got;
+    while (lines.Scan()) got.push_back(lines.Text());
+    EXPECT_EQ(lines.Err(), nullptr);
+    EXPECT_EQ(got, (std::vector<std::string>{ "alpha", "beta", "", "gamma" }));
+
+    Scanner words(std::make_shared<ChunkReader>("  the quick\tbrown\n fox ", 3));
+    words.Split(ScanWords);
+    got.clear();
+    while (words.Scan()) got.push_back(words.Text());
+    EXPECT_EQ(got, (std::vector<std::string>{ "the", "quick", "brown", "fox" }));
+
+    // Comma-separated fields, stopping at the first "stop"
+    Scanner fields(std::make_shared<ChunkReader>("a,bb,stop,ccc", 2));
+    fields.Split([](std::string_view data, bool atEOF) -> SplitResult {
+        std::size_t i = data.find(',');
+        if (i == std::string_view::npos && !atEOF) return {};
+        std::string_view field = data.substr(0, i);
+        if (field == "stop") return { 0, field, true, ErrFinalToken };
+        return { i == std::string_view::npos ? data.size() : i + 1, field, !data.empty(), nullptr };
+    });
+    got.clear();
+    while (fields.Scan()) got.push_back(fields.Text());
+    EXPECT_EQ(fields.Err(), nullptr);
+    EXPECT_EQ(got, (std::vector<std::string>{ "a", "bb", "stop" }));
+}
+
+TEST(BufioTest, ScannerTokenTooLong) {
+    Scanner sc(std::make_shared<ChunkReader>(std::string(100, 'x') + "\nshort\n", 7));
+    sc.Buffer(16, 64);
+    EXPECT_FALSE(sc.Scan());
+    EXPECT_TRUE(Is(sc.Err(), ErrTooLong));
+    EXPECT_THROW(sc.Split(ScanBytes), std::runtime_error);
+}
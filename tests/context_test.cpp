@@ -258,3 +258,168 @@ TEST_F(ContextTest, UtilityFunctions) {
     EXPECT_TRUE(wait_result.Ok());
     EXPECT_TRUE(wait_result.value); // Should return true (context was canceled)
 }
+
+TEST_F(ContextTest, DoneCaseInSelect) {
+    auto result = WithCancel(Background());
+    ASSERT_TRUE(result.Ok());
+    auto ctx = result.value.first;
+    auto cancel = result.value.second;
+
+    auto valueCtx = WithValue(ctx, std::string("k"), 1).value;
+    Chan<int> never;
+    bool done = false;
+
+    std::thread t([&]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(30));
+        cancel();
+    });
+
+    select(
+        recv(never, [](std::optional<int>) { FAIL() << "Should not receive"; }),
+        doneCase(valueCtx, [&] { done = true; })
+    );
+    t.join();
+    EXPECT_TRUE(done);
+
+    // A background context never fires; the timeout does
+    bool timedOut = false;
+    select(
+        doneCase(Background(), [] { FAIL() << "Background is never done"; }),
+        timeoutCase(Milliseconds(10), [&] { timedOut = true; })
+    );
+    EXPECT_TRUE(timedOut);
+}
+
+TEST_F(ContextTest, TimeoutDeadlinePropagation) {
+    // Canceling a long timeout releases it at once
+    auto start = Time::Now();
+    {
+        auto [ctx, cancel] = WithTimeout(Background(), Milliseconds(10000)).value;
+        cancel();
+        EXPECT_EQ(ctx->Err().err->error(), Canceled);
+    }
+    EXPECT_LT(Time::Now().Sub(start).Nanoseconds(), Milliseconds(1000).Nanoseconds());
+
+    // A past deadline is exceeded immediately
+    auto [expired, cancelExpired] = WithDeadline(Background(), Time::Now().Add(Milliseconds(-1))).value;
+    EXPECT_TRUE(expired->IsCanceled());
+    EXPECT_EQ(expired->Err().err->error(), DeadlineExceeded);
+    cancelExpired();
+
+    // A child asking for a later deadline keeps its parent's
+    auto [parent, cancelParent] = WithTimeout(Background(), Milliseconds(50)).value;
+    auto [child, cancelChild] = WithTimeout(parent, Milliseconds(10000)).value;
+    EXPECT_EQ(child->Deadline().value.Sub(parent->Deadline().value).Nanoseconds(), 0);
+    std::this_thread::sleep_for(std::chrono::milliseconds(150));
+    EXPECT_EQ(parent->Err().err->error(), DeadlineExceeded);
+    EXPECT_EQ(child->Err().err->error(), DeadlineExceeded);
+    cancelChild();
+    cancelParent();
+}
+
+TEST_F(ContextTest, DeadlinePropagatesThroughValueLayers) {
+    static const ContextKey<int> Layer("layer");
+    auto [parent, cancelParent] = WithTimeout(Background(), Milliseconds(50)).value;
+    auto valued = WithValue(parent, std::string("request"), std::string("id")).value;
+    auto flat = Flatten(WithValue(valued, Layer, 1).value).value;
+
+    // Later deadlines than the parent's: canceled with it through the value layers
+    auto [child, cancelChild] = WithTimeout(valued, Milliseconds(200)).value;
+    auto [flatChild, cancelFlatChild] = WithTimeout(flat, Milliseconds(200)).value;
+    auto [cancelable, cancelCancelable] = WithCancel(valued).value;
+    std::this_thread::sleep_for(std::chrono::milliseconds(120));
+    EXPECT_TRUE(parent->IsCanceled());
+    EXPECT_TRUE(child->IsCanceled());
+    EXPECT_TRUE(flatChild->IsCanceled());
+    EXPECT_TRUE(cancelable->IsCanceled());
+    cancelChild();
+    cancelFlatChild();
+    cancelCancelable();
+    cancelParent();
+}
+
+TEST_F(ContextTest, ChildrenDetachFromParent) {
+    auto [root, cancelRoot] = WithCancel(Background()).value;
+    auto parent = std::dynamic_pointer_cast<CancelContext>(root);
+    ASSERT_TRUE(parent);
+
+    // Short-lived children must not accumulate on a long-lived parent
+    const int n = 1000000;
+    for (int i = 0; i < n; ++i) {
+        auto [child, cancelChild] = WithCancel(root).value;
+        if (i % 2 == 0) {
+            cancelChild();  // Canceled: detaches
+        }
+        // Odd ones are dropped uncanceled: destruction detaches
+    }
+    EXPECT_EQ(parent->NumChildren(), 0u);
+
+    std::vector<ContextPtr> live;
+    for (int i = 0; i < 1000; ++i) {
+        live.push_back(WithCancel(root).value.first);
+    }
+    EXPECT_EQ(parent->NumChildren(), 1000u);
+    EXPECT_TRUE(live[0]->Done().impl() == live[0]->Done().impl());
+
+    cancelRoot();
+    EXPECT_EQ(parent->NumChildren(), 0u);
+    for (auto& ctx : live) {
+        ASSERT_TRUE(ctx->IsCanceled());
+        EXPECT_EQ(ctx->Err().err->error(), Canceled);
+        EXPECT_FALSE(ctx->Done().recv().has_value());
+    }
+
+    // Deep chains cancel without recursion
+    auto [top, cancelTop] = WithCancel(Background()).value;
+    std::vector<ContextPtr> chain{top};
+    for (int i = 0; i < 10000; ++i) {
+        chain.push_back(WithCancel(chain.back()).value.first);
+    }
+    cancelTop();
+    EXPECT_TRUE(chain.back()->IsCanceled());
+    while (!chain.empty()) chain.pop_back();  // Leaf first: no recursive destruction
+}
+
+TEST_F(ContextTest, TypedKeysAndFlatten) {
+    static const ContextKey<std::string> RequestID("request_id");
+    static const ContextKey<int> Attempt("attempt");
+    static const ContextKey<std::string> Missing("missing");
+
+    auto [root, cancel] = WithCancel(Background()).value;
+    ContextPtr ctx = WithValue(root, RequestID, "req-1").value;
+    ctx = WithValue(ctx, Attempt, 1).value;
+    ctx = WithValue(ctx, std::string("legacy"), std::string("old")).value;
+    ctx = WithValue(ctx, Attempt, 2).value;  // Shadows the outer value
+
+    const std::string* id = RequestID.Lookup(*ctx);
+    ASSERT_NE(id, nullptr);
+    EXPECT_EQ(*id, "req-1");
+    EXPECT_EQ(*Attempt.Lookup(*ctx), 2);
+    EXPECT_EQ(Missing.Lookup(*ctx), nullptr);
+    EXPECT_FALSE(Missing.Value(ctx).Ok());
+    EXPECT_EQ(RequestID.Value(ctx).value, "req-1");
+
+    // Two keys with the same name are still different keys
+    ContextKey<std::string> otherRequestID("request_id");
+    EXPECT_EQ(otherRequestID.Lookup(*ctx), nullptr);
+
+    // Legacy keys and typed keys do not see each other
+    EXPECT_EQ(std::any_cast<std::string>(ctx->Value(std::string("legacy")).value), "old");
+    EXPECT_FALSE(ctx->Value(std::string("request_id")).Ok());
+
+    auto flat = Flatten(ctx).value;
+    EXPECT_EQ(RequestID.Lookup(*flat), RequestID.Lookup(*ctx));  // Same object, no copy
+    EXPECT_EQ(*Attempt.Lookup(*flat), 2);
+    EXPECT_EQ(Missing.Lookup(*flat), nullptr);
+    EXPECT_TRUE(flat->Value(std::string("legacy")).Ok());
+
+    auto above = WithValue(flat, Attempt, 3).value;
+    EXPECT_EQ(*Attempt.Lookup(*above), 3);
+    EXPECT_EQ(*RequestID.Lookup(*above), "req-1");
+
+    // Cancellation still flows through
+    cancel();
+    EXPECT_TRUE(flat->IsCanceled());
+    EXPECT_TRUE(above->IsCanceled());
+    EXPECT_FALSE(flat->Done().recv().has_value());
+}
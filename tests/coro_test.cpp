@@ -0,0 +1,171 @@
+#include <gtest/gtest.h>
+#include <gocxx/base/chan.h>
+#include <gocxx/context/context.h>
+#include <gocxx/runtime/executor.h>
+#include <gocxx/runtime/scheduler.h>
+#include <gocxx/time/timer.h>
+
+#if GOCXX_HAS_COROUTINES
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace gocxx::runtime;
+using gocxx::base::Chan;
+
+namespace {
+
+    Async produce(Chan<int> ch, int n) {
+        for (int i = 1; i <= n; ++i) co_await ch.sendAsync(i);
+        ch.close();
+    }
+
+    Async consume(Chan<int> ch, long& sum, int& count) {
+        while (auto v = co_await ch.recvAsync()) {
+            sum += *v;
+            ++count;
+        }
+    }
+
+} // namespace
+
+TEST(CoroutineTest, SendAndRecvOnOneExecutor) {
+    for (std::size_t buffer : {0, 1, 16}) {
+        Executor exec;
+        Chan<int> ch(buffer);
+        long sum = 0;
+        int count = 0;
+        exec.Spawn(consume(ch, sum, count));
+        exec.Spawn(produce(ch, 1000));
+        exec.Run();
+        EXPECT_EQ(count, 1000) << "buffer " << buffer;
+        EXPECT_EQ(sum, 1000L * 1001 / 2) << "buffer " << buffer;
+        EXPECT_EQ(exec.Live(), 0u);
+    }
+}
+
+TEST(CoroutineTest, ResumedByOtherThreads) {
+    // Blocking threads on the far side of the channels
+    Executor exec;
+    Chan<int> in(4), out;
+    long sum = 0;
+    int count = 0;
+    exec.Spawn([](Chan<int> in, Chan<int> out) -> Async {
+        while (auto v = co_await in.recvAsync()) co_await out.sendAsync(*v * 2);
+        out.close();
+    }(in, out));
+
+    std::thread producer([in]() mutable {
+        for (int i = 1; i <= 500; ++i) in.send(i);
+        in.close();
+    });
+    std::thread consumer([out, &sum, &count]() {
+        while (auto v = out.recv()) {
+            sum += *v;
+            ++count;
+        }
+    });
+    exec.Run();
+    producer.join();
+    consumer.join();
+    EXPECT_EQ(count, 500);
+    EXPECT_EQ(sum, 500L * 501);
+}
+
+TEST(CoroutineTest, SendOnClosedChannelThrows) {
+    Executor exec;
+    Chan<int> ch;
+    ch.close();
+    bool threw = false;
+    exec.Spawn([](Chan<int> ch, bool& threw) -> Async {
+        try {
+            co_await ch.sendAsync(1);
+        } catch (const std::runtime_error&) {
+            threw = true;
+        }
+    }(ch, threw));
+    exec.Run();
+    EXPECT_TRUE(threw);
+}
+
+TEST(CoroutineTest, SleepAndDone) {
+    using namespace gocxx::time;
+    Executor exec;
+    auto ctx = gocxx::context::WithCancel(gocxx::context::Background());
+    ASSERT_TRUE(ctx.Ok());
+    auto [child, cancel] = ctx.value;
+
+    std::vector<int> order;
+    exec.Spawn([](gocxx::context::ContextPtr c, std::vector<int>& order) -> Async {
+        co_await c->DoneAsync();
+        order.push_back(2);
+    }(child, order));
+    exec.Spawn([](std::function<void()> cancel, std::vector<int>& order) -> Async {
+        auto start = std::chrono::steady_clock::now();
+        co_await SleepAsync(Milliseconds(20));
+        EXPECT_GE(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(20));
+        order.push_back(1);
+        cancel();
+    }(cancel, order));
+    exec.Run();
+    EXPECT_EQ(order, (std::vector<int>{1, 2}));
+}
+
+TEST(CoroutineTest, RunInsideTask) {
+    // Run() parks its task while idle; the task may resume on another thread
+    using namespace gocxx::time;
+    std::atomic<bool> stop{false};
+    std::atomic<int> ticks{0};
+    {
+        Scheduler sched(4);
+        for (int i = 0; i < 3; ++i) {
+            sched.Go([&] {
+                while (!stop) Gosched();
+            });
+        }
+        sched.Go([&] {
+            Executor exec;
+            exec.Spawn([](std::atomic<int>& ticks) -> Async {
+                for (int i = 0; i < 50; ++i) {
+                    co_await SleepAsync(Milliseconds(1));
+                    ++ticks;
+                }
+            }(ticks));
+            exec.Run();
+            EXPECT_EQ(Executor::Current(), nullptr);
+            stop = true;
+        });
+    }
+    EXPECT_EQ(ticks.load(), 50);
+}
+
+TEST(CoroutineTest, DestructorFinishesCoroutinesLeftByStop) {
+    // The sleep posts to the executor after Run() has returned
+    using namespace gocxx::time;
+    bool woke = false;
+    {
+        Executor exec;
+        exec.Spawn([](bool& woke) -> Async {
+            co_await SleepAsync(Milliseconds(20));
+            woke = true;
+        }(woke));
+        exec.Spawn([](Executor& exec) -> Async {
+            exec.Stop();
+            co_return;
+        }(exec));
+        exec.Run();
+        EXPECT_FALSE(woke);
+        EXPECT_EQ(exec.Live(), 1u);
+    }
+    EXPECT_TRUE(woke);
+}
+
+TEST(CoroutineTest, AwaitOutsideExecutorThrows) {
+    Chan<int> ch;
+    auto awaiter = ch.recvAsync();
+    EXPECT_FALSE(awaiter.await_ready());
+    EXPECT_THROW(awaiter.await_suspend(std::noop_coroutine()), std::runtime_error);
+}
+
+#endif // GOCXX_HAS_COROUTINES
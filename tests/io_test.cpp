@@ -7,6 +7,8 @@
 #include <vector>
 #include <thread>
 #include <cstring>
+#include <atomic>
+#include <chrono>
 
 using namespace gocxx::io;
 using gocxx::base::Result;
@@ -105,6 +107,98 @@ TEST(IOTest, PipeTransfersData) {
     writerThread.join();
 }
 
+TEST(IOTest, PipeCarriesLargeStreamsThroughSmallBuffer) {
+    PipeOptions options;
+    options.bufferSize = 1024;
+    auto [r, w] = Pipe(options);
+
+    std::vector<uint8_t> data(1 << 20);
+    for (std::size_t i = 0; i < data.size(); ++i) data[i] = static_cast<uint8_t>(i * 7 + (i >> 11));
+
+    std::thread writerThread([w = w, &data] {
+        std::size_t off = 0;
+        for (std::size_t chunk = 1; off < data.size(); chunk = chunk * 3 % 5000 + 1) {
+            std::size_t n = std::min(chunk, data.size() - off);
+            auto res = w->Write(data.data() + off, n);
+            EXPECT_TRUE(res.Ok());
+            EXPECT_EQ(res.value, n);
+            off += n;
+        }
+        w->Close();
+    });
+
+    std::vector<uint8_t> got;
+    std::vector<uint8_t> buf(700);
+    for (;;) {
+        auto res = r->Read(buf.data(), buf.size());
+        got.insert(got.end(), buf.begin(), buf.begin() + res.value);
+        if (!res.Ok()) {
+            EXPECT_TRUE(Is(res.err, ErrEOF));
+            break;
+        }
+    }
+    writerThread.join();
+    EXPECT_TRUE(got == data);
+}
+
+TEST(IOTest, ZeroCopyPipeWriteWaitsForReaders) {
+    PipeOptions options;
+    options.zeroCopy = true;
+    auto [r, w] = Pipe(options);
+
+    std::atomic<bool> written{false};
+    std::thread writerThread([w = w, &written] {
+        std::string msg = "zero-copy!";
+        auto res = w->Write(reinterpret_cast<const uint8_t*>(msg.data()), msg.size());
+        EXPECT_TRUE(res.Ok());
+        EXPECT_EQ(res.value, msg.size());
+        written = true;
+    });
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    EXPECT_FALSE(written);
+
+    std::vector<uint8_t> buf(4);
+    auto first = r->Read(buf.data(), buf.size());
+    ASSERT_TRUE(first.Ok());
+    EXPECT_EQ(std::string(buf.begin(), buf.begin() + first.value), "zero");
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    EXPECT_FALSE(written);  // Six bytes still unread
+
+    std::vector<uint8_t> rest(16);
+    auto second = r->Read(rest.data(), rest.size());
+    ASSERT_TRUE(second.Ok());
+    EXPECT_EQ(std::string(rest.begin(), rest.begin() + second.value), "-copy!");
+    writerThread.join();
+    EXPECT_TRUE(written);
+}
+
+TEST(IOTest, PipeCloseUnblocksFullWriter) {
+    PipeOptions options;
+    options.bufferSize = 4;
+    auto [r, w] = Pipe(options);
+
+    Result<std::size_t> res{0};
+    std::thread writerThread([w = w, &res] {
+        res = w->Write(reinterpret_cast<const uint8_t*>("12345678"), 8);
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    r->CloseWithError(gocxx::errors::New("reader gone"));
+    writerThread.join();
+
+    EXPECT_FALSE(res.Ok());
+    EXPECT_EQ(res.value, 4u);  // What fit before the buffer filled
+
+    // Buffered bytes stay readable, then the close error is reported
+    std::vector<uint8_t> buf(8);
+    auto got = r->Read(buf.data(), buf.size());
+    ASSERT_TRUE(got.Ok());
+    EXPECT_EQ(std::string(buf.begin(), buf.begin() + got.value), "1234");
+    auto end = r->Read(buf.data(), buf.size());
+    ASSERT_FALSE(end.Ok());
+    EXPECT_EQ(end.err->error(), "reader gone");
+}
+
 TEST(IOTest, LimitedReaderStopsAtLimit) {
     auto baseReader = std::make_shared<StringReader>("HelloWorld");
     LimitedReader limited(baseReader, 5);
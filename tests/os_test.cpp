@@ -1,8 +1,13 @@
 #include <gtest/gtest.h>
 #include <gocxx/os/os.h>
 #include <gocxx/os/file.h>
+#include <gocxx/io/io.h>
+#include <gocxx/io/io_errors.h>
+#include <atomic>
 #include <thread>
 #include <chrono>
+#include <string>
+#include <vector>
 
 using namespace gocxx::os;
 using namespace std::chrono_literals;
@@ -215,3 +220,114 @@ TEST_F(OsTest, ProcessManagement) {
         EXPECT_EQ(process->Pid(), current_pid);
     }
 }
+
+// io::Copy between files goes through File::WriteTo/ReadFrom
+TEST_F(OsTest, CopyFileToFile) {
+    std::string srcName = TempDir() + "/gocxx_copy_src.bin";
+    std::string dstName = TempDir() + "/gocxx_copy_dst.bin";
+    std::string content;
+    for (int i = 0; content.size() < 3 * 1024 * 1024 + 17; ++i) content += std::to_string(i) + ",";
+    ASSERT_TRUE(WriteFile(srcName, content, 0644).Ok());
+
+    auto src = Open(srcName);
+    auto dst = Create(dstName);
+    ASSERT_TRUE(src.Ok());
+    ASSERT_TRUE(dst.Ok());
+    auto res = gocxx::io::Copy(dst.value, src.value);
+    EXPECT_TRUE(res.Ok());
+    EXPECT_EQ(res.value, content.size());
+    dst.value->close();
+    auto copied = ReadFile(dstName);
+    EXPECT_EQ(std::string(copied.value.begin(), copied.value.end()), content);
+
+    // CopyN stops after n bytes and leaves the source offset just past them
+    auto src2 = Open(srcName);
+    auto dst2 = Create(dstName);
+    auto n = gocxx::io::CopyN(dst2.value, src2.value, 1000);
+    EXPECT_TRUE(n.Ok());
+    EXPECT_EQ(n.value, 1000u);
+    uint8_t next = 0;
+    ASSERT_EQ(src2.value->Read(&next, 1).value, 1u);
+    EXPECT_EQ(next, static_cast<uint8_t>(content[1000]));
+
+    auto tooMany = gocxx::io::CopyN(dst2.value, Open(srcName).value, content.size() + 1);
+    EXPECT_TRUE(gocxx::errors::Is(tooMany.err, gocxx::io::ErrUnexpectedEOF));
+    EXPECT_EQ(tooMany.value, content.size());
+
+    Remove(srcName);
+    Remove(dstName);
+}
+
+TEST_F(OsTest, CopyPipeToFile) {
+    auto pipe = Pipe();
+    ASSERT_TRUE(pipe.Ok());
+    auto [r, w] = pipe.value;
+    std::string dstName = TempDir() + "/gocxx_copy_pipe.bin";
+    auto dst = Create(dstName);
+    ASSERT_TRUE(dst.Ok());
+
+    std::string content(256 * 1024 + 5, 'p');
+    std::thread writer([&, w = w] {
+        w->Write(reinterpret_cast<const uint8_t*>(content.data()), content.size());
+        w->close();
+    });
+    auto res = gocxx::io::Copy(dst.value, r);
+    writer.join();
+
+    EXPECT_TRUE(res.Ok());
+    EXPECT_EQ(res.value, content.size());
+    dst.value->close();
+    auto copied = ReadFile(dstName);
+    EXPECT_EQ(copied.value.size(), content.size());
+    Remove(dstName);
+}
+
+TEST_F(OsTest, PositionalIO) {
+    auto created = CreateTemp("", "gocxx_pio_*");
+    ASSERT_TRUE(created.Ok());
+    auto f = created.value;
+
+    std::string head = "hello ";
+    std::string a = "vectored ";
+    std::string b = "world";
+    ASSERT_TRUE(f->WriteAt(reinterpret_cast<const uint8_t*>(head.data()), head.size(), 0).Ok());
+    auto wv = f->WritevAt({{reinterpret_cast<const uint8_t*>(a.data()), a.size()},
+                           {reinterpret_cast<const uint8_t*>(b.data()), b.size()}},
+                          head.size());
+    ASSERT_TRUE(wv.Ok());
+    EXPECT_EQ(wv.value, a.size() + b.size());
+    EXPECT_EQ(f->Seek(0, gocxx::io::SeekCurrent).value, 0u);  // Offset untouched
+
+    std::vector<uint8_t> x(5), y(9);
+    auto rv = f->ReadvAt({{x.data(), x.size()}, {y.data(), y.size()}}, 1);
+    ASSERT_TRUE(rv.Ok());
+    EXPECT_EQ(std::string(x.begin(), x.end()) + std::string(y.begin(), y.end()), "ello vectored ");
+
+    std::vector<uint8_t> tail(10);
+    auto past = f->ReadAt(tail.data(), tail.size(), 15);
+    EXPECT_TRUE(gocxx::errors::Is(past.err, gocxx::io::ErrEOF));
+    EXPECT_EQ(past.value, 5u);
+
+    // Concurrent readers each see their own offset
+    std::vector<uint8_t> blocks(64 * 4096);
+    for (std::size_t i = 0; i < blocks.size(); ++i) blocks[i] = static_cast<uint8_t>(i / 4096);
+    ASSERT_TRUE(f->WriteAt(blocks.data(), blocks.size(), 0).Ok());
+    std::atomic<int> wrong{0};
+    std::vector<std::thread> readers;
+    for (int t = 0; t < 4; ++t) {
+        readers.emplace_back([&, t] {
+            std::vector<uint8_t> buf(4096);
+            for (int i = 0; i < 500; ++i) {
+                std::size_t block = (i * 7 + t * 13) % 64;
+                auto res = f->ReadAt(buf.data(), buf.size(), block * 4096);
+                if (!res.Ok() || buf[0] != block || buf[4095] != block) ++wrong;
+            }
+        });
+    }
+    for (auto& r : readers) r.join();
+    EXPECT_EQ(wrong.load(), 0);
+
+    std::string name = f->Name();
+    f->close();
+    Remove(name);
+}
@@ -0,0 +1,279 @@
+#include <gtest/gtest.h>
+#include <gocxx/runtime/deque.h>
+#include <gocxx/runtime/scheduler.h>
+#include <gocxx/base/chan.h>
+#include <gocxx/base/select.h>
+#include <gocxx/sync/mutex.h>
+#include <gocxx/sync/rwmutex.h>
+#include <gocxx/sync/waitgroup.h>
+#include <gocxx/time/time.h>
+
+#include <atomic>
+#include <future>
+#include <thread>
+#include <vector>
+
+using namespace gocxx::runtime;
+using gocxx::base::Chan;
+using gocxx::sync::WaitGroup;
+
+TEST(WorkStealingDequeTest, OwnerIsLifoThievesAreFifo) {
+    WorkStealingDeque<int> dq(2);
+    for (int i = 0; i < 10; ++i) dq.Push(i);  // Grows past the initial ring
+    EXPECT_EQ(dq.Size(), 10u);
+    EXPECT_EQ(dq.Pop().value(), 9);
+    EXPECT_EQ(dq.Steal().value(), 0);
+    EXPECT_EQ(dq.Steal().value(), 1);
+    EXPECT_EQ(dq.Pop().value(), 8);
+    while (dq.Pop()) {}
+    EXPECT_TRUE(dq.Empty());
+    EXPECT_FALSE(dq.Pop().has_value());
+    EXPECT_FALSE(dq.Steal().has_value());
+}
+
+TEST(WorkStealingDequeTest, EveryItemTakenExactlyOnce) {
+    const int n = 200000;
+    WorkStealingDeque<int> dq(4);
+    std::vector<std::atomic<int>> seen(n);
+    std::atomic<bool> done{false};
+
+    std::vector<std::thread> thieves;
+    for (int t = 0; t < 3; ++t) {
+        thieves.emplace_back([&] {
+            while (!done.load() || !dq.Empty()) {
+                if (auto v = dq.Steal()) seen[*v].fetch_add(1);
+            }
+        });
+    }
+    for (int i = 0; i < n; ++i) {
+        dq.Push(i);
+        if (i % 3 == 0) {
+            if (auto v = dq.Pop()) seen[*v].fetch_add(1);
+        }
+    }
+    while (auto v = dq.Pop()) seen[*v].fetch_add(1);
+    done = true;
+    for (auto& t : thieves) t.join();
+
+    for (int i = 0; i < n; ++i) {
+        ASSERT_EQ(seen[i].load(), 1) << "item " << i;
+    }
+}
+
+TEST(SchedulerTest, RunsNestedTasks) {
+    std::atomic<int> count{0};
+    {
+        Scheduler sched(4);
+        EXPECT_EQ(sched.Procs(), 4u);
+        for (int i = 0; i < 100; ++i) {
+            sched.Go([&] {
+                for (int j = 0; j < 100; ++j) {
+                    sched.Go([&] { count.fetch_add(1); });
+                }
+            });
+        }
+    }  // The destructor waits for every task
+    EXPECT_EQ(count.load(), 10000);
+}
+
+TEST(SchedulerTest, BlockedTaskLetsOthersRun) {
+    // One processor: the receivers block before the sender runs, so the
+    // sender only gets to run if blocked tasks give the processor up
+    Scheduler sched(1);
+    Chan<int> ch;
+    std::atomic<int> sum{0};
+    WaitGroup wg;
+    wg.Add(4);
+    for (int i = 0; i < 3; ++i) {
+        sched.Go([&] {
+            sum.fetch_add(*ch.recv());
+            wg.Done();
+        });
+    }
+    sched.Go([&] {
+        for (int i = 1; i <= 3; ++i) ch.send(i);
+        wg.Done();
+    });
+    wg.Wait();
+    EXPECT_EQ(sum.load(), 6);
+}
+
+TEST(SchedulerTest, BlockingRegionHandsOffItsProcessor) {
+    // A wait the scheduler cannot see: only the region frees the processor
+    Scheduler sched(1);
+    std::promise<void> ready;
+    std::future<void> readyFuture = ready.get_future();
+    WaitGroup wg;
+    wg.Add(2);
+    sched.Go([&] {
+        BlockingRegion blocking;
+        readyFuture.wait();
+        wg.Done();
+    });
+    sched.Go([&] {
+        ready.set_value();
+        wg.Done();
+    });
+    wg.Wait();
+}
+
+#if GOCXX_HAS_FIBERS
+
+TEST(SchedulerTest, ParkedTasksDoNotHoldThreads) {
+    const int n = 10000;
+    Scheduler sched(1);
+    Chan<int> ch;
+    std::atomic<long> sum{0};
+    WaitGroup wg;
+    wg.Add(n);
+    for (int i = 0; i < n; ++i) {
+        sched.Go([&] {
+            sum.fetch_add(*ch.recv());
+            wg.Done();
+        });
+    }
+    for (int i = 1; i <= n; ++i) ch.send(i);
+    wg.Wait();
+    EXPECT_EQ(sum.load(), static_cast<long>(n) * (n + 1) / 2);
+    EXPECT_EQ(sched.NumThreads(), 1u);
+}
+
+TEST(SchedulerTest, SleepSelectAndWaitGroupSuspendTasks) {
+    Scheduler sched(1);
+    Chan<int> never;
+    std::atomic<int> timeouts{0};
+    WaitGroup outer;
+    outer.Add(100);
+    for (int i = 0; i < 100; ++i) {
+        sched.Go([&] {
+            gocxx::time::Sleep(gocxx::time::Milliseconds(5));
+            gocxx::base::select(
+                gocxx::base::recv(never, [](std::optional<int>) {}),
+                gocxx::base::timeoutCase(gocxx::time::Milliseconds(5), [&] { timeouts.fetch_add(1); }));
+
+            WaitGroup inner;
+            inner.Add(1);
+            sched.Go([&] { inner.Done(); });
+            inner.Wait();
+            outer.Done();
+        });
+    }
+    outer.Wait();
+    EXPECT_EQ(timeouts.load(), 100);
+    EXPECT_EQ(sched.NumThreads(), 1u);
+}
+
+TEST(SchedulerTest, ContendedMutexSuspendsTasks) {
+    // One processor: the holder sleeps with the mutex locked, so it only
+    // gets to unlock if the waiting tasks give the processor up
+    Scheduler sched(1);
+    gocxx::sync::Mutex mtx;
+    std::atomic<int> done{0};
+    WaitGroup wg;
+    wg.Add(3);
+    sched.Go([&] {
+        mtx.Lock();
+        gocxx::time::Sleep(gocxx::time::Milliseconds(50));
+        mtx.Unlock();
+        done.fetch_add(1);
+        wg.Done();
+    });
+    for (int i = 0; i < 2; ++i) {
+        sched.Go([&] {
+            gocxx::sync::Lock lock(mtx);
+            done.fetch_add(1);
+            wg.Done();
+        });
+    }
+    wg.Wait();
+    EXPECT_EQ(done.load(), 3);
+    EXPECT_EQ(sched.NumThreads(), 1u);
+}
+
+TEST(SchedulerTest, RWMutexWritersSuspendTasks) {
+    // One processor: the first writer waits for a sleeping reader and the
+    // second writer for the first, so the reader only gets to finish if
+    // both writers give the processor up
+    Scheduler sched(1);
+    gocxx::sync::RWMutex mtx;
+    std::atomic<int> done{0};
+    WaitGroup wg;
+    wg.Add(3);
+    sched.Go([&] {
+        mtx.RLock();
+        gocxx::time::Sleep(gocxx::time::Milliseconds(50));
+        mtx.RUnlock();
+        done.fetch_add(1);
+        wg.Done();
+    });
+    for (int i = 0; i < 2; ++i) {
+        sched.Go([&] {
+            gocxx::sync::WriteLock lock(mtx);
+            done.fetch_add(1);
+            wg.Done();
+        });
+    }
+    wg.Wait();
+    EXPECT_EQ(done.load(), 3);
+    EXPECT_EQ(sched.NumThreads(), 1u);
+}
+
+TEST(SchedulerTest, TasksMigrateWithTheirState) {
+    // Registers, floating point state and locals survive switches and
+    // moves between threads
+    Scheduler sched(4);
+    std::atomic<int> bad{0};
+    for (int t = 0; t < 16; ++t) {
+        sched.Go([&, t] {
+            double x = t;
+            long acc = 0;
+            for (int i = 0; i < 1000; ++i) {
+                x = x * 1.0000001 + 0.5;
+                acc += i ^ t;
+                Gosched();
+            }
+            double want = t;
+            long wantAcc = 0;
+            for (int i = 0; i < 1000; ++i) {
+                want = want * 1.0000001 + 0.5;
+                wantAcc += i ^ t;
+            }
+            if (x != want || acc != wantAcc) bad.fetch_add(1);
+        });
+    }
+    while (sched.NumTasks() > 0) std::this_thread::yield();
+    EXPECT_EQ(bad.load(), 0);
+}
+
+TEST(SchedulerTest, TaskStackFitsDeepFrames) {
+    Scheduler sched(1, 512 * 1024);
+    std::atomic<long> result{0};
+    sched.Go([&] {
+        // Most of the stack, in 4 KiB frames
+        std::function<long(int)> depth = [&](int n) -> long {
+            volatile char frame[4096];
+            frame[0] = static_cast<char>(n);
+            return n == 0 ? 0 : frame[0] + depth(n - 1) - n + 1;
+        };
+        result = depth(100);
+    });
+    while (sched.NumTasks() > 0) std::this_thread::yield();
+    EXPECT_EQ(result.load(), 100);
+}
+
+#endif // GOCXX_HAS_FIBERS
+
+TEST(SchedulerTest, GlobalGo) {
+    WaitGroup wg;
+    std::atomic<int> count{0};
+    wg.Add(1000);
+    for (int i = 0; i < 1000; ++i) {
+        gocxx::Go([&] {
+            count.fetch_add(1);
+            wg.Done();
+        });
+    }
+    wg.Wait();
+    EXPECT_EQ(count.load(), 1000);
+    EXPECT_GE(GOMAXPROCS(), 1u);
+}
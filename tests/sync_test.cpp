@@ -5,7 +5,13 @@
 #include <mutex>
 #include <condition_variable>
 #include <atomic>
+#include <memory>
+#include <string>
 #include "gocxx/sync/sync.h"
+#include "gocxx/sync/errgroup.h"
+#include "gocxx/sync/singleflight.h"
+#include "gocxx/context/context.h"
+#include "gocxx/time/time.h"
 
 using namespace gocxx::sync;
 
@@ -92,6 +98,88 @@ TEST(MutexTest, MultiThreadedIncrement) {
     EXPECT_EQ(counter, num_threads * num_iterations);
 }
 
+TEST(MutexTest, TryLockAndMisuse) {
+    Mutex mtx;
+    EXPECT_TRUE(mtx.TryLock());
+    EXPECT_FALSE(mtx.TryLock());
+    std::thread t([&] { EXPECT_FALSE(mtx.TryLock()); });
+    t.join();
+    mtx.Unlock();
+    EXPECT_THROW(mtx.Unlock(), std::runtime_error);
+    EXPECT_TRUE(mtx.TryLock());  // Still usable after the failed Unlock
+    mtx.Unlock();
+}
+
+TEST(MutexTest, StarvedWaiterGetsTheLock) {
+    Mutex mtx;
+    std::atomic<bool> waiterDone{false};
+    std::atomic<bool> hogStarted{false};
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+
+    // Re-locks straight after every unlock; would keep barging ahead of a sleeper
+    std::thread hog([&] {
+        while (!waiterDone && std::chrono::steady_clock::now() < deadline) {
+            Lock lock(mtx);
+            hogStarted = true;
+            auto until = std::chrono::steady_clock::now() + std::chrono::microseconds(50);
+            while (std::chrono::steady_clock::now() < until) {}
+        }
+    });
+    while (!hogStarted) std::this_thread::yield();
+
+    auto start = std::chrono::steady_clock::now();
+    {
+        Lock lock(mtx);
+        waiterDone = true;
+    }
+    auto waited = std::chrono::steady_clock::now() - start;
+    hog.join();
+    EXPECT_LT(waited, std::chrono::seconds(1));
+}
+
+namespace {
+
+    // The call site the profile should report; kept out of line so its code
+    // range is known
+    GOCXX_MUTEX_NOINLINE void lockAndUnlock(Mutex& mtx) {
+        mtx.Lock();
+        mtx.Unlock();
+    }
+
+} // namespace
+
+TEST(MutexTest, ContentionProfileRecordsCallSite) {
+    ResetMutexProfile();
+    int previous = SetMutexProfileFraction(1);
+    Mutex mtx;
+    std::atomic<bool> waiting{false};
+
+    mtx.Lock();
+    std::thread t([&] {
+        waiting = true;
+        lockAndUnlock(mtx);  // Blocks about 30ms
+    });
+    while (!waiting) std::this_thread::yield();
+    std::this_thread::sleep_for(std::chrono::milliseconds(30));
+    mtx.Unlock();
+    t.join();
+    SetMutexProfileFraction(previous);
+
+    auto profile = MutexProfile();
+    ASSERT_FALSE(profile.empty());
+    EXPECT_EQ(profile[0].count, 1u);
+    EXPECT_GE(profile[0].waitNanos, 20'000'000u);
+    // Attributed to the function that called Lock(), not to Mutex itself
+    auto site = reinterpret_cast<std::uintptr_t>(profile[0].site);
+    auto helper = reinterpret_cast<std::uintptr_t>(&lockAndUnlock);
+    EXPECT_GT(site, helper);
+    EXPECT_LT(site, helper + 256);
+    EXPECT_EQ(profile[0].Symbol().find("gocxx::sync::Mutex::"), std::string::npos) << profile[0].Symbol();
+
+    ResetMutexProfile();
+    EXPECT_TRUE(MutexProfile().empty());
+}
+
 TEST(SyncOnceTest, OnlyRunsOnce) {
     Once once;
     std::atomic<int> counter{0};
@@ -198,6 +286,156 @@ TEST(PoolTest, ThreadSafety) {
     EXPECT_LE(created, threadCount * perThreadOps); 
 }
 
+namespace {
+    struct Tracked {
+        static inline std::atomic<int> live{0};
+        int value = 0;
+        Tracked() { live++; }
+        ~Tracked() { live--; }
+    };
+
+    struct Slow {
+        static inline std::atomic<int> live{0};
+        Slow() { live++; }
+        ~Slow() {
+            std::this_thread::sleep_for(std::chrono::milliseconds(250));
+            live--;
+        }
+    };
+}
+
+TEST(PoolTest, ReusesObjectsPutByOtherThreads) {
+    std::atomic<int> created{0};
+    Pool<Dummy> pool([&] {
+        created++;
+        return std::make_shared<Dummy>();
+    });
+
+    std::thread producer([&] {
+        std::vector<std::shared_ptr<Dummy>> objs;
+        for (int i = 0; i < 4; ++i) objs.push_back(pool.Get());
+        for (auto& obj : objs) pool.Put(std::move(obj));
+    });
+    producer.join();
+    EXPECT_EQ(created, 4);
+
+    std::vector<std::shared_ptr<Dummy>> again;
+    for (int i = 0; i < 4; ++i) again.push_back(pool.Get());
+    EXPECT_EQ(created, 4);  // Stolen from the producer's shard
+}
+
+TEST(PoolTest, SweepReleasesIdleObjects) {
+    Pool<Tracked> pool([] { return std::make_shared<Tracked>(); });
+    {
+        auto a = pool.Get();
+        auto b = pool.Get();
+        a->value = 1;
+        pool.Put(a);
+        pool.Put(b);
+    }
+    EXPECT_EQ(Tracked::live, 2);
+
+    SweepPools();  // Into the victim cache, still reusable
+    EXPECT_EQ(Tracked::live, 2);
+    auto kept = pool.Get();
+    EXPECT_EQ(Tracked::live, 2);
+
+    SweepPools();  // The other one was idle for a whole cycle
+    EXPECT_EQ(Tracked::live, 1);
+    pool.Put(kept);
+    kept.reset();
+    SweepPools();
+    SweepPools();
+    EXPECT_EQ(Tracked::live, 0);
+}
+
+TEST(PoolTest, BackgroundSweepDoesNotDelayTimers) {
+    using gocxx::time::TimerService;
+    Pool<Slow> pool([] { return std::make_shared<Slow>(); });
+    {
+        auto a = pool.Get();
+        auto b = pool.Get();
+        pool.Put(a);
+        pool.Put(b);
+    }
+    SweepPools();  // Into the victim cache; the next sweep frees them
+    ASSERT_EQ(Slow::live, 2);
+
+    auto& timers = TimerService::Global();
+    std::atomic<bool> fired{false};
+    std::atomic<int64_t> lateMs{0};
+    auto due = TimerService::Clock::now() + std::chrono::milliseconds(30);
+    auto sweep = timers.Create(&detail::SweepPoolsInBackground);
+    auto probe = timers.Create([&] {
+        auto late = TimerService::Clock::now() - due;
+        lateMs = std::chrono::duration_cast<std::chrono::milliseconds>(late).count();
+        fired = true;
+    });
+    timers.ArmAfter(sweep, gocxx::time::Milliseconds(10));
+    timers.Arm(probe, due);
+
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while ((!fired || Slow::live != 0) && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    timers.DisarmSync(sweep);
+    timers.DisarmSync(probe);
+    ASSERT_TRUE(fired);
+    EXPECT_LT(lateMs, 200);  // Freeing both victims inline would take 500ms
+    EXPECT_EQ(Slow::live, 0);
+}
+
+TEST(UniquePoolTest, ReturnsObjectsOnRelease) {
+    std::atomic<int> created{0};
+    {
+        UniquePool<Tracked> pool([&] {
+            created++;
+            return std::make_unique<Tracked>();
+        });
+
+        Tracked* first = nullptr;
+        {
+            auto obj = pool.Get();
+            obj->value = 42;
+            first = obj.get();
+        }
+        auto obj = pool.Get();
+        EXPECT_EQ(obj.get(), first);
+        EXPECT_EQ(obj->value, 42);
+        EXPECT_EQ(created, 1);
+
+        auto other = pool.Get();
+        EXPECT_NE(other.get(), first);
+        EXPECT_EQ(created, 2);
+    }
+    EXPECT_EQ(Tracked::live, 0);  // Cached objects die with the pool
+}
+
+TEST(UniquePoolTest, ThreadSafety) {
+    std::atomic<int> created{0};
+    UniquePool<Dummy> pool([&] {
+        created++;
+        return std::make_unique<Dummy>();
+    });
+
+    constexpr int threadCount = 8;
+    constexpr int perThreadOps = 1000;
+    std::vector<std::thread> threads;
+    for (int i = 0; i < threadCount; ++i) {
+        threads.emplace_back([&] {
+            for (int j = 0; j < perThreadOps; ++j) {
+                auto a = pool.Get();
+                auto b = pool.Get();
+                a->value = j;
+                b->value = -j;
+                EXPECT_EQ(a->value, j);
+            }
+        });
+    }
+    for (auto& t : threads) t.join();
+    EXPECT_LE(created, threadCount * 2 * 4);  // Far fewer than threadCount * perThreadOps * 2
+}
+
 TEST(RWMutexTest, ReadWriteAccess) {
     RWMutex mtx;
     int counter = 0;
@@ -226,6 +464,431 @@ TEST(RWMutexTest, ReadWriteAccess) {
     EXPECT_EQ(counter, 5);
 }
 
+TEST(RWMutexTest, WritersExcludeReaders) {
+    RWMutex mtx;
+    int64_t a = 0, b = 0;  // Equal whenever no writer holds the lock
+    std::atomic<bool> torn{false};
+    std::atomic<bool> stop{false};
+
+    std::vector<std::thread> readers;
+    for (int i = 0; i < 6; ++i) {
+        readers.emplace_back([&] {
+            while (!stop) {
+                ReadLock lock(mtx);
+                if (a != b) torn = true;
+            }
+        });
+    }
+    std::vector<std::thread> writers;
+    for (int i = 0; i < 2; ++i) {
+        writers.emplace_back([&] {
+            for (int j = 0; j < 2000; ++j) {
+                WriteLock lock(mtx);
+                ++a;
+                std::this_thread::yield();
+                ++b;
+            }
+        });
+    }
+    for (auto& t : writers) t.join();
+    stop = true;
+    for (auto& t : readers) t.join();
+
+    EXPECT_FALSE(torn);
+    EXPECT_EQ(a, 4000);
+    EXPECT_EQ(b, 4000);
+}
+
+TEST(RWMutexTest, TryLocks) {
+    RWMutex mtx;
+    ASSERT_TRUE(mtx.TryRLock());
+    EXPECT_TRUE(mtx.TryRLock());
+    EXPECT_FALSE(mtx.TryLock());
+    mtx.RUnlock();
+    mtx.RUnlock();
+
+    ASSERT_TRUE(mtx.TryLock());
+    EXPECT_FALSE(mtx.TryRLock());
+    std::thread t([&] { EXPECT_FALSE(mtx.TryLock()); });
+    t.join();
+    mtx.Unlock();
+    EXPECT_TRUE(mtx.TryRLock());
+    mtx.RUnlock();
+}
+
+TEST(RWMutexTest, ReadUnlockOnAnotherThread) {
+    RWMutex mtx;
+    std::thread locker([&] { mtx.RLock(); });
+    locker.join();
+
+    std::atomic<bool> written{false};
+    std::thread writer([&] {
+        WriteLock lock(mtx);
+        written = true;
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    EXPECT_FALSE(written);  // Still read-locked
+
+    mtx.RUnlock();  // Released from a thread that never locked it, as a migrated task would
+    writer.join();
+    EXPECT_TRUE(written);
+}
+
+TEST(MapTest, BasicOperations) {
+    Map<std::string, int> m;
+    EXPECT_FALSE(m.Load("a").has_value());
+
+    m.Store("a", 1);
+    EXPECT_EQ(m.Load("a").value(), 1);
+    m.Store("a", 2);
+    EXPECT_EQ(m.Load("a").value(), 2);
+
+    EXPECT_EQ(m.LoadOrStore("a", 3), std::make_pair(2, true));
+    EXPECT_EQ(m.LoadOrStore("b", 3), std::make_pair(3, false));
+
+    EXPECT_FALSE(m.CompareAndSwap("b", 4, 5));
+    EXPECT_TRUE(m.CompareAndSwap("b", 3, 5));
+    EXPECT_EQ(m.Load("b").value(), 5);
+    EXPECT_FALSE(m.CompareAndSwap("c", 0, 1));
+
+    EXPECT_EQ(m.LoadAndDelete("a").value(), 2);
+    EXPECT_FALSE(m.LoadAndDelete("a").has_value());
+    m.Delete("b");
+    EXPECT_FALSE(m.Load("b").has_value());
+}
+
+TEST(MapTest, RangeVisitsEveryKeyOnce) {
+    Map<int, int> m;
+    for (int i = 0; i < 1000; ++i) m.Store(i, i * 2);
+
+    std::vector<int> seen(1000, 0);
+    m.Range([&](const int& k, const int& v) {
+        EXPECT_EQ(v, k * 2);
+        seen[static_cast<std::size_t>(k)]++;
+        return true;
+    });
+    for (int count : seen) EXPECT_EQ(count, 1);
+
+    int visited = 0;
+    m.Range([&](const int&, const int&) { return ++visited < 10; });
+    EXPECT_EQ(visited, 10);
+}
+
+TEST(MapTest, ReadersSeeEveryKeyWhileItGrows) {
+    Map<int, int> m;
+    constexpr int keys = 20000;
+    std::atomic<int> inserted{0};
+    std::atomic<int> missing{0};
+
+    std::vector<std::thread> readers;
+    for (int t = 0; t < 4; ++t) {
+        readers.emplace_back([&, t] {
+            uint32_t seed = static_cast<uint32_t>(t) * 2654435761u + 1;
+            while (inserted.load() < keys) {
+                int n = inserted.load();
+                if (n == 0) continue;
+                seed = seed * 1664525u + 1013904223u;
+                int k = static_cast<int>(seed % static_cast<uint32_t>(n));
+                auto v = m.Load(k);
+                if (!v || *v != k + 1) missing++;
+            }
+        });
+    }
+    for (int i = 0; i < keys; ++i) {
+        m.Store(i, i + 1);
+        inserted.store(i + 1);
+    }
+    for (auto& r : readers) r.join();
+
+    EXPECT_EQ(missing.load(), 0);
+    for (int i = 0; i < keys; ++i) ASSERT_EQ(m.Load(i).value_or(-1), i + 1);
+}
+
+TEST(MapTest, ConcurrentWritersKeepEveryUpdate) {
+    Map<int, int> m;
+    constexpr int threads = 4;
+    constexpr int perThread = 500;
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back([&] {
+            // Every thread increments every key; CAS loops must not lose any
+            for (int i = 0; i < perThread; ++i) {
+                for (int k = 0; k < 16; ++k) {
+                    for (;;) {
+                        auto [old, loaded] = m.LoadOrStore(k, 1);
+                        if (!loaded || m.CompareAndSwap(k, old, old + 1)) break;
+                    }
+                }
+            }
+        });
+    }
+    for (auto& w : workers) w.join();
+    for (int k = 0; k < 16; ++k) EXPECT_EQ(m.Load(k).value(), threads * perThread);
+}
+
+TEST(MapTest, ReplacedValuesAreReclaimed) {
+    auto first = std::make_shared<int>(1);
+    std::weak_ptr<int> watch = first;
+    {
+        Map<int, std::shared_ptr<int>> m;
+        m.Store(1, std::move(first));
+        for (int i = 0; i < 100; ++i) m.Store(1, std::make_shared<int>(i));
+        detail::EpochCollect();
+        EXPECT_TRUE(watch.expired());  // No reader could still hold the first node
+    }
+}
+
+TEST(SemaphoreTest, WeightedAcquireAndRelease) {
+    Semaphore sem(5);
+    EXPECT_TRUE(sem.TryAcquire(3));
+    EXPECT_FALSE(sem.TryAcquire(3));
+    EXPECT_TRUE(sem.TryAcquire(2));
+    sem.Release(5);
+    EXPECT_THROW(sem.Release(1), std::runtime_error);
+    EXPECT_THROW(sem.Acquire(6), std::runtime_error);
+
+    sem.Acquire(5);
+    std::atomic<bool> acquired{false};
+    std::thread waiter([&] {
+        sem.Acquire(2);
+        acquired = true;
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    EXPECT_FALSE(acquired);
+    sem.Release(1);
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    EXPECT_FALSE(acquired);  // Needs two
+    sem.Release(1);
+    waiter.join();
+    EXPECT_TRUE(acquired);
+}
+
+TEST(SemaphoreTest, LargeRequestAtHeadIsNotOvertaken) {
+    Semaphore sem(4);
+    sem.Acquire(4);
+    std::vector<int> order;
+    std::mutex orderMtx;
+    std::thread big([&] {
+        sem.Acquire(3);
+        std::lock_guard<std::mutex> lock(orderMtx);
+        order.push_back(3);
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    std::thread small([&] {
+        sem.Acquire(1);
+        std::lock_guard<std::mutex> lock(orderMtx);
+        order.push_back(1);
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+
+    sem.Release(1);  // Enough for the small request, but the big one is first
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    EXPECT_TRUE(order.empty());
+    EXPECT_FALSE(sem.TryAcquire(1));  // No barging past the queue either
+
+    sem.Release(2);  // Three free: all of them go to the head
+    big.join();
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    EXPECT_EQ(order, std::vector<int>{3});
+
+    sem.Release(1);
+    small.join();
+    EXPECT_EQ(order, (std::vector<int>{3, 1}));
+}
+
+TEST(SemaphoreTest, AcquireGivesUpWhenContextIsCanceled) {
+    using namespace gocxx::context;
+    Semaphore sem(1);
+    sem.Acquire();
+
+    auto [ctx, cancel] = WithCancel(Background()).value;
+    std::thread canceler([cancel = cancel] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        cancel();
+    });
+    EXPECT_TRUE(sem.Acquire(ctx, 1).Failed());
+    canceler.join();
+    sem.Release();
+    EXPECT_TRUE(sem.Acquire(ctx, 1).Failed());  // Canceled, even though a token is free
+
+    EXPECT_TRUE(sem.Acquire(Background(), 1).Ok());
+    sem.Release();
+    EXPECT_TRUE(sem.TryAcquire());  // The canceled waiter left the queue
+}
+
+TEST(SemaphoreTest, BoundsConcurrency) {
+    Semaphore sem(3);
+    std::atomic<int> inside{0};
+    std::atomic<int> peak{0};
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 8; ++t) {
+        threads.emplace_back([&] {
+            for (int i = 0; i < 200; ++i) {
+                sem.Acquire();
+                int now = ++inside;
+                int seen = peak.load();
+                while (now > seen && !peak.compare_exchange_weak(seen, now)) {}
+                std::this_thread::yield();
+                --inside;
+                sem.Release();
+            }
+        });
+    }
+    for (auto& t : threads) t.join();
+    EXPECT_LE(peak.load(), 3);
+    EXPECT_TRUE(sem.TryAcquire(3));
+}
+
+TEST(ErrGroupTest, JoinsErrorsAndCancelsContext) {
+    using gocxx::base::Result;
+    errgroup::Group g(gocxx::context::Background());
+    auto ctx = g.Context();
+    std::atomic<bool> sawCancel{false};
+
+    g.Go([] { return Result<void>(gocxx::errors::New("first")); });
+    g.Go([ctx, &sawCancel] {
+        while (!ctx->IsCanceled()) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        sawCancel = true;
+        return Result<void>(gocxx::errors::New("second"));
+    });
+    g.Go([] { return Result<void>(); });
+
+    auto result = g.Wait();
+    ASSERT_TRUE(result.Failed());
+    EXPECT_TRUE(sawCancel);
+    std::string msg = result.err->error();
+    EXPECT_NE(msg.find("first"), std::string::npos);
+    EXPECT_NE(msg.find("second"), std::string::npos);
+    EXPECT_LT(msg.find("first"), msg.find("second"));
+}
+
+TEST(ErrGroupTest, LimitBoundsRunningFunctions) {
+    using gocxx::base::Result;
+    errgroup::Group g;
+    g.SetLimit(2);
+    std::atomic<int> inside{0};
+    std::atomic<int> peak{0};
+    for (int i = 0; i < 20; ++i) {
+        g.Go([&] {
+            int now = ++inside;
+            int seen = peak.load();
+            while (now > seen && !peak.compare_exchange_weak(seen, now)) {}
+            std::this_thread::sleep_for(std::chrono::milliseconds(2));
+            --inside;
+            return Result<void>();
+        });
+    }
+    EXPECT_TRUE(g.Wait().Ok());
+    EXPECT_LE(peak.load(), 2);
+    EXPECT_EQ(g.Context(), nullptr);
+}
+
+TEST(ErrGroupTest, TryGoAndThrowingFunctions) {
+    using gocxx::base::Result;
+    errgroup::Group g;
+    g.SetLimit(1);
+    std::atomic<bool> release{false};
+    EXPECT_TRUE(g.TryGo([&]() -> Result<void> {
+        while (!release) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        throw std::runtime_error("boom");
+    }));
+    EXPECT_FALSE(g.TryGo([] { return Result<void>(); }));
+    EXPECT_THROW(g.SetLimit(4), std::runtime_error);
+    release = true;
+
+    auto result = g.Wait();
+    ASSERT_TRUE(result.Failed());
+    EXPECT_EQ(result.err->error(), "boom");
+}
+
+TEST(SingleflightTest, ConcurrentCallersShareOneCall) {
+    using gocxx::base::Result;
+    singleflight::Group<std::string, int> g;
+    std::atomic<int> calls{0};
+    std::atomic<bool> running{false};
+    std::atomic<bool> release{false};
+    auto load = [&] {
+        calls++;
+        running = true;
+        while (!release) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        return Result<int>(42);
+    };
+
+    std::vector<int> results(8, 0);
+    std::vector<char> shared(8, 0);
+    std::vector<std::thread> callers;
+    callers.emplace_back([&] {
+        bool s = false;
+        results[0] = g.Do("k", load, &s).value;
+        shared[0] = s;
+    });
+    while (!running) std::this_thread::yield();
+    for (std::size_t i = 1; i < 8; ++i) {
+        callers.emplace_back([&, i] {
+            bool s = false;
+            results[i] = g.Do("k", load, &s).value;
+            shared[i] = s;
+        });
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    release = true;
+    for (auto& c : callers) c.join();
+
+    EXPECT_EQ(calls.load(), 1);
+    for (std::size_t i = 0; i < 8; ++i) {
+        EXPECT_EQ(results[i], 42);
+        EXPECT_TRUE(shared[i]);
+    }
+
+    // The finished call is forgotten: the next one runs again
+    bool s = true;
+    EXPECT_EQ(g.Do("k", load, &s).value, 42);
+    EXPECT_EQ(calls.load(), 2);
+    EXPECT_FALSE(s);
+}
+
+TEST(SingleflightTest, ErrorsAndExceptionsReachEveryCaller) {
+    using gocxx::base::Result;
+    singleflight::Group<int, int> g;
+    auto r = g.Do(1, [] { return Result<int>(gocxx::errors::New("store down")); });
+    ASSERT_TRUE(r.Failed());
+    EXPECT_EQ(r.err->error(), "store down");
+
+    EXPECT_THROW(g.Do(1, []() -> Result<int> { throw std::runtime_error("boom"); }), std::runtime_error);
+
+    auto ch = g.DoChan(2, []() -> Result<int> { throw std::runtime_error("boom"); });
+    auto received = ch.recv();
+    ASSERT_TRUE(received.has_value());
+    ASSERT_TRUE(received->Failed());
+    EXPECT_EQ(received->err->error(), "boom");
+}
+
+TEST(SingleflightTest, DoChanAndForget) {
+    using gocxx::base::Result;
+    singleflight::Group<int, int> g;
+    std::atomic<int> calls{0};
+    std::atomic<bool> release{false};
+    auto load = [&] {
+        int n = ++calls;
+        // Runs as a task: sleep the task, not the scheduler's thread
+        while (!release) gocxx::time::Sleep(gocxx::time::Milliseconds(1));
+        return Result<int>(n);
+    };
+
+    auto first = g.DoChan(7, load);
+    auto second = g.DoChan(7, load);   // Joins the running call
+    while (calls.load() == 0) std::this_thread::yield();
+    g.Forget(7);
+    auto third = g.DoChan(7, load);    // Starts a new one
+    while (calls.load() < 2) std::this_thread::yield();
+    release = true;
+
+    EXPECT_EQ(first.recv()->value, 1);
+    EXPECT_EQ(second.recv()->value, 1);
+    EXPECT_EQ(third.recv()->value, 2);
+    EXPECT_EQ(calls.load(), 2);
+}
+
 TEST(WaitGroupTest, ParallelTasksComplete) {
     WaitGroup wg;
     std::atomic<int> shared{0};
@@ -248,4 +911,79 @@ TEST(WaitGroupTest, ParallelTasksComplete) {
     }
     
     EXPECT_EQ(shared.load(), 5);
-}
\ No newline at end of file
+}
+
+TEST(WaitGroupTest, NegativeCounterThrowsAndIsUndone) {
+    WaitGroup wg;
+    wg.Add(1);
+    EXPECT_THROW(wg.Add(-2), std::runtime_error);
+    EXPECT_NO_THROW(wg.Done());  // Still 1 after the failed Add
+    wg.Wait();
+    EXPECT_THROW(wg.Done(), std::runtime_error);
+}
+
+TEST(WaitGroupTest, WakesEveryWaiterEachRound) {
+    WaitGroup wg(WaitPolicy::Block());
+    constexpr int waiters = 8;
+    constexpr int rounds = 50;
+    for (int round = 0; round < rounds; ++round) {
+        wg.Add(waiters);
+        std::atomic<int> woken{0};
+        std::vector<std::thread> threads;
+        for (int i = 0; i < waiters; ++i) {
+            threads.emplace_back([&] {
+                wg.Wait();
+                woken++;
+            });
+        }
+        std::vector<std::thread> workers;
+        for (int i = 0; i < waiters; ++i) {
+            workers.emplace_back([&] { wg.Done(); });
+        }
+        for (auto& t : workers) t.join();
+        for (auto& t : threads) t.join();
+        EXPECT_EQ(woken.load(), waiters);
+    }
+}
+TEST(WaitPolicyTest, BlockPolicyAlwaysParks) {
+    Cond cond(WaitPolicy::Block());
+    Mutex mtx;
+    bool signaled = false;
+
+    std::thread t([&]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        {
+            Lock lg(mtx);
+            signaled = true;
+        }
+        cond.NotifyOne();
+    });
+
+    {
+        UniqueLock lock(mtx);
+        while (!signaled) cond.Wait(lock);
+    }
+    t.join();
+
+    WaitCounts counts = cond.Stats();
+    EXPECT_EQ(counts.spun, 0u);
+    EXPECT_EQ(counts.yielded, 0u);
+    EXPECT_GE(counts.parked, 1u);
+}
+
+TEST(WaitPolicyTest, WaitGroupCountsEveryWait) {
+    WaitGroup wg;
+    wg.Wait();  // Already zero: resolved without parking
+
+    wg.Add(1);
+    std::thread t([&]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        wg.Done();
+    });
+    wg.Wait();
+    t.join();
+
+    WaitCounts counts = wg.Stats();
+    EXPECT_EQ(counts.Total(), 2u);
+    EXPECT_EQ(counts.parked, 1u);
+}
@@ -2,6 +2,10 @@
 #include "gocxx/time/ticker.h"
 #include "gocxx/time/timer.h"
 #include "gocxx/time/time.h"
+#include "gocxx/time/timer_service.h"
+#include <atomic>
+#include <mutex>
+#include <vector>
 #include <chrono>
 #include <thread>
 
@@ -120,6 +124,85 @@ TEST(TimerTest, TimerReset) {
     EXPECT_GE(elapsed.Milliseconds(), 80);  // Should be at least close to 100ms
 }
 
+TEST(TimerTest, ResetReportsWhetherTimerWasActive) {
+    auto timer = NewTimer(Duration(Duration::Hour));
+    EXPECT_TRUE(timer->Reset(Duration(20 * Duration::Millisecond)));  // Still pending
+
+    ASSERT_TRUE(timer->C()->recv().has_value());
+    EXPECT_FALSE(timer->Reset(Duration(Duration::Hour)));  // Already fired
+    EXPECT_TRUE(timer->Stop());
+
+    std::atomic<int> calls{0};
+    auto fn = AfterFunc(Duration(Duration::Hour), [&] { calls++; });
+    EXPECT_TRUE(fn->Reset(Duration(Duration::Millisecond)));
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    EXPECT_EQ(calls.load(), 1);
+    EXPECT_FALSE(fn->Reset(Duration(Duration::Hour)));
+    EXPECT_TRUE(fn->Stop());
+}
+
+TEST(TimerTest, StopAndResetLeaveNoStaleValue) {
+    // Stop() racing the expiry: a value sent while Stop() runs must not
+    // outlive it, or a later receive would see a stale tick
+    for (int i = 0; i < 500; ++i) {
+        auto timer = NewTimer(Duration(50 * Duration::Microsecond));
+        std::this_thread::sleep_for(std::chrono::microseconds(i % 100));
+        timer->Stop();
+        EXPECT_FALSE(timer->C()->canRecv()) << "after Stop, iteration " << i;
+
+        timer->Reset(Duration(50 * Duration::Microsecond));
+        std::this_thread::sleep_for(std::chrono::microseconds(i % 100));
+        timer->Reset(Duration(Duration::Hour));
+        EXPECT_FALSE(timer->C()->canRecv()) << "after Reset, iteration " << i;
+    }
+}
+
+TEST(TimerTest, AfterFuncRunsOnce) {
+    std::atomic<int> calls{0};
+    auto timer = AfterFunc(Duration(20 * Duration::Millisecond), [&] { calls++; });
+    EXPECT_EQ(timer->C(), nullptr);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    EXPECT_EQ(calls.load(), 1);
+    EXPECT_FALSE(timer->Stop());  // Already fired
+}
+
+TEST(TimerTest, StoppedAfterFuncNeverRuns) {
+    std::atomic<int> calls{0};
+    auto timer = AfterFunc(Duration(50 * Duration::Millisecond), [&] { calls++; });
+    EXPECT_TRUE(timer->Stop());
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    EXPECT_EQ(calls.load(), 0);
+}
+
+TEST(TimerServiceTest, FiresInDeadlineOrderAndCancels) {
+    TimerService service;
+    std::mutex mu;
+    std::vector<int> fired;
+    std::vector<TimerService::Handle> timers;
+
+    // Scheduled out of order; every third one is cancelled
+    const int order[] = {5, 1, 9, 3, 7, 2, 8, 4, 6, 0};
+    for (int id : order) {
+        auto t = service.Create([&, id] {
+            std::lock_guard<std::mutex> lock(mu);
+            fired.push_back(id);
+        });
+        service.ArmAfter(t, Duration((10 + 5 * id) * Duration::Millisecond));
+        timers.push_back(t);
+    }
+    for (std::size_t i = 0; i < timers.size(); i += 3) {
+        EXPECT_TRUE(service.Disarm(timers[i]));
+    }
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    EXPECT_EQ(service.Pending(), 0u);
+
+    std::lock_guard<std::mutex> lock(mu);
+    EXPECT_EQ(fired, (std::vector<int>{1, 2, 4, 6, 7, 9}));
+}
+
 TEST_F(DurationTest, ArithmeticOperations) {
     Duration d1(Duration::Second);
     Duration d2(500 * Duration::Millisecond);